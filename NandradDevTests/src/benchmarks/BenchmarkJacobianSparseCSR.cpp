@@ -0,0 +1,187 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Benchmark for the difference-quotient Jacobian generation in SOLFRA::JacobianSparseCSR.
+
+	Uses a 2D heat conduction model with temperature-dependent conductivity (5-point stencil, 5 colors)
+	and compares serial color evaluation with concurrent evaluation using model replicas.
+
+	Usage: BenchmarkJacobianSparseCSR [<grid size>=200] [<number of setup() calls>=20]
+
+	Set OMP_NUM_THREADS to select the number of threads (one replica per additional thread).
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif // _OPENMP
+
+#include <IBK_messages.h>
+#include <IBK_MessageHandler.h>
+#include <IBK_MessageHandlerRegistry.h>
+
+#include <IBKMK_SparseMatrixCSR.h>
+
+#include <SOLFRA_ModelInterface.h>
+#include <SOLFRA_JacobianSparseCSR.h>
+
+/*! 2D heat conduction on a square grid with nonlinear conductivity. */
+class ConductionModel : public SOLFRA::ModelInterface {
+public:
+	ConductionModel(unsigned int gridSize) : m_gridSize(gridSize), m_y(gridSize*gridSize, 0) {}
+
+	unsigned int n() const override { return (unsigned int)m_y.size(); }
+	const double * y0() const override { return &m_y[0]; }
+	double t0() const override { return 0; }
+	double dt0() const override { return 1; }
+	double tEnd() const override { return 1; }
+	CalculationResult setTime(double) override { return CalculationSuccess; }
+
+	CalculationResult setY(const double * y) override {
+		std::copy(y, y + m_y.size(), m_y.begin());
+		return CalculationSuccess;
+	}
+
+	CalculationResult ydot(double * ydot) override {
+		const unsigned int ng = m_gridSize;
+		for (unsigned int j=0; j<ng; ++j) {
+			for (unsigned int i=0; i<ng; ++i) {
+				unsigned int k = j*ng + i;
+				double sum = 0;
+				if (i > 0)		sum += flux(m_y[k-1], m_y[k]);
+				if (i < ng-1)	sum += flux(m_y[k+1], m_y[k]);
+				if (j > 0)		sum += flux(m_y[k-ng], m_y[k]);
+				if (j < ng-1)	sum += flux(m_y[k+ng], m_y[k]);
+				ydot[k] = sum;
+			}
+		}
+		return CalculationSuccess;
+	}
+
+	unsigned int nReplicas() const override { return (unsigned int)m_replicas.size(); }
+	SOLFRA::ModelInterface * replica(unsigned int i) override { return m_replicas[i].get(); }
+
+	/*! Creates CSR pattern of 5-point stencil. */
+	void pattern(std::vector<unsigned int> & ia, std::vector<unsigned int> & ja) const {
+		const unsigned int ng = m_gridSize;
+		ia.assign(1, 0);
+		ja.clear();
+		for (unsigned int j=0; j<ng; ++j) {
+			for (unsigned int i=0; i<ng; ++i) {
+				unsigned int k = j*ng + i;
+				if (j > 0)		ja.push_back(k-ng);
+				if (i > 0)		ja.push_back(k-1);
+				ja.push_back(k);
+				if (i < ng-1)	ja.push_back(k+1);
+				if (j < ng-1)	ja.push_back(k+ng);
+				ia.push_back((unsigned int)ja.size());
+			}
+		}
+	}
+
+	/*! Independent model copies for concurrent evaluation. */
+	std::vector<std::unique_ptr<ConductionModel> >	m_replicas;
+
+private:
+	/*! Flux between neighboring cells, conductivity depends on mean temperature. */
+	static double flux(double yNeighbor, double y) {
+		double lambda = 1.5 + 0.3*std::exp(-0.01*(y + yNeighbor)) + 0.05*std::sqrt(std::fabs(y*yNeighbor) + 1);
+		return lambda*(yNeighbor - y);
+	}
+
+	unsigned int			m_gridSize;
+	std::vector<double>		m_y;
+};
+
+
+/*! Runs the benchmark with the given number of replicas and returns time per setup() in [ms]. */
+double runBenchmark(unsigned int gridSize, unsigned int nSetups, unsigned int nReplicas, std::vector<double> & jv) {
+	ConductionModel model(gridSize);
+	for (unsigned int i=0; i<nReplicas; ++i)
+		model.m_replicas.push_back(std::unique_ptr<ConductionModel>(new ConductionModel(gridSize)));
+
+	std::vector<unsigned int> ia, ja, iaT, jaT;
+	model.pattern(ia, ja);
+	IBKMK::SparseMatrixCSR::generateTransposedIndex(ia, ja, iaT, jaT);
+
+	const unsigned int n = model.n();
+	SOLFRA::JacobianSparseCSR jacobian(n, (unsigned int)ja.size(), &ia[0], &ja[0], &iaT[0], &jaT[0]);
+	jacobian.init(&model);
+
+	// some non-uniform temperature field
+	std::vector<double> y(n), ydot(n);
+	for (unsigned int k=0; k<n; ++k)
+		y[k] = 20 + 10*std::sin(0.01*k);
+	model.setY(&y[0]);
+	model.ydot(&ydot[0]);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int i=0; i<nSetups; ++i)
+		jacobian.setup(0, &y[0], &ydot[0], nullptr, 1);
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	// matrix-vector product to compare Jacobians of both runs
+	std::vector<double> v(n, 1);
+	for (unsigned int k=0; k<n; ++k)
+		v[k] = 1 + 0.001*k;
+	jv.resize(n);
+	jacobian.jacTimesVec(&v[0], &jv[0]);
+	return ms/nSetups;
+}
+
+
+int main(int argc, char * argv[]) {
+	IBK::MessageHandler messageHandler;
+	messageHandler.setConsoleVerbosityLevel(IBK::VL_ALL - 1); // suppress progress messages of the Jacobian
+	IBK::MessageHandlerRegistry::instance().setMessageHandler(&messageHandler);
+
+	unsigned int gridSize = argc > 1 ? (unsigned int)std::atoi(argv[1]) : 200;
+	unsigned int nSetups = argc > 2 ? (unsigned int)std::atoi(argv[2]) : 20;
+
+	unsigned int nThreads = 1;
+#if defined(_OPENMP)
+	nThreads = (unsigned int)omp_get_max_threads();
+#else
+	std::cout << "Built without OpenMP, only the serial color evaluation is measured." << std::endl;
+#endif // _OPENMP
+
+	std::cout << "Grid " << gridSize << "x" << gridSize << " (" << gridSize*gridSize << " unknowns), "
+			  << nSetups << " Jacobian setups, " << nThreads << " threads" << std::endl;
+
+	std::vector<double> jvSerial, jvConcurrent;
+	double msSerial = runBenchmark(gridSize, nSetups, 0, jvSerial);
+	std::cout << "  serial:     " << msSerial << " ms per Jacobian" << std::endl;
+	if (nThreads > 1) {
+		double msConcurrent = runBenchmark(gridSize, nSetups, nThreads - 1, jvConcurrent);
+		double maxDiff = 0;
+		for (unsigned int k=0; k<jvSerial.size(); ++k)
+			maxDiff = std::max(maxDiff, std::fabs(jvSerial[k] - jvConcurrent[k]));
+		std::cout << "  concurrent: " << msConcurrent << " ms per Jacobian (speedup "
+				  << msSerial/msConcurrent << ", max. difference of J*v " << maxDiff << ")" << std::endl;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Benchmark for the interval lookup in IBK::LinearSpline: binary search in value(x) versus
+	cursor-based search in LinearSpline::values() for time-marching evaluation.
+
+	Splines hold annual time series with non-equidistant time points (similar to schedules and climate
+	data). They are evaluated at simulation times that advance by about 10 minutes, with an occasional
+	step back (as after a rejected integrator step), over two years (cyclic use of the data).
+
+	Usage: BenchmarkLinearSpline [<number of splines>=1000] [<points per spline>=8760]
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <IBK_Exception.h>
+#include <IBK_LinearSpline.h>
+
+int main(int argc, char * argv[]) {
+	unsigned int nSplines = argc > 1 ? (unsigned int)std::atoi(argv[1]) : 1000;
+	unsigned int nPoints = argc > 2 ? (unsigned int)std::atoi(argv[2]) : 8760;
+
+	try {
+		// time series with time steps between 0.5 and 1.5 h
+		std::vector<IBK::LinearSpline> splines(nSplines);
+		std::srand(1);
+		for (IBK::LinearSpline & spline : splines) {
+			std::vector<double> x(nPoints), y(nPoints);
+			double t = 0;
+			for (unsigned int i=0; i<nPoints; ++i) {
+				t += 1800 + std::rand() % 3600;
+				x[i] = t;
+				y[i] = std::rand() % 100;
+			}
+			spline.setValues(x, y);
+		}
+
+		// simulation time points
+		std::vector<double> timePoints;
+		const double tEnd = 2*8760*3600.0;
+		for (double t=0; t<tEnd; t += 611.3) {
+			timePoints.push_back(t);
+			if (timePoints.size() % 10 == 0)
+				timePoints.push_back(t - 1222.6);
+		}
+
+		std::cout << nSplines << " splines with " << nPoints << " points, "
+				  << timePoints.size() << " time points" << std::endl;
+
+		typedef std::chrono::steady_clock clock;
+		std::vector<double> valuesBinary(nSplines), valuesCursor(nSplines);
+		double checksumBinary = 0;
+		clock::time_point start = clock::now();
+		for (double t : timePoints) {
+			for (unsigned int s=0; s<nSplines; ++s)
+				valuesBinary[s] = splines[s].value(t);
+			checksumBinary += valuesBinary[0];
+		}
+		double msBinary = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+		std::vector<unsigned int> cursors;
+		double checksumCursor = 0;
+		start = clock::now();
+		for (double t : timePoints) {
+			IBK::LinearSpline::values(splines, t, cursors, &valuesCursor[0]);
+			checksumCursor += valuesCursor[0];
+		}
+		double msCursor = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+		// compare all values on a coarser set of time points
+		double maxDiff = 0;
+		for (unsigned int i=0; i<timePoints.size(); i += 17) {
+			IBK::LinearSpline::values(splines, timePoints[i], cursors, &valuesCursor[0]);
+			for (unsigned int s=0; s<nSplines; ++s)
+				maxDiff = std::max(maxDiff, std::fabs(splines[s].value(timePoints[i]) - valuesCursor[s]));
+		}
+
+		std::cout << "  value(x):  " << msBinary << " ms" << std::endl;
+		std::cout << "  values():  " << msCursor << " ms (speedup " << msBinary/msCursor << ")" << std::endl;
+		std::cout << "  max. difference " << maxDiff << ", checksums " << checksumBinary << " / " << checksumCursor << std::endl;
+		return maxDiff == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (IBK::Exception & ex) {
+		ex.writeMsgStackToError();
+		return EXIT_FAILURE;
+	}
+}
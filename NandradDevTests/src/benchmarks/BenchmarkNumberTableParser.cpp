@@ -0,0 +1,179 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Benchmark for reading ASCII number tables: line-by-line reading (getline, IBK::explode and
+	IBK::string2val as in the previous IBK::CSVReader, getline and IBK::string2valueVector as in the
+	previous DataIO::readASCIIData()) versus IBK::CSVReader/IBK::NumberTableParser.
+
+	Hourly tables with 8760 rows and the given number of columns are written as tsv, csv (with quotes) and
+	white-space separated file (like the data section of d6o files) into the current working directory and
+	removed afterwards. The number of threads used by NumberTableParser is set with OMP_NUM_THREADS.
+
+	Usage: BenchmarkNumberTableParser [<number of columns>=100] [<number of rows>=8760]
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <IBK_CSVReader.h>
+#include <IBK_Exception.h>
+#include <IBK_NumberTableParser.h>
+#include <IBK_Path.h>
+#include <IBK_StringUtils.h>
+
+typedef std::vector<std::vector<double> > Table;
+
+/*! Line-by-line reading of tsv/csv files, as in the previous IBK::CSVReader::read(). */
+void readLineByLine(const std::string & fname, char separationCharacter, Table & rows) {
+	std::ifstream in(fname.c_str());
+	std::string line;
+	std::getline(in, line);
+	std::string sepChars(1, separationCharacter);
+	std::vector<std::string> captions;
+	if (separationCharacter == ',')
+		IBK::explode(line, captions, sepChars, IBK::EF_UseQuotes);
+	else
+		IBK::explode(line, captions, sepChars, IBK::EF_NoFlags);
+	unsigned int nColumns = (unsigned int)captions.size();
+	while (std::getline(in, line)) {
+		if (line.empty() || line.find_first_not_of("\n\r\t ") == std::string::npos)
+			continue;
+		std::vector<std::string> tokens;
+		if (separationCharacter == ',') {
+			IBK::explode(line, tokens, sepChars, IBK::EF_UseQuotes);
+			for (unsigned int i=0; i<tokens.size(); ++i)
+				IBK::trim(tokens[i], " \t\r\"");
+		}
+		else
+			IBK::explode(line, tokens, sepChars, IBK::EF_NoFlags);
+		if (tokens.size() != nColumns)
+			throw IBK::Exception("Wrong number of columns.", "readLineByLine");
+		std::vector<double> values(nColumns);
+		for (unsigned int i=0; i<nColumns; ++i)
+			values[i] = IBK::string2val<double>(tokens[i]);
+		rows.push_back(values);
+	}
+}
+
+
+/*! Line-by-line reading of white-space separated data, as in the previous DataIO::readASCIIData()
+	(values were converted in DataIO::data()).
+*/
+void readWhiteSpaceLineByLine(const std::string & fname, Table & rows) {
+	std::ifstream in(fname.c_str());
+	std::string line;
+	while (std::getline(in, line)) {
+		if (line.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+		std::vector<double> values;
+		IBK::string2valueVector(line, values);
+		rows.push_back(values);
+	}
+}
+
+
+/*! Reads the complete file and parses it with NumberTableParser, as in DataIO::readASCIIData(). */
+void readWhiteSpaceParser(const std::string & fname, Table & rows) {
+	std::ifstream in(fname.c_str());
+	std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	IBK::NumberTableParser parser;
+	parser.m_separationCharacter = ' ';
+	parser.parse(content.data(), content.data() + content.size(), 1, rows);
+}
+
+
+/*! Writes a table with nRows rows (first column is time in h) and nColumns-1 data columns. */
+void writeTable(const std::string & fname, char separationCharacter, unsigned int nColumns, unsigned int nRows) {
+	std::ofstream out(fname.c_str());
+	const char * quote = (separationCharacter == ',') ? "\"" : "";
+	if (separationCharacter != ' ') {
+		out << quote << "Time [h]" << quote;
+		for (unsigned int j=1; j<nColumns; ++j)
+			out << separationCharacter << quote << "Value " << j << " [W]" << quote;
+		out << '\n';
+	}
+	std::srand(1);
+	for (unsigned int i=0; i<nRows; ++i) {
+		out << i;
+		for (unsigned int j=1; j<nColumns; ++j)
+			out << separationCharacter << quote << (std::rand() % 2000000)*0.001 - 500 << quote;
+		out << '\n';
+	}
+}
+
+
+int main(int argc, char * argv[]) {
+	unsigned int nColumns = argc > 1 ? (unsigned int)std::atoi(argv[1]) : 100;
+	unsigned int nRows = argc > 2 ? (unsigned int)std::atoi(argv[2]) : 8760;
+
+	try {
+		std::cout << nRows << " rows with " << nColumns << " columns" << std::endl;
+
+		const char * names[] = {"tsv", "csv", "white-space"};
+		const char * fnames[] = {"BenchmarkNumberTableParser.tsv", "BenchmarkNumberTableParser.csv",
+								 "BenchmarkNumberTableParser.txt"};
+		const char separationCharacters[] = {'\t', ',', ' '};
+
+		typedef std::chrono::steady_clock clock;
+		bool identical = true;
+		for (unsigned int k=0; k<3; ++k) {
+			writeTable(fnames[k], separationCharacters[k], nColumns, nRows);
+
+			Table rowsLineByLine;
+			clock::time_point start = clock::now();
+			if (separationCharacters[k] == ' ')
+				readWhiteSpaceLineByLine(fnames[k], rowsLineByLine);
+			else
+				readLineByLine(fnames[k], separationCharacters[k], rowsLineByLine);
+			double msLineByLine = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+			Table rowsParser;
+			start = clock::now();
+			if (separationCharacters[k] == ' ')
+				readWhiteSpaceParser(fnames[k], rowsParser);
+			else {
+				IBK::CSVReader reader;
+				reader.m_separationCharacter = separationCharacters[k];
+				reader.read(IBK::Path(fnames[k]));
+				rowsParser.swap(reader.m_values);
+			}
+			double msParser = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+			std::remove(fnames[k]);
+			bool same = (rowsLineByLine == rowsParser && rowsParser.size() == nRows);
+			identical &= same;
+			std::cout << "  " << names[k] << ": line-by-line " << msLineByLine << " ms, NumberTableParser "
+					  << msParser << " ms (speedup " << msLineByLine/msParser << ")"
+					  << (same ? "" : ", values differ!") << std::endl;
+		}
+		return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (IBK::Exception & ex) {
+		ex.writeMsgStackToError();
+		return EXIT_FAILURE;
+	}
+}
@@ -0,0 +1,144 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Benchmark for the output file formats: write throughput and file size of tsv versus binary table
+	format (btf) files, and read time with IBK::CSVReader.
+
+	Rows are written the same way as in NANDRAD_MODEL::OutputFile: tsv files with default stream
+	precision, btf files with IBK::CSVReader::writeBinaryHeader() followed by raw rows of doubles.
+	Rows are written in blocks of 100 rows (as flushed from the output cache). Files are written into the
+	current working directory and removed afterwards.
+
+	Usage: BenchmarkOutputFile [<number of columns>=500] [<number of rows>=8760]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <IBK_CSVReader.h>
+#include <IBK_Exception.h>
+#include <IBK_Path.h>
+#include <IBK_StringUtils.h>
+
+/*! Writes all rows (each with nColumns values) to file, in binary table format or as tsv. */
+void writeFile(const std::string & fname, bool binary, const std::vector<std::string> & captions,
+			   const std::vector<double> & values, unsigned int nColumns)
+{
+	std::ofstream out(fname.c_str(), binary ? std::ios_base::binary | std::ios_base::trunc : std::ios_base::trunc);
+	if (binary)
+		IBK::CSVReader::writeBinaryHeader(out, captions);
+	else {
+		for (unsigned int i=0; i<captions.size(); ++i) {
+			if (i != 0)
+				out << '\t';
+			out << captions[i];
+		}
+		out << '\n';
+	}
+
+	const std::size_t blockSize = 100*nColumns;
+	for (std::size_t blockStart=0; blockStart<values.size(); blockStart += blockSize) {
+		std::size_t blockEnd = std::min(blockStart + blockSize, values.size());
+		if (binary)
+			out.write(reinterpret_cast<const char *>(&values[blockStart]), (std::streamsize)((blockEnd - blockStart)*sizeof(double)));
+		else {
+			for (std::size_t rowStart=blockStart; rowStart<blockEnd; rowStart += nColumns) {
+				out << values[rowStart];
+				for (unsigned int i=1; i<nColumns; ++i)
+					out << '\t' << values[rowStart + i];
+				out << '\n';
+			}
+		}
+		out.flush();
+	}
+}
+
+
+int main(int argc, char * argv[]) {
+	unsigned int nColumns = argc > 1 ? (unsigned int)std::atoi(argv[1]) : 500;
+	unsigned int nRows = argc > 2 ? (unsigned int)std::atoi(argv[2]) : 8760;
+
+	try {
+		// time column and output values with magnitudes of temperatures, loads and mass fluxes
+		std::vector<std::string> captions(1, "Time [h]");
+		for (unsigned int i=1; i<nColumns; ++i)
+			captions.push_back("Zone(id=" + IBK::val2string(i) + ").AirTemperature [C]");
+		std::vector<double> values((std::size_t)nRows*nColumns);
+		std::srand(1);
+		for (unsigned int j=0; j<nRows; ++j) {
+			values[(std::size_t)j*nColumns] = j;
+			for (unsigned int i=1; i<nColumns; ++i)
+				values[(std::size_t)j*nColumns + i] = std::pow(10.0, (int)(i % 7) - 3)*(std::rand() % 100000)/997.0;
+		}
+
+		std::cout << nRows << " rows with " << nColumns << " columns" << std::endl;
+
+		typedef std::chrono::steady_clock clock;
+		const char * fnames[] = {"BenchmarkOutputFile.tsv", "BenchmarkOutputFile.btf"};
+		double msWrite[2];
+		bool success = true;
+		for (unsigned int k=0; k<2; ++k) {
+			clock::time_point start = clock::now();
+			writeFile(fnames[k], k == 1, captions, values, nColumns);
+			msWrite[k] = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+			std::ifstream in(fnames[k], std::ios_base::binary | std::ios_base::ate);
+			double sizeMB = (double)in.tellg()/(1024*1024);
+			in.close();
+
+			IBK::CSVReader reader;
+			start = clock::now();
+			reader.read(IBK::Path(fnames[k]));
+			double msRead = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+			std::remove(fnames[k]);
+
+			// binary files must hold exact values, tsv files values with 6 significant digits
+			double maxRelDiff = 0;
+			if (reader.m_values.size() != nRows || reader.m_nColumns != nColumns)
+				maxRelDiff = 1;
+			else {
+				for (unsigned int j=0; j<nRows; ++j)
+					for (unsigned int i=0; i<nColumns; ++i) {
+						double val = values[(std::size_t)j*nColumns + i];
+						maxRelDiff = std::max(maxRelDiff, std::fabs(reader.m_values[j][i] - val)/std::max(std::fabs(val), 1e-10));
+					}
+			}
+			success &= (k == 1) ? maxRelDiff == 0 : maxRelDiff < 1e-5;
+
+			std::cout << "  " << (k == 0 ? "tsv" : "btf") << ": write " << msWrite[k] << " ms ("
+					  << sizeMB*1000/msWrite[k] << " MB/s), " << sizeMB << " MB, read " << msRead << " ms, "
+					  << "max. relative difference " << maxRelDiff << std::endl;
+		}
+		std::cout << "  write speedup " << msWrite[0]/msWrite[1] << std::endl;
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (IBK::Exception & ex) {
+		ex.writeMsgStackToError();
+		return EXIT_FAILURE;
+	}
+}
@@ -0,0 +1,173 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Benchmark for loading large XML project files: load time of the TiXml DOM, time for parsing number lists
+	from element texts, and peak memory use (Linux only).
+
+	With a NANDRAD project file as argument, the project is read with NANDRAD::Project::readXML() and the
+	total load time is reported.
+
+	Without argument (or with a file name not ending in '.nandrad'), a synthetic city-scale XML file is
+	generated (if it does not exist yet): 260000 surfaces with 4-12 vertexes (comma-separated coordinates as
+	written by NANDRAD::writeVector3D()) and 100 annual splines (8760 values each), about 100 MB in total.
+	Vertex lists are parsed with NANDRAD::readVector3D(), splines with TiXmlElement::readIBKUnitVectorElement().
+
+	Usage: BenchmarkProjectLoading [<project.nandrad> | <synthetic file>=city_benchmark.xml [<number of surfaces>=260000]]
+
+	Start each measurement in a new process, since the peak memory use is a process-wide value.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <IBK_Exception.h>
+#include <IBK_FileUtils.h>
+#include <IBK_Path.h>
+
+#include <IBKMK_Vector3D.h>
+
+#include <NANDRAD_Project.h>
+#include <NANDRAD_Utilities.h>
+
+#include <tinyxml.h>
+
+/*! Returns peak resident memory of the process in [MB], or -1 if not available. */
+double peakMemoryMB() {
+#if defined(__linux__)
+	std::ifstream in("/proc/self/status");
+	std::string line;
+	while (std::getline(in, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return std::atof(line.c_str() + 6)/1024;
+	}
+#endif // __linux__
+	return -1;
+}
+
+
+/*! Writes synthetic project file with surfaces and annual splines. */
+void generateFile(const IBK::Path & fname, unsigned int nSurfaces) {
+	std::unique_ptr<std::ofstream> outPtr( IBK::create_ofstream(fname) );
+	std::ofstream & out = *outPtr;
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<double> coordinate(-1000, 1000), height(0, 50), temperature(-10, 30);
+	std::uniform_int_distribution<int> vertexCount(4, 12);
+
+	out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n<Project>\n";
+	char buf[100];
+	for (unsigned int i=0; i<nSurfaces; ++i) {
+		out << "\t<PlaneGeometry id=\"" << i << "\">\n\t\t<Vertexes>";
+		int nVertexes = vertexCount(gen);
+		for (int v=0; v<nVertexes; ++v) {
+			std::snprintf(buf, sizeof(buf), "%s%.6f %.6f %.6f", v == 0 ? "" : ", ",
+						  coordinate(gen), coordinate(gen), height(gen));
+			out << buf;
+		}
+		out << "</Vertexes>\n\t</PlaneGeometry>\n";
+	}
+	for (unsigned int i=0; i<100; ++i) {
+		out << "\t<LinearSplineParameter name=\"S" << i << "\">\n\t\t<X unit=\"h\">";
+		for (unsigned int h=0; h<8760; ++h)
+			out << (h == 0 ? "" : " ") << h;
+		out << "</X>\n\t\t<Y unit=\"C\">";
+		for (unsigned int h=0; h<8760; ++h) {
+			std::snprintf(buf, sizeof(buf), "%s%.4f", h == 0 ? "" : " ", temperature(gen));
+			out << buf;
+		}
+		out << "</Y>\n\t</LinearSplineParameter>\n";
+	}
+	out << "</Project>\n";
+}
+
+
+/*! Loads synthetic file and parses all number lists. */
+void benchmarkSyntheticFile(const IBK::Path & fname) {
+	typedef std::chrono::steady_clock clock;
+	clock::time_point start = clock::now();
+	TiXmlDocument doc;
+	if (!doc.LoadFile(fname.c_str(), TIXML_ENCODING_UTF8))
+		throw IBK::Exception(IBK::FormatString("Error reading '%1': %2").arg(fname).arg(doc.ErrorDesc()), "[benchmarkSyntheticFile]");
+	double msDOM = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	double peakDOM = peakMemoryMB();
+
+	start = clock::now();
+	std::vector<std::vector<IBKMK::Vector3D> > polygons;
+	std::vector<std::vector<double> > splineValues;
+	double checksum = 0;
+	for (const TiXmlElement * e = doc.FirstChildElement()->FirstChildElement(); e; e = e->NextSiblingElement()) {
+		for (const TiXmlElement * c = e->FirstChildElement(); c; c = c->NextSiblingElement()) {
+			if (std::strcmp(c->Value(), "Vertexes") == 0) {
+				polygons.push_back(std::vector<IBKMK::Vector3D>());
+				NANDRAD::readVector3D(c, "Vertexes", polygons.back());
+				checksum += polygons.back()[0].m_x;
+			}
+			else {
+				splineValues.push_back(std::vector<double>());
+				std::string name, unit;
+				TiXmlElement::readIBKUnitVectorElement(c, name, unit, splineValues.back(), true);
+				checksum += splineValues.back().back();
+			}
+		}
+	}
+	double msNumbers = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	std::cout << fname.filename() << ": " << polygons.size() << " polygons, " << splineValues.size() << " spline value lists" << std::endl;
+	std::cout << "  DOM load:            " << msDOM << " ms, peak memory " << peakDOM << " MB" << std::endl;
+	std::cout << "  number list parsing: " << msNumbers << " ms, peak memory " << peakMemoryMB() << " MB" << std::endl;
+	std::cout << "  checksum " << checksum << std::endl;
+}
+
+
+int main(int argc, char * argv[]) {
+	IBK::Path fname(argc > 1 ? argv[1] : "city_benchmark.xml");
+	unsigned int nSurfaces = argc > 2 ? (unsigned int)std::atoi(argv[2]) : 260000;
+
+	try {
+		if (fname.extension() == "nandrad") {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			NANDRAD::Project project;
+			project.readXML(fname);
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			std::cout << fname.filename() << ": Project::readXML() " << ms << " ms, peak memory "
+					  << peakMemoryMB() << " MB" << std::endl;
+			return EXIT_SUCCESS;
+		}
+
+		if (!fname.exists()) {
+			std::cout << "Generating '" << fname.str() << "' with " << nSurfaces << " surfaces" << std::endl;
+			generateFile(fname, nSurfaces);
+		}
+		benchmarkSyntheticFile(fname);
+		return EXIT_SUCCESS;
+	}
+	catch (IBK::Exception & ex) {
+		ex.writeMsgStackToError();
+		return EXIT_FAILURE;
+	}
+}
@@ -0,0 +1,206 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Benchmark for IBKMK::SparseMatrixCSR operations (matrix-vector product, ILU and ILU backsolve)
+	on Jacobian patterns of NANDRAD projects.
+
+	The patterns are taken from the Jacobian init cache files written by the solver, e.g. for the
+	regression test projects:
+
+	\code
+	NandradSolver --init-cache-dir=/tmp/patterns data/tests/SingleZone/SingleZoneSingleOutdoorsConstruction.nandrad
+	cd /tmp/patterns && BenchmarkSparseMatrixCSR 1 *.cache
+	\endcode
+
+	Usage: BenchmarkSparseMatrixCSR <replication count> <cache file> [<cache file> ...]
+
+	With a replication count > 1, the pattern is repeated block-diagonally to mimic larger models.
+	The number of repetitions of each operation is adjusted to the matrix size.
+	Each operation is timed with a single thread and with all threads (OMP_NUM_THREADS); the results
+	of both runs must be identical.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif // _OPENMP
+
+#include <IBK_Exception.h>
+#include <IBK_FileUtils.h>
+#include <IBK_InputOutput.h>
+#include <IBK_Path.h>
+
+#include <IBKMK_SparseMatrixCSR.h>
+
+/*! Reads Jacobian pattern from a NANDRAD init cache file (see NandradModel::writeInitCache()). */
+bool readPattern(const IBK::Path & cacheFile, std::vector<unsigned int> & ia, std::vector<unsigned int> & ja) {
+	std::unique_ptr<std::ifstream> in( IBK::create_ifstream(cacheFile, std::ios_base::binary) );
+	if (!(*in))
+		return false;
+	try {
+		uint32_t version;
+		IBK::read_uint32_binary(*in, version);
+		if (version != 2) // INIT_CACHE_VERSION in NM_NandradModel.cpp
+			return false;
+		std::string hash;
+		IBK::read_string_binary(*in, hash, 100);
+		uint32_t nnz;
+		IBK::read_uint32_binary(*in, nnz);
+		IBK::read_vector_binary(*in, ia, 100000000);
+		IBK::read_vector_binary(*in, ja, nnz);
+	}
+	catch (IBK::Exception &) {
+		return false;
+	}
+	return ia.size() > 1 && ia.back() == ja.size();
+}
+
+
+/*! Repeats pattern block-diagonally. */
+void replicatePattern(unsigned int count, std::vector<unsigned int> & ia, std::vector<unsigned int> & ja) {
+	const unsigned int n = (unsigned int)ia.size() - 1;
+	const unsigned int nnz = (unsigned int)ja.size();
+	std::vector<unsigned int> iaRep(1, 0), jaRep;
+	for (unsigned int r=0; r<count; ++r) {
+		for (unsigned int i=0; i<n; ++i)
+			iaRep.push_back(r*nnz + ia[i+1]);
+		for (unsigned int k=0; k<nnz; ++k)
+			jaRep.push_back(r*n + ja[k]);
+	}
+	ia.swap(iaRep);
+	ja.swap(jaRep);
+}
+
+
+/*! Fills matrix with diagonally dominant values, so that ILU is well defined. */
+void fillMatrix(IBKMK::SparseMatrixCSR & mat) {
+	const unsigned int * ia = mat.constIa();
+	const unsigned int * ja = mat.constJa();
+	double * data = mat.data();
+	for (unsigned int i=0; i<mat.n(); ++i) {
+		for (unsigned int k=ia[i]; k<ia[i+1]; ++k)
+			data[k] = (ja[k] == i) ? 2.0*(ia[i+1]-ia[i]) : -1.0 - 0.001*(k % 7);
+	}
+}
+
+
+/*! Single benchmark run with given number of threads, returns times per call in [us]
+	for multiply, ilu and backsolveILU, and stores results for comparison.
+*/
+void runOperations(IBKMK::SparseMatrixCSR & mat, unsigned int nRepetitions, int nThreads,
+				   double times[3], std::vector<double> & results)
+{
+#if defined(_OPENMP)
+	omp_set_num_threads(nThreads);
+#else
+	(void)nThreads;
+#endif // _OPENMP
+
+	const unsigned int n = mat.n();
+	std::vector<double> b(n), res(n);
+	for (unsigned int i=0; i<n; ++i)
+		b[i] = 1 + 0.01*(i % 13);
+
+	fillMatrix(mat);
+	typedef std::chrono::steady_clock clock;
+	clock::time_point start = clock::now();
+	for (unsigned int r=0; r<nRepetitions; ++r)
+		mat.multiply(&b[0], &res[0]);
+	times[0] = std::chrono::duration<double, std::micro>(clock::now() - start).count()/nRepetitions;
+	results = res;
+
+	start = clock::now();
+	for (unsigned int r=0; r<nRepetitions; ++r) {
+		fillMatrix(mat);
+		mat.ilu();
+	}
+	times[1] = std::chrono::duration<double, std::micro>(clock::now() - start).count()/nRepetitions;
+
+	start = clock::now();
+	for (unsigned int r=0; r<nRepetitions; ++r) {
+		res = b;
+		mat.backsolveILU(&res[0]);
+	}
+	times[2] = std::chrono::duration<double, std::micro>(clock::now() - start).count()/nRepetitions;
+	results.insert(results.end(), res.begin(), res.end());
+}
+
+
+void benchmarkPattern(const IBK::Path & cacheFile, unsigned int replicationCount) {
+	std::vector<unsigned int> ia, ja;
+	if (!readPattern(cacheFile, ia, ja)) {
+		std::cerr << "Cannot read pattern from '" << cacheFile.str() << "', skipped." << std::endl;
+		return;
+	}
+	if (replicationCount > 1)
+		replicatePattern(replicationCount, ia, ja);
+
+	std::vector<unsigned int> iaT, jaT;
+	IBKMK::SparseMatrixCSR::generateTransposedIndex(ia, ja, iaT, jaT);
+	IBKMK::SparseMatrixCSR mat;
+	mat.resize((unsigned int)ia.size()-1, (unsigned int)ja.size(), &ia[0], &ja[0], &iaT[0], &jaT[0]);
+
+	// process about 10^8 nonzeros per operation in total
+	unsigned int nRepetitions = std::max<unsigned int>(10, 100000000/mat.nnz());
+
+	int nThreads = 1;
+#if defined(_OPENMP)
+	nThreads = omp_get_max_threads();
+#endif // _OPENMP
+
+	double timesSerial[3], timesParallel[3];
+	std::vector<double> resSerial, resParallel;
+	runOperations(mat, nRepetitions, 1, timesSerial, resSerial);
+
+	std::cout << cacheFile.filename().str() << ": n = " << mat.n() << ", nnz = " << mat.nnz() << std::endl;
+	std::cout << "  1 thread:   multiply " << timesSerial[0] << " us, ilu " << timesSerial[1]
+			  << " us, backsolveILU " << timesSerial[2] << " us" << std::endl;
+	if (nThreads > 1) {
+		runOperations(mat, nRepetitions, nThreads, timesParallel, resParallel);
+		bool identical = (resSerial == resParallel);
+		std::cout << "  " << nThreads << " threads:  multiply " << timesParallel[0] << " us, ilu " << timesParallel[1]
+				  << " us, backsolveILU " << timesParallel[2] << " us"
+				  << (identical ? "" : "  *** results differ ***") << std::endl;
+#if defined(_OPENMP)
+		omp_set_num_threads(nThreads);
+#endif // _OPENMP
+	}
+}
+
+
+int main(int argc, char * argv[]) {
+	if (argc < 3) {
+		std::cerr << "Usage: BenchmarkSparseMatrixCSR <replication count> <cache file> [<cache file> ...]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	unsigned int replicationCount = (unsigned int)std::max(1, std::atoi(argv[1]));
+	for (int i=2; i<argc; ++i)
+		benchmarkPattern(IBK::Path(argv[i]), replicationCount);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Benchmark for the batched pipe heat transfer calculation in NANDRAD_MODEL::TNPipeHeatTransferBatch.
+
+	Creates a district network with simple pipes of different diameters and lengths (laminar and
+	turbulent flow) and compares the element-wise calculation in TNSimplePipeElement::setInflowTemperature()
+	(virtual calls, viscosity spline lookup and correlations per pipe) with TNPipeHeatTransferBatch::update()
+	followed by setInflowTemperature(), in two situations:
+
+	- full evaluation: mass fluxes and temperatures of all pipes change (new time step or Newton iteration)
+	- Jacobian evaluation: only the temperature of a single pipe changes (difference quotients)
+
+	Heat losses of both calculations must agree within the accuracy of the fluid property table.
+
+	Usage: BenchmarkTNPipeHeatTransferBatch [<number of pipes>=5000] [<number of evaluations>=200]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <IBK_Exception.h>
+
+#include <NANDRAD_HydraulicFluid.h>
+#include <NANDRAD_HydraulicNetwork.h>
+#include <NANDRAD_HydraulicNetworkComponent.h>
+#include <NANDRAD_HydraulicNetworkElement.h>
+#include <NANDRAD_HydraulicNetworkPipeProperties.h>
+#include <NANDRAD_KeywordList.h>
+
+#include <NM_FluidPropertyTable.h>
+#include <NM_ThermalNetworkFlowElements.h>
+
+using namespace NANDRAD_MODEL;
+
+/*! Pipes of a network, either computed element-wise or in a batch. */
+struct PipeNetwork {
+	PipeNetwork(unsigned int nPipes, const NANDRAD::HydraulicFluid & fluid, const FluidPropertyTable * fluidProperties,
+				bool useBatch)
+	{
+		NANDRAD::HydraulicNetworkComponent comp;
+		for (unsigned int i=0; i<nPipes; ++i) {
+			// pipe geometry of typical district heating networks, from house connections to main pipes
+			NANDRAD::HydraulicNetworkPipeProperties pipePara;
+			double innerDiameter = 20 + 10*(i % 30); // in mm
+			NANDRAD::KeywordList::setParameter(pipePara.m_para, "HydraulicNetworkPipeProperties::para_t",
+											   NANDRAD::HydraulicNetworkPipeProperties::P_PipeInnerDiameter, innerDiameter);
+			NANDRAD::KeywordList::setParameter(pipePara.m_para, "HydraulicNetworkPipeProperties::para_t",
+											   NANDRAD::HydraulicNetworkPipeProperties::P_PipeOuterDiameter, 1.3*innerDiameter + 40);
+			NANDRAD::KeywordList::setParameter(pipePara.m_para, "HydraulicNetworkPipeProperties::para_t",
+											   NANDRAD::HydraulicNetworkPipeProperties::P_UValuePipeWall, 0.2 + 0.01*(i % 20));
+
+			NANDRAD::HydraulicNetworkElement elem;
+			NANDRAD::KeywordList::setParameter(elem.m_para, "HydraulicNetworkElement::para_t",
+											   NANDRAD::HydraulicNetworkElement::P_Length, 5 + (i*37 % 200));
+			NANDRAD::KeywordList::setIntPara(elem.m_intPara, "HydraulicNetworkElement::intPara_t",
+											 NANDRAD::HydraulicNetworkElement::IP_NumberParallelPipes, 1);
+			NANDRAD::KeywordList::setParameter(elem.m_heatExchange.m_para, "HydraulicNetworkHeatExchange::para_t",
+											   NANDRAD::HydraulicNetworkHeatExchange::P_ExternalHeatTransferCoefficient, (i % 4 == 0) ? 0 : 15);
+
+			m_pipes.push_back(std::unique_ptr<TNSimplePipeElement>(
+								  new TNSimplePipeElement(elem, comp, pipePara, fluid, m_externalTemperature)));
+			m_flowElements.push_back(m_pipes.back().get());
+		}
+		if (useBatch) {
+			m_batch.setup(fluid, fluidProperties);
+			for (std::unique_ptr<TNSimplePipeElement> & pipe : m_pipes)
+				m_batch.addPipe(pipe.get());
+		}
+		m_useBatch = useBatch;
+	}
+
+	/*! Sets mass fluxes and temperatures (same sequence for both calculations), perturbation selects
+		variation between evaluations.
+	*/
+	void setStates(double perturbation) {
+		for (unsigned int i=0; i<m_flowElements.size(); ++i) {
+			// mass fluxes between 0.005 and 5 kg/s, some with reversed flow direction
+			double massFlux = (0.005 + 0.05*(i % 100))*(1 + perturbation);
+			m_flowElements[i]->setMassFlux((i % 7 == 0) ? -massFlux : massFlux);
+			m_flowElements[i]->setInitialTemperature(273.15 + 40 + 0.01*(i % 3000) + perturbation);
+		}
+	}
+
+	/*! Computes heat transfer and heat losses of all pipes. */
+	void evaluate() {
+		if (m_useBatch)
+			m_batch.update();
+		for (ThermalNetworkAbstractFlowElement * fe : m_flowElements)
+			fe->setInflowTemperature(273.15 + 60);
+	}
+
+	double										m_externalTemperature = 273.15 + 10;
+	std::vector<std::unique_ptr<TNSimplePipeElement> >	m_pipes;
+	/*! Pipes accessed through base class pointer (as in ThermalNetworkModelImpl). */
+	std::vector<ThermalNetworkAbstractFlowElement*>	m_flowElements;
+	TNPipeHeatTransferBatch						m_batch;
+	bool										m_useBatch = false;
+};
+
+
+/*! Runs full and Jacobian evaluations, returns times per evaluation in [us]. */
+void runBenchmark(PipeNetwork & network, unsigned int nEvaluations, double & usFull, double & usJacobian) {
+	typedef std::chrono::steady_clock clock;
+	clock::time_point start = clock::now();
+	for (unsigned int e=0; e<nEvaluations; ++e) {
+		network.setStates(0.001*(e % 10));
+		network.evaluate();
+	}
+	usFull = std::chrono::duration<double, std::micro>(clock::now() - start).count()/nEvaluations;
+
+	// difference quotients: modify temperature of one pipe, evaluate, restore
+	network.setStates(0);
+	network.evaluate();
+	start = clock::now();
+	for (unsigned int e=0; e<nEvaluations; ++e) {
+		ThermalNetworkAbstractFlowElement * fe = network.m_flowElements[(e*97) % network.m_flowElements.size()];
+		double T = fe->m_meanTemperature;
+		fe->setInitialTemperature(T + 1e-5);
+		network.evaluate();
+		fe->setInitialTemperature(T);
+	}
+	usJacobian = std::chrono::duration<double, std::micro>(clock::now() - start).count()/nEvaluations;
+	network.evaluate();
+}
+
+
+int main(int argc, char * argv[]) {
+	unsigned int nPipes = argc > 1 ? (unsigned int)std::atoi(argv[1]) : 5000;
+	unsigned int nEvaluations = argc > 2 ? (unsigned int)std::atoi(argv[2]) : 200;
+
+	try {
+		NANDRAD::HydraulicFluid fluid;
+		fluid.defaultFluidWater(1);
+		fluid.checkParameters(NANDRAD::HydraulicNetwork::MT_ThermalHydraulicNetwork);
+		FluidPropertyTable fluidProperties;
+		fluidProperties.setup(fluid);
+
+		PipeNetwork elementWise(nPipes, fluid, &fluidProperties, false);
+		PipeNetwork batch(nPipes, fluid, &fluidProperties, true);
+
+		std::cout << nPipes << " pipes, " << nEvaluations << " evaluations" << std::endl;
+		double usFullElementWise, usJacobianElementWise, usFullBatch, usJacobianBatch;
+		runBenchmark(elementWise, nEvaluations, usFullElementWise, usJacobianElementWise);
+		runBenchmark(batch, nEvaluations, usFullBatch, usJacobianBatch);
+
+		std::cout << "  full evaluation:     element-wise " << usFullElementWise << " us, batch " << usFullBatch
+				  << " us (speedup " << usFullElementWise/usFullBatch << ")" << std::endl;
+		std::cout << "  Jacobian evaluation: element-wise " << usJacobianElementWise << " us, batch " << usJacobianBatch
+				  << " us (speedup " << usJacobianElementWise/usJacobianBatch << ")" << std::endl;
+
+		// compare heat losses of both calculations
+		double maxRelDiff = 0;
+		for (unsigned int i=0; i<nPipes; ++i) {
+			double ref = elementWise.m_pipes[i]->m_heatLoss;
+			double diff = std::fabs(batch.m_pipes[i]->m_heatLoss - ref);
+			maxRelDiff = std::max(maxRelDiff, diff/std::max(std::fabs(ref), 1e-10));
+		}
+		std::cout << "  max. relative difference of heat losses " << maxRelDiff << std::endl;
+		return maxRelDiff < 1e-5 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (IBK::Exception & ex) {
+		ex.writeMsgStackToError();
+		return EXIT_FAILURE;
+	}
+}
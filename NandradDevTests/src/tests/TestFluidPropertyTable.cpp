@@ -0,0 +1,109 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Accuracy of NANDRAD_MODEL::FluidPropertyTable against the fluid properties computed from the kinematic
+	viscosity spline (as in the element-wise pipe models).
+
+	Tested fluids are the default water (equidistant spline points) and a water-glycol mixture with
+	non-equidistant spline points and a wider temperature range. Properties are compared on a fine temperature
+	grid that includes points outside the spline range. The relative deviation of kinematic viscosity and
+	Prandtl number, and the deviation of the Prandtl number term related to Pr^0.6667, must stay below 1e-6.
+
+	Usage: TestFluidPropertyTable
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <IBK_Exception.h>
+
+#include <NANDRAD_HydraulicFluid.h>
+#include <NANDRAD_HydraulicNetwork.h>
+
+#include <NM_FluidPropertyTable.h>
+#include <NM_Physics.h>
+
+/*! Compares tabulated and spline-based properties, returns false if deviation exceeds the limit. */
+bool checkFluid(const std::string & name, NANDRAD::HydraulicFluid & fluid) {
+	fluid.checkParameters(NANDRAD::HydraulicNetwork::MT_ThermalHydraulicNetwork);
+	NANDRAD_MODEL::FluidPropertyTable table;
+	table.setup(fluid);
+
+	const double rho = fluid.m_para[NANDRAD::HydraulicFluid::P_Density].value;
+	const double cp = fluid.m_para[NANDRAD::HydraulicFluid::P_HeatCapacity].value;
+	const double lambda = fluid.m_para[NANDRAD::HydraulicFluid::P_Conductivity].value;
+	const IBK::LinearSpline & viscosity = fluid.m_kinematicViscosity.m_values;
+
+	// temperatures off the table grid, from 5 K below to 5 K above the spline range
+	double maxDeviation = 0;
+	for (double T = viscosity.x().front() - 5; T < viscosity.x().back() + 5; T += 0.0123) {
+		double kinVis, prandtl, turbulentPrandtlTerm;
+		table.properties(T, kinVis, prandtl, turbulentPrandtlTerm);
+
+		double kinVisRef = viscosity.value(T);
+		double prandtlRef = NANDRAD_MODEL::PrandtlNumber(kinVisRef, cp, lambda, rho);
+		double turbulentPrandtlTermRef = NANDRAD_MODEL::TurbulentNusseltPrandtlTerm(prandtlRef);
+
+		maxDeviation = std::max(maxDeviation, std::fabs(kinVis - kinVisRef)/kinVisRef);
+		maxDeviation = std::max(maxDeviation, std::fabs(prandtl - prandtlRef)/prandtlRef);
+		// Prandtl number term may be close to zero, hence deviation is related to Pr^0.6667 = term + 1
+		maxDeviation = std::max(maxDeviation, std::fabs(turbulentPrandtlTerm - turbulentPrandtlTermRef)/
+													(1 + std::fabs(turbulentPrandtlTermRef)));
+	}
+
+	std::cout << name << ": " << table.size() << " grid points, max. relative deviation " << maxDeviation << std::endl;
+	if (maxDeviation > 1e-6) {
+		std::cerr << "  Deviation exceeds limit of 1e-6." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+int main(int /*argc*/, char * /*argv*/[]) {
+	try {
+		bool success = true;
+
+		NANDRAD::HydraulicFluid water;
+		water.defaultFluidWater(1);
+		success = checkFluid("Water", water) && success;
+
+		// water-glycol mixture (about 30 %)
+		NANDRAD::HydraulicFluid glycol;
+		glycol.defaultFluidWater(2);
+		glycol.m_para[NANDRAD::HydraulicFluid::P_Density] = IBK::Parameter("Density", 1040, "kg/m3");
+		glycol.m_para[NANDRAD::HydraulicFluid::P_HeatCapacity] = IBK::Parameter("HeatCapacity", 3800, "J/kgK");
+		glycol.m_para[NANDRAD::HydraulicFluid::P_Conductivity] = IBK::Parameter("Conductivity", 0.48, "W/mK");
+		glycol.m_kinematicViscosity.m_values.setValues(std::vector<double>{-10, -5, 0, 12.5, 37, 100},
+													   std::vector<double>{6.5e-6, 5.0e-6, 3.9e-6, 2.5e-6, 1.3e-6, 0.45e-6});
+		success = checkFluid("Water-glycol", glycol) && success;
+
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (IBK::Exception & ex) {
+		ex.writeMsgStackToError();
+		return EXIT_FAILURE;
+	}
+}
@@ -0,0 +1,177 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Checks that IBK::NumberTableParser accepts the same input as the line-by-line reading in IBK::CSVReader
+	that it replaces (getline + IBK::explode + IBK::string2val).
+
+	Small tables cover trailing separators (empty columns), csv with quotes, CRLF line endings, empty lines,
+	white-space separated data and invalid input. The table data/tests/NetworkStaticFlow/0_climate/HeatFlux_Rechteck.csv
+	(trailing tabs in some lines) is read with IBK::CSVReader and compared with the previous algorithm. Each
+	table is parsed with a small chunk size as well, so that chunk boundaries fall into the data.
+
+	Usage: TestNumberTableParser <path to data/tests>
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <IBK_CSVReader.h>
+#include <IBK_Exception.h>
+#include <IBK_NumberTableParser.h>
+#include <IBK_Path.h>
+#include <IBK_StringUtils.h>
+
+typedef std::vector<std::vector<double> > Table;
+
+/*! Data section reading of the previous IBK::CSVReader::read(). */
+Table readLineByLine(const std::string & text, char separationCharacter, unsigned int nColumns) {
+	Table rows;
+	std::string sepChars(1, separationCharacter);
+	std::stringstream in(text);
+	std::string line;
+	while (std::getline(in, line)) {
+		if (line.empty() || line.find_first_not_of("\n\r\t ") == std::string::npos)
+			continue;
+		std::vector<std::string> tokens;
+		if (separationCharacter == ',') {
+			IBK::explode(line, tokens, sepChars, IBK::EF_UseQuotes);
+			for (unsigned int i=0; i<tokens.size(); ++i)
+				IBK::trim(tokens[i], " \t\r\"");
+		}
+		else
+			IBK::explode(line, tokens, sepChars, IBK::EF_NoFlags);
+		if (tokens.size() != nColumns)
+			throw IBK::Exception("Wrong number of columns.", "readLineByLine");
+		std::vector<double> values(nColumns);
+		for (unsigned int i=0; i<nColumns; ++i)
+			values[i] = IBK::string2val<double>(tokens[i]);
+		rows.push_back(values);
+	}
+	return rows;
+}
+
+
+/*! Parses text with NumberTableParser, once as a single chunk and once with many small chunks.
+	Returns false if the results differ or do not match the expected table. For tsv and csv, the expected
+	table must also match the line-by-line reading.
+*/
+bool check(const char * name, const std::string & text, char separationCharacter, unsigned int nColumns,
+		   const Table & expected)
+{
+	bool success = true;
+	if (separationCharacter != ' ' && readLineByLine(text, separationCharacter, nColumns) != expected) {
+		std::cerr << name << ": line-by-line reading gives different values." << std::endl;
+		success = false;
+	}
+	IBK::NumberTableParser parser;
+	parser.m_separationCharacter = separationCharacter;
+	parser.m_stripQuotes = (separationCharacter == ',');
+	parser.m_nColumns = nColumns;
+	const std::size_t chunkSizes[] = {parser.m_minChunkSize, 4};
+	for (std::size_t chunkSize : chunkSizes) {
+		parser.m_minChunkSize = chunkSize;
+		Table rows;
+		try {
+			parser.parse(text.data(), text.data() + text.size(), 2, rows);
+		}
+		catch (IBK::Exception & ex) {
+			std::cerr << name << ": " << ex.msgStack() << std::endl;
+			return false;
+		}
+		if (rows != expected) {
+			std::cerr << name << ": wrong values (chunk size " << chunkSize << ")." << std::endl;
+			success = false;
+		}
+	}
+	if (success)
+		std::cout << name << ": ok" << std::endl;
+	return success;
+}
+
+
+/*! Returns true if parsing text fails with an exception. */
+bool checkError(const char * name, const std::string & text, char separationCharacter, unsigned int nColumns) {
+	IBK::NumberTableParser parser;
+	parser.m_separationCharacter = separationCharacter;
+	parser.m_nColumns = nColumns;
+	Table rows;
+	try {
+		parser.parse(text.data(), text.data() + text.size(), 2, rows);
+	}
+	catch (IBK::Exception &) {
+		std::cout << name << ": error reported" << std::endl;
+		return true;
+	}
+	std::cerr << name << ": invalid input accepted." << std::endl;
+	return false;
+}
+
+
+int main(int argc, char * argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: TestNumberTableParser <path to data/tests>" << std::endl;
+		return EXIT_FAILURE;
+	}
+	IBK::Path csvFile = IBK::Path(argv[1]) / "NetworkStaticFlow/0_climate/HeatFlux_Rechteck.csv";
+
+	try {
+		bool success = true;
+
+		const Table twoColumns = { {0, 0}, {60, 0}, {61, 1000}, {62, 1000.5} };
+		success &= check("tsv", "0\t0\n60\t0\n61\t1000\n62\t1000.5\n", '\t', 2, twoColumns);
+		success &= check("tsv without final line break", "0\t0\n60\t0\n61\t1000\n62\t1000.5", '\t', 2, twoColumns);
+		success &= check("tsv with trailing tabs", "0\t0\n60\t0\t\n61\t1000\n62\t1000.5\t\t\n", '\t', 2, twoColumns);
+		success &= check("tsv with empty columns", "0\t\t0\n\t60\t0\n61\t1000\n62\t1000.5\n", '\t', 2, twoColumns);
+		success &= check("tsv with CRLF", "0\t0\r\n60\t0\r\n61\t1000\r\n62\t1000.5\r\n", '\t', 2, twoColumns);
+		success &= check("tsv with empty lines", "\n0\t0\n\n60\t0\n \t\n61\t1000\n62\t1000.5\n\n", '\t', 2, twoColumns);
+		success &= check("csv with quotes", "\"0\",\"0\"\n\"60\", \"0\"\n61,1000\n\"62\",1000.5\n", ',', 2, twoColumns);
+		success &= check("white-space separated", "0  0\n 60\t0\n61 \t 1000\r\n62 1000.5   \n", ' ', 2, twoColumns);
+
+		success &= checkError("white-space column", "0\t0\n60\t \n", '\t', 2);
+		success &= checkError("missing column", "0\t0\n60\n", '\t', 2);
+		success &= checkError("invalid number", "0\t0\n60\tx\n", '\t', 2);
+
+		// regression input with trailing tabs, read with CSVReader and compared to line-by-line reading
+		IBK::CSVReader reader;
+		reader.read(csvFile);
+		std::ifstream in(csvFile.c_str());
+		std::string caption, text;
+		std::getline(in, caption);
+		std::getline(in, text, '\0');
+		Table expected = readLineByLine(text, '\t', reader.m_nColumns);
+		if (reader.m_values != expected || expected.empty()) {
+			std::cerr << csvFile.filename().str() << ": values differ from line-by-line reading." << std::endl;
+			success = false;
+		}
+		else
+			std::cout << csvFile.filename().str() << ": ok" << std::endl;
+
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (IBK::Exception & ex) {
+		ex.writeMsgStackToError();
+		return EXIT_FAILURE;
+	}
+}
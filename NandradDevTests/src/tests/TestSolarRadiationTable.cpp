@@ -0,0 +1,122 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+/*! Accuracy of the precomputed solar radiation table (CCM::SolarRadiationModel::computeRadiationTable())
+	against the exact sun position and incidence angle computation, for different table resolutions.
+
+	Radiation loads on six surfaces (four walls, a tilted roof and a flat roof) are compared at time points
+	that do not coincide with the table grid, over one year of Potsdam climate data. The RMS deviation of the
+	total (direct + diffuse) radiation load must stay below the limit for each table step and must decrease
+	with finer resolution.
+
+	Usage: TestSolarRadiationTable <path to data/tests>
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <IBK_Exception.h>
+#include <IBK_Path.h>
+
+#include <CCM_Defines.h>
+#include <CCM_SolarRadiationModel.h>
+
+/*! Loads climate data and adds test surfaces. */
+void setupModel(CCM::SolarRadiationModel & model, const IBK::Path & climateFile) {
+	model.m_climateDataLoader.readClimateData(climateFile);
+	model.m_sunPositionModel.m_latitude = model.m_climateDataLoader.m_latitudeInDegree*DEG2RAD;
+	model.m_sunPositionModel.m_longitude = model.m_climateDataLoader.m_longitudeInDegree*DEG2RAD;
+	const double orientation[] = {0, 90, 180, 270, 135, 0};
+	const double inclination[] = {90, 90, 90, 90, 30, 0};
+	for (unsigned int i=0; i<6; ++i)
+		model.addSurface(orientation[i]*DEG2RAD, inclination[i]*DEG2RAD);
+}
+
+
+int main(int argc, char * argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: TestSolarRadiationTable <path to data/tests>" << std::endl;
+		return EXIT_FAILURE;
+	}
+	IBK::Path climateFile = IBK::Path(argv[1]) / "climate/DEU_Potsdam_60.c6b";
+
+	try {
+		CCM::SolarRadiationModel exact;
+		setupModel(exact, climateFile);
+
+		// sample times off the table grid
+		std::vector<double> sampleTimes;
+		for (double t=17.3; t<365*24*3600.0; t += 277.7)
+			sampleTimes.push_back(t);
+		std::vector<double> reference;
+		for (double t : sampleTimes) {
+			exact.setTime(2019, t);
+			for (unsigned int s=0; s<6; ++s) {
+				double qDir, qDif, incidenceAngle;
+				exact.radiationLoad(s, qDir, qDif, incidenceAngle);
+				reference.push_back(qDir + qDif);
+			}
+		}
+
+		// table step in [min] and maximum RMS deviation in [W/m2]
+		const double tableSteps[] = {60, 15, 5, 1};
+		const double rmsLimits[] = {1.5, 0.3, 0.06, 0.005};
+
+		bool success = true;
+		double lastRms = 0;
+		for (unsigned int i=0; i<4; ++i) {
+			CCM::SolarRadiationModel tab;
+			setupModel(tab, climateFile);
+			tab.computeRadiationTable(tableSteps[i]*60);
+
+			double sumSquares = 0;
+			unsigned int k = 0;
+			for (double t : sampleTimes) {
+				tab.setTime(2019, t);
+				for (unsigned int s=0; s<6; ++s, ++k) {
+					double qDir, qDif, incidenceAngle;
+					tab.radiationLoad(s, qDir, qDif, incidenceAngle);
+					double diff = qDir + qDif - reference[k];
+					sumSquares += diff*diff;
+				}
+			}
+			double rms = std::sqrt(sumSquares/reference.size());
+			std::cout << "Table step " << tableSteps[i] << " min: RMS deviation " << rms << " W/m2 (limit "
+					  << rmsLimits[i] << " W/m2)" << std::endl;
+			if (rms > rmsLimits[i]) {
+				std::cerr << "  RMS deviation exceeds limit." << std::endl;
+				success = false;
+			}
+			if (i > 0 && rms >= lastRms) {
+				std::cerr << "  RMS deviation does not decrease with finer table resolution." << std::endl;
+				success = false;
+			}
+			lastRms = rms;
+		}
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (IBK::Exception & ex) {
+		ex.writeMsgStackToError();
+		return EXIT_FAILURE;
+	}
+}
@@ -59,11 +59,13 @@ SOURCES += \
 	../../src/NM_WindowModel.cpp \
 	../../src/NM_AbstractModel.cpp \
 	../../src/NM_ConstructionBalanceModel.cpp \
+	../../src/NM_ConstructionElementPool.cpp \
 	../../src/NM_ConstructionStatesModel.cpp \
 	../../src/NM_DefaultModel.cpp \
 	../../src/NM_DefaultStateDependency.cpp \
 	../../src/NM_Directories.cpp \
 	../../src/NM_FMIInputOutput.cpp \
+	../../src/NM_FluidPropertyTable.cpp \
 	../../src/NM_InternalLoadsModel.cpp \
 	../../src/NM_KeywordList.cpp \
 	../../src/NM_Loads.cpp \
@@ -72,9 +74,11 @@ SOURCES += \
 	../../src/NM_OutputFile.cpp \
 	../../src/NM_OutputHandler.cpp \
 	../../src/NM_QuantityName.cpp \
+	../../src/NM_ResultReferenceIndex.cpp \
 	../../src/NM_RoomBalanceModel.cpp \
 	../../src/NM_RoomStatesModel.cpp \
 	../../src/NM_Schedules.cpp \
+	../../src/NM_StateDependencyScheduler.cpp \
 	../../src/NM_StateModelGroup.cpp \
 	../../src/NM_SteadyStateSolver.cpp \
 	../../src/NM_VectorValuedQuantity.cpp \
@@ -90,11 +94,13 @@ HEADERS += \
 	../../src/NM_AbstractStateDependency.h \
 	../../src/NM_AbstractTimeDependency.h \
 	../../src/NM_ConstructionBalanceModel.h \
+	../../src/NM_ConstructionElementPool.h \
 	../../src/NM_ConstructionStatesModel.h \
 	../../src/NM_DefaultModel.h \
 	../../src/NM_DefaultStateDependency.h \
 	../../src/NM_Directories.h \
 	../../src/NM_FMIInputOutput.h \
+	../../src/NM_FluidPropertyTable.h \
 	../../src/NM_HydraulicNetworkAbstractFlowElement.h \
 	../../src/NM_HydraulicNetworkFlowElements.h \
 	../../src/NM_HydraulicNetworkModel.h \
@@ -109,10 +115,12 @@ HEADERS += \
 	../../src/NM_Physics.h \
 	../../src/NM_QuantityDescription.h \
 	../../src/NM_QuantityName.h \
+	../../src/NM_ResultReferenceIndex.h \
 	../../src/NM_RoomBalanceModel.h \
 	../../src/NM_RoomRadiationLoadsModel.h \
 	../../src/NM_RoomStatesModel.h \
 	../../src/NM_Schedules.h \
+	../../src/NM_StateDependencyScheduler.h \
 	../../src/NM_StateModelGroup.h \
 	../../src/NM_SteadyStateSolver.h \
 	../../src/NM_ThermalNetworkAbstractFlowElementWithHeatLoss.h \
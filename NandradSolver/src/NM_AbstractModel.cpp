@@ -23,6 +23,12 @@
 #include "NM_AbstractTimeDependency.h"
 #include "NM_AbstractStateDependency.h"
 
+#include <cstring>
+#include <cstdint>
+
+#include <IBK_Exception.h>
+#include <IBK_FormatString.h>
+
 namespace NANDRAD_MODEL {
 
 // Dummy implementations to silence the out-of-line virtual function compiler warning
@@ -31,6 +37,35 @@ AbstractModel::~AbstractModel() {
 
 }
 
+
+std::size_t AbstractModel::vectorSerializationSize(const std::vector<double> & vec) {
+	return sizeof(uint32_t) + vec.size()*sizeof(double);
+}
+
+
+void AbstractModel::serializeVector(void* & dataPtr, const std::vector<double> & vec) {
+	*(uint32_t*)dataPtr = (uint32_t)vec.size();
+	dataPtr = (char*)dataPtr + sizeof(uint32_t);
+	if (vec.empty())
+		return;
+	std::memcpy(dataPtr, &vec[0], vec.size()*sizeof(double));
+	dataPtr = (char*)dataPtr + vec.size()*sizeof(double);
+}
+
+
+void AbstractModel::deserializeVector(void* & dataPtr, std::vector<double> & vec) {
+	FUNCID(AbstractModel::deserializeVector);
+	uint32_t n = *(uint32_t*)dataPtr;
+	dataPtr = (char*)dataPtr + sizeof(uint32_t);
+	if (n != vec.size())
+		throw IBK::Exception(IBK::FormatString("Invalid vector size %1 in binary data storage (expected %2).")
+							 .arg(n).arg(vec.size()), FUNC_ID);
+	if (vec.empty())
+		return;
+	std::memcpy(&vec[0], dataPtr, vec.size()*sizeof(double));
+	dataPtr = (char*)dataPtr + vec.size()*sizeof(double);
+}
+
 AbstractTimeDependency::~AbstractTimeDependency() {
 
 }
@@ -140,6 +140,39 @@ public:
 		output manager.
 	*/
 	virtual void variableReferenceSubstitutionMap(std::map<std::string, std::string> & varSubstMap) { (void)varSubstMap; }
+
+	/*! Returns the size in bytes needed to serialize all time-dependent model states, i.e. states that are
+		not recomputed from time point and solution variables alone (for example integral values updated in
+		stepCompleted() or start values of iterative solvers).
+		Must be re-implemented by models that hold such states.
+		Default implementation returns 0 (nothing to serialize).
+	*/
+	virtual std::size_t serializationSize() const { return 0; }
+
+	/*! Stores time-dependent model states at memory location pointed to by dataPtr and increases
+		pointer afterwards to point just behind the memory occupied by the copied data.
+		Default implementation does nothing.
+	*/
+	virtual void serialize(void* & dataPtr) const { (void)dataPtr; }
+
+	/*! Restores time-dependent model states from memory at location pointed to by dataPtr and increases
+		pointer afterwards to point just behind the memory occupied by the copied data.
+		Model must be initialized already, stored vector sizes must match current vector sizes.
+		Default implementation does nothing.
+	*/
+	virtual void deserialize(void* & dataPtr) { (void)dataPtr; }
+
+protected:
+	/*! Returns size in bytes of serialized vector (vector size + data). */
+	static std::size_t vectorSerializationSize(const std::vector<double> & vec);
+
+	/*! Stores size and content of vector at memory location pointed to by dataPtr and increases pointer. */
+	static void serializeVector(void* & dataPtr, const std::vector<double> & vec);
+
+	/*! Restores content of vector from memory location pointed to by dataPtr and increases pointer.
+		Throws an IBK::Exception if stored vector size does not match size of vec.
+	*/
+	static void deserializeVector(void* & dataPtr, std::vector<double> & vec);
 };
 
 
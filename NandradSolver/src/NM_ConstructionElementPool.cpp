@@ -0,0 +1,166 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+#include "NM_ConstructionElementPool.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <IBK_assert.h>
+
+// select vectorized kernel at compile time
+#if defined(__AVX__)
+	#define NM_CONSTRUCTION_KERNEL_AVX
+	#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NM_CONSTRUCTION_KERNEL_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace NANDRAD_MODEL {
+
+/*! Coefficient arrays of each construction start at a multiple of this number of doubles (32 byte alignment). */
+const unsigned int POOL_ALIGNMENT = 4;
+
+
+unsigned int ConstructionElementPool::addConstruction(unsigned int yOffset, unsigned int nElements, const double * rhoce,
+													  const double * rTInv, double * u, double * T, double * q)
+{
+	Construction c;
+	c.m_yOffset = yOffset;
+	c.m_nElements = nElements;
+	c.m_poolOffset = (unsigned int)m_rhoceInput.size();
+	c.m_u = u;
+	c.m_T = T;
+	c.m_q = q;
+	m_constructions.push_back(c);
+
+	// pad coefficient arrays so that the next construction starts at an aligned position
+	unsigned int paddedSize = (nElements + POOL_ALIGNMENT - 1)/POOL_ALIGNMENT*POOL_ALIGNMENT;
+	m_rhoceInput.insert(m_rhoceInput.end(), rhoce, rhoce + nElements);
+	m_rhoceInput.resize(c.m_poolOffset + paddedSize, 1); // padding values are never used
+	m_rTInvInput.push_back(0); // coupling to first element is not used
+	m_rTInvInput.insert(m_rTInvInput.end(), rTInv + 1, rTInv + nElements);
+	m_rTInvInput.resize(c.m_poolOffset + paddedSize, 0);
+
+	return (unsigned int)m_constructions.size() - 1;
+}
+
+
+void ConstructionElementPool::setup() {
+	unsigned int n = (unsigned int)m_rhoceInput.size();
+	// allocate both arrays in one buffer, with additional space to align start of buffer
+	m_buffer.resize(2*n + POOL_ALIGNMENT);
+	std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(m_buffer.data());
+	std::uintptr_t alignBytes = POOL_ALIGNMENT*sizeof(double);
+	m_rhoce = reinterpret_cast<double*>((addr + alignBytes - 1)/alignBytes*alignBytes);
+	m_rTInv = m_rhoce + n;
+	std::copy(m_rhoceInput.begin(), m_rhoceInput.end(), m_rhoce);
+	std::copy(m_rTInvInput.begin(), m_rTInvInput.end(), m_rTInv);
+	// input data no longer needed
+	m_rhoceInput = std::vector<double>();
+	m_rTInvInput = std::vector<double>();
+}
+
+
+void ConstructionElementPool::clear() {
+	m_constructions.clear();
+	m_rhoceInput.clear();
+	m_rTInvInput.clear();
+	m_buffer.clear();
+	m_rhoce = nullptr;
+	m_rTInv = nullptr;
+}
+
+
+void ConstructionElementPool::update(const double * y) const {
+	for (unsigned int i=0; i<m_constructions.size(); ++i)
+		updateConstruction(i, y);
+}
+
+
+void ConstructionElementPool::updateConstruction(unsigned int i, const double * y) const {
+	IBK_ASSERT(m_rhoce != nullptr);
+	const Construction & c = m_constructions[i];
+	const unsigned int n = c.m_nElements;
+	const double * states_y = y + c.m_yOffset;
+	const double * rhoce = m_rhoce + c.m_poolOffset; // aligned
+	const double * rT_inv = m_rTInv + c.m_poolOffset; // aligned
+	double * states_u = c.m_u;
+	double * states_T = c.m_T;
+	double * vec_q = c.m_q;
+
+	// Note: division and flux computation are done in the same order as in the scalar code,
+	//       so that results are identical for all kernel variants.
+
+	// *** temperatures from energy densities ***
+
+	unsigned int j = 0;
+#if defined(NM_CONSTRUCTION_KERNEL_AVX)
+	for (; j + 4 <= n; j += 4) {
+		__m256d u = _mm256_loadu_pd(states_y + j);
+		_mm256_storeu_pd(states_u + j, u);
+		_mm256_storeu_pd(states_T + j, _mm256_div_pd(u, _mm256_load_pd(rhoce + j)));
+	}
+#elif defined(NM_CONSTRUCTION_KERNEL_SSE2)
+	for (; j + 2 <= n; j += 2) {
+		__m128d u = _mm_loadu_pd(states_y + j);
+		_mm_storeu_pd(states_u + j, u);
+		_mm_storeu_pd(states_T + j, _mm_div_pd(u, _mm_load_pd(rhoce + j)));
+	}
+#endif
+	for (; j < n; ++j) {
+		double u = states_y[j];
+		states_u[j] = u;
+		states_T[j] = u / rhoce[j];
+	}
+
+	// *** heat conduction fluxes across element centers ***
+
+	// flux j is between elements j-1 and j
+	j = 1;
+#if defined(NM_CONSTRUCTION_KERNEL_AVX)
+	for (; j + 4 <= n; j += 4) {
+		__m256d dT = _mm256_sub_pd(_mm256_loadu_pd(states_T + j - 1), _mm256_loadu_pd(states_T + j));
+		_mm256_storeu_pd(vec_q + j, _mm256_mul_pd(_mm256_loadu_pd(rT_inv + j), dT));
+	}
+#elif defined(NM_CONSTRUCTION_KERNEL_SSE2)
+	for (; j + 2 <= n; j += 2) {
+		__m128d dT = _mm_sub_pd(_mm_loadu_pd(states_T + j - 1), _mm_loadu_pd(states_T + j));
+		_mm_storeu_pd(vec_q + j, _mm_mul_pd(_mm_loadu_pd(rT_inv + j), dT));
+	}
+#endif
+	for (; j < n; ++j)
+		vec_q[j] = rT_inv[j] * (states_T[j-1] - states_T[j]);
+}
+
+
+const char * ConstructionElementPool::instructionSet() {
+#if defined(NM_CONSTRUCTION_KERNEL_AVX)
+	return "AVX";
+#elif defined(NM_CONSTRUCTION_KERNEL_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+} // namespace NANDRAD_MODEL
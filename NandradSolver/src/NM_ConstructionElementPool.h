@@ -0,0 +1,120 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+#ifndef NM_ConstructionElementPoolH
+#define NM_ConstructionElementPoolH
+
+#include <vector>
+
+namespace NANDRAD_MODEL {
+
+/*!	Holds the finite-volume coefficients of all thermal-only constructions in contiguous, aligned
+	memory (structure-of-arrays layout) and computes element temperatures and heat conduction fluxes
+	of all constructions in one pass with a vectorized (AVX or SSE2) kernel.
+
+	Computed quantities are written directly into the storage members of the individual
+	ConstructionStatesModel instances (cached states, element temperatures and fluxes), so that all
+	result value references published by these models remain valid.
+
+	Usage:
+	- during initialization, each ConstructionStatesModel registers itself with addConstruction()
+	- after all constructions are added, call setup()
+	- in each model evaluation, call update() (or updateConstruction() for each construction when
+	  distributing the work among threads) before calling ConstructionStatesModel::update()
+*/
+class ConstructionElementPool {
+public:
+	/*! Registers a construction.
+		\param yOffset Offset of the first conserved quantity of this construction in the global y vector.
+		\param nElements Number of finite-volume elements.
+		\param rhoce Energy storage capacity of each element, size nElements.
+		\param rTInv Inverse thermal resistance between element centers, size nElements+1 (only entries
+			1...nElements-1 are used).
+		\param u Target memory for cached conserved quantities, size nElements.
+		\param T Target memory for element temperatures, size nElements.
+		\param q Target memory for heat conduction fluxes between elements, size nElements + 1 (entries
+			0 and nElements are not written).
+		\return Returns index of the construction in the pool.
+	*/
+	unsigned int addConstruction(unsigned int yOffset, unsigned int nElements, const double * rhoce,
+								 const double * rTInv, double * u, double * T, double * q);
+
+	/*! Copies coefficients of all registered constructions into aligned storage. */
+	void setup();
+
+	/*! Removes all constructions. */
+	void clear();
+
+	/*! Number of registered constructions. */
+	unsigned int constructionCount() const { return (unsigned int)m_constructions.size(); }
+
+	/*! Computes element temperatures and fluxes for all constructions.
+		\param y Pointer to global vector of conserved quantities.
+	*/
+	void update(const double * y) const;
+
+	/*! Computes element temperatures and fluxes for a single construction.
+		\param i Index of construction (as returned by addConstruction()).
+		\param y Pointer to global vector of conserved quantities.
+	*/
+	void updateConstruction(unsigned int i, const double * y) const;
+
+	/*! Returns name of instruction set used by the vectorized kernel (compile-time selection). */
+	static const char * instructionSet();
+
+private:
+	/*! Data of a single construction. */
+	struct Construction {
+		/*! Offset of first state in global y vector. */
+		unsigned int	m_yOffset;
+		/*! Number of elements. */
+		unsigned int	m_nElements;
+		/*! Offset of first element in the (aligned) coefficient arrays, always a multiple of the vector width. */
+		unsigned int	m_poolOffset;
+		/*! Target memory for conserved quantities. */
+		double			*m_u;
+		/*! Target memory for element temperatures. */
+		double			*m_T;
+		/*! Target memory for heat conduction fluxes. */
+		double			*m_q;
+	};
+
+	/*! All registered constructions. */
+	std::vector<Construction>	m_constructions;
+
+	/*! Coefficients collected during registration, copied into aligned storage in setup(). */
+	std::vector<double>			m_rhoceInput;
+	/*! Coefficients collected during registration, copied into aligned storage in setup(). */
+	std::vector<double>			m_rTInvInput;
+
+	/*! Memory buffer for coefficient arrays (holds both arrays plus padding for alignment). */
+	std::vector<double>			m_buffer;
+	/*! Aligned pointer into m_buffer with energy storage capacities of all elements [J/m3K]. */
+	double						*m_rhoce = nullptr;
+	/*! Aligned pointer into m_buffer with inverse thermal resistances between element i-1 and i [W/m2K].
+		The first element of each construction holds 0.
+	*/
+	double						*m_rTInv = nullptr;
+};
+
+} // namespace NANDRAD_MODEL
+
+#endif // NM_ConstructionElementPoolH
@@ -24,6 +24,7 @@
 #include <algorithm>
 
 #include <IBK_messages.h>
+#include <IBK_assert.h>
 
 #include <NANDRAD_ConstructionInstance.h>
 #include <NANDRAD_ConstructionType.h>
@@ -32,6 +33,7 @@
 #include <NANDRAD_Material.h>
 
 #include "NM_Loads.h"
+#include "NM_ConstructionElementPool.h"
 
 #include "NM_KeywordList.h"
 
@@ -320,6 +322,16 @@ void ConstructionStatesModel::yInitial(double * y) const {
 }
 
 
+void ConstructionStatesModel::registerElementPool(ConstructionElementPool & pool, unsigned int yOffset) {
+	// the pool only provides a kernel for thermal-only constructions
+	if (m_moistureBalanceEnabled)
+		return;
+	pool.addConstruction(yOffset, (unsigned int)m_nElements, &m_rhoce[0], &m_rTInv[0], &m_y[0],
+						 m_vectorValuedResults[VVR_ElementTemperature].dataPtr(), &m_fluxes_q[0]);
+	m_elementPool = &pool;
+}
+
+
 // helper define to get raw pointers from vector storage members
 #define DOUBLE_PTR(x) &x[0]
 
@@ -327,7 +339,13 @@ int ConstructionStatesModel::update(const double * y) {
 	// here we compute all temperatures from conserved quantities (i.e. energy densities) and
 	// also compute all thermal fluxes across elements
 
-	if (!m_moistureBalanceEnabled) {
+	if (m_elementPool != nullptr) {
+		// element temperatures and fluxes have already been computed by the vectorized kernel
+		// in ConstructionElementPool::update(), which also cached the states - these must match
+		// the states passed to this function
+		IBK_ASSERT(std::equal(m_y.begin(), m_y.end(), y));
+	}
+	else if (!m_moistureBalanceEnabled) {
 
 		/// \todo switch between different loop kernels when PCM materials are in the construction
 
@@ -37,6 +37,7 @@ namespace NANDRAD_MODEL {
 
 class Material;
 class Loads;
+class ConstructionElementPool;
 
 /*!	This model computes temperatures (and if moisture balance is enabled in constructions, also
 	intensive moisture variables like relative humidity/vapor pressure) from the conserved quantities.
@@ -127,6 +128,16 @@ public:
 	*/
 	int update(const double * y);
 
+	/*! Registers the construction's elements in the element pool (only for thermal-only constructions).
+		Afterwards, update() expects element temperatures and fluxes to be already computed by
+		ConstructionElementPool::update() (or updateConstruction()) for the same y vector, and only computes
+		surface temperatures and boundary conditions. The argument passed to update() is then only used
+		to check this contract in debug builds.
+		\param pool The pool to register with.
+		\param yOffset Offset of this construction's states in the global y vector.
+	*/
+	void registerElementPool(ConstructionElementPool & pool, unsigned int yOffset);
+
 private:
 	/*! Generates computational grid and all associated data structures. */
 	void generateGrid();
@@ -212,6 +223,9 @@ private:
 	/*! Inverse thermal resistance between element centers (size m_nElements + 1) [W/m2K]. */
 	std::vector<double>				m_rTInv;
 
+	/*! If not nullptr, element temperatures and fluxes are computed by this pool (see registerElementPool()). */
+	const ConstructionElementPool *	m_elementPool = nullptr;
+
 	/*! Surface temperature at left side (side A) [K]. */
 	double							m_TsA;
 	/*! Surface temperature at right side (side B) [K]. */
@@ -0,0 +1,142 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+#include "NM_FluidPropertyTable.h"
+#include "NM_Physics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <IBK_assert.h>
+#include <IBK_Exception.h>
+#include <IBK_messages.h>
+
+#include <NANDRAD_HydraulicFluid.h>
+
+namespace NANDRAD_MODEL {
+
+/*! Maximum grid spacing in [K]. With this spacing, the interpolation error of the Prandtl number term is well
+	below 1e-6 (relative) for water and other common fluids, see TestFluidPropertyTable.
+*/
+const double FLUID_TABLE_MAX_SPACING = 0.05;
+
+/*! Upper limit for number of grid intervals. */
+const unsigned int FLUID_TABLE_MAX_INTERVALS = 65536;
+
+
+/*! Returns the smallest number of equidistant grid intervals, so that all spline points are located on grid points.
+	If no such grid exists with a reasonable number of intervals, the number of spline intervals is returned.
+*/
+static unsigned int alignedGridIntervals(const std::vector<double> & x) {
+	const unsigned int nSplineIntervals = (unsigned int)x.size() - 1;
+	const double range = x.back() - x.front();
+	for (unsigned int n = nSplineIntervals; n <= FLUID_TABLE_MAX_INTERVALS/16; ++n) {
+		bool aligned = true;
+		for (double xi : x) {
+			double pos = (xi - x.front())/range*n;
+			if (std::fabs(pos - std::floor(pos + 0.5)) > 1e-6) {
+				aligned = false;
+				break;
+			}
+		}
+		if (aligned)
+			return n;
+	}
+	return nSplineIntervals;
+}
+
+
+void FluidPropertyTable::setup(const NANDRAD::HydraulicFluid & fluid) {
+	FUNCID(FluidPropertyTable::setup);
+
+	m_fluidDensity = fluid.m_para[NANDRAD::HydraulicFluid::P_Density].value;
+	m_fluidHeatCapacity = fluid.m_para[NANDRAD::HydraulicFluid::P_HeatCapacity].value;
+	m_fluidConductivity = fluid.m_para[NANDRAD::HydraulicFluid::P_Conductivity].value;
+	m_fluidViscosity = fluid.m_kinematicViscosity.m_values;
+	if (!m_fluidViscosity.valid())
+		throw IBK::Exception("Kinematic viscosity spline of fluid is not initialized.", FUNC_ID);
+
+	const std::vector<double> & x = m_fluidViscosity.x();
+	m_TMin = x.front();
+
+	// single point spline: constant properties, always evaluated from spline
+	if (x.size() == 1) {
+		fillTable(0);
+		return;
+	}
+
+	// grid contains all spline points, so that the piecewise linear viscosity and Prandtl number are reproduced
+	// (up to rounding errors), and is refined (keeping the spline points) to the maximum grid spacing for
+	// the non-linear Prandtl number term
+	const unsigned int nAlignedIntervals = alignedGridIntervals(x);
+	const double range = x.back() - x.front();
+	unsigned int refinement = (unsigned int)std::ceil(range/(FLUID_TABLE_MAX_SPACING*nAlignedIntervals));
+	refinement = std::max(1u, std::min(refinement, FLUID_TABLE_MAX_INTERVALS/nAlignedIntervals));
+	fillTable(nAlignedIntervals*refinement);
+
+	IBK::IBK_Message(IBK::FormatString("Fluid property table with %1 points in range %2 K ... %3 K\n")
+					 .arg(size()).arg(x.front()).arg(x.back()),
+					 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_DETAILED);
+
+#ifdef IBK_DEBUG
+	// spot check in the middle of the first grid interval, accuracy is tested in TestFluidPropertyTable
+	double kinVis, prandtl, turbulentPrandtlTerm;
+	properties(m_TMin + 0.5/m_invDeltaT, kinVis, prandtl, turbulentPrandtlTerm);
+	double kinVisRef, prandtlRef, turbulentPrandtlTermRef;
+	propertiesFromSpline(m_TMin + 0.5/m_invDeltaT, kinVisRef, prandtlRef, turbulentPrandtlTermRef);
+	IBK_ASSERT(std::fabs(turbulentPrandtlTerm - turbulentPrandtlTermRef) < 1e-4*(1 + std::fabs(turbulentPrandtlTermRef)));
+#endif // IBK_DEBUG
+}
+
+
+void FluidPropertyTable::propertiesFromSpline(double T, double & kinVis, double & prandtl,
+											  double & turbulentPrandtlTerm) const
+{
+	kinVis = m_fluidViscosity.value(T);
+	prandtl = PrandtlNumber(kinVis, m_fluidHeatCapacity, m_fluidConductivity, m_fluidDensity);
+	turbulentPrandtlTerm = TurbulentNusseltPrandtlTerm(prandtl);
+}
+
+
+void FluidPropertyTable::fillTable(unsigned int nIntervals) {
+	const std::vector<double> & x = m_fluidViscosity.x();
+
+	m_kinVis.resize(nIntervals + 1);
+	m_prandtl.resize(nIntervals + 1);
+	m_turbulentPrandtlTerm.resize(nIntervals + 1);
+	m_nIntervals = nIntervals;
+
+	if (nIntervals == 0) {
+		m_invDeltaT = 0;
+		propertiesFromSpline(m_TMin, m_kinVis[0], m_prandtl[0], m_turbulentPrandtlTerm[0]);
+		return;
+	}
+
+	const double deltaT = (x.back() - x.front())/nIntervals;
+	m_invDeltaT = 1.0/deltaT;
+	for (unsigned int i=0; i<=nIntervals; ++i) {
+		// last grid point is placed exactly on last spline point
+		double T = (i == nIntervals) ? x.back() : m_TMin + i*deltaT;
+		propertiesFromSpline(T, m_kinVis[i], m_prandtl[i], m_turbulentPrandtlTerm[i]);
+	}
+}
+
+} // namespace NANDRAD_MODEL
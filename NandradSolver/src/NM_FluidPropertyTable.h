@@ -0,0 +1,109 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+#ifndef NM_FluidPropertyTableH
+#define NM_FluidPropertyTableH
+
+#include <vector>
+
+#include <IBK_LinearSpline.h>
+
+namespace NANDRAD {
+	class HydraulicFluid;
+}
+
+namespace NANDRAD_MODEL {
+
+/*! Temperature-dependent fluid properties, tabulated on an equidistant temperature grid.
+
+	Holds kinematic viscosity, Prandtl number and the Prandtl number term (Pr^0.6667 - 1) of the
+	turbulent Nusselt correlation (see TurbulentNusseltPrandtlTerm()) for a fluid. Values are looked up
+	in constant time by linear interpolation between grid points, instead of searching the viscosity
+	spline and evaluating the power function for each pipe.
+
+	The grid covers the temperature range of the viscosity spline, contains all spline points (if possible
+	with a reasonable number of grid points) and has a spacing of at most 0.05 K. Outside the temperature range
+	of the spline, values are computed from the spline directly, so that extrapolation rules are kept.
+*/
+class FluidPropertyTable {
+public:
+	/*! Builds the table from the fluid properties, must be called before any lookup.
+		Throws an IBK::Exception if the viscosity spline is not initialized.
+	*/
+	void setup(const NANDRAD::HydraulicFluid & fluid);
+
+	/*! Looks up all tabulated properties at once.
+		\param T Fluid temperature in [K]
+		\param kinVis Kinematic viscosity in [m2/s]
+		\param prandtl Prandtl number in [---]
+		\param turbulentPrandtlTerm Prandtl number term of turbulent Nusselt correlation in [---]
+	*/
+	void properties(double T, double & kinVis, double & prandtl, double & turbulentPrandtlTerm) const {
+		const double x = (T - m_TMin)*m_invDeltaT;
+		// also handles NaN temperatures
+		if (!(x >= 0 && x < m_nIntervals)) {
+			propertiesFromSpline(T, kinVis, prandtl, turbulentPrandtlTerm);
+			return;
+		}
+		const unsigned int i = (unsigned int)x;
+		const double t = x - i;
+		kinVis = m_kinVis[i] + t*(m_kinVis[i+1] - m_kinVis[i]);
+		prandtl = m_prandtl[i] + t*(m_prandtl[i+1] - m_prandtl[i]);
+		turbulentPrandtlTerm = m_turbulentPrandtlTerm[i] + t*(m_turbulentPrandtlTerm[i+1] - m_turbulentPrandtlTerm[i]);
+	}
+
+	/*! Number of grid points in table. */
+	unsigned int size() const { return (unsigned int)m_kinVis.size(); }
+
+private:
+	/*! Computes properties from viscosity spline (reference path, used to build the table). */
+	void propertiesFromSpline(double T, double & kinVis, double & prandtl, double & turbulentPrandtlTerm) const;
+
+	/*! Fills the table for the given number of intervals. */
+	void fillTable(unsigned int nIntervals);
+
+	/*! Fluid density in [kg/m3]. */
+	double								m_fluidDensity = -999;
+	/*! Fluid heat capacity in [J/kgK]. */
+	double								m_fluidHeatCapacity = -999;
+	/*! Fluid conductivity in [W/mK]. */
+	double								m_fluidConductivity = -999;
+	/*! Fluid kinematic viscosity in [m2/s] (temperature dependent). */
+	IBK::LinearSpline					m_fluidViscosity;
+
+	/*! Temperature of first grid point in [K]. */
+	double								m_TMin = 0;
+	/*! Inverse grid spacing in [1/K] (0 if table has only one grid point). */
+	double								m_invDeltaT = 0;
+	/*! Number of grid intervals (number of grid points - 1) as double, used for range checks. */
+	double								m_nIntervals = 0;
+
+	/*! Tabulated kinematic viscosity in [m2/s]. */
+	std::vector<double>					m_kinVis;
+	/*! Tabulated Prandtl number in [---]. */
+	std::vector<double>					m_prandtl;
+	/*! Tabulated Prandtl number term of turbulent Nusselt correlation in [---]. */
+	std::vector<double>					m_turbulentPrandtlTerm;
+};
+
+} // namespace NANDRAD_MODEL
+
+#endif // NM_FluidPropertyTableH
@@ -28,6 +28,8 @@ HNPipeElement::HNPipeElement(const NANDRAD::HydraulicNetworkElement & elem,
 	m_diameter = pipePara.m_para[NANDRAD::HydraulicNetworkPipeProperties::P_PipeInnerDiameter].value;
 	m_roughness = pipePara.m_para[NANDRAD::HydraulicNetworkPipeProperties::P_PipeRoughness].value;
 	m_nParallelPipes = (unsigned int) elem.m_intPara[NANDRAD::HydraulicNetworkElement::IP_NumberParallelPipes].value;
+	// viscosity for initial fluid temperature
+	setFluidTemperature(m_fluidTemperature);
 }
 
 
@@ -55,6 +57,8 @@ void HNPipeElement::partials(double mdot, double p_inlet, double p_outlet,
 
 void HNPipeElement::setFluidTemperature(double fluidTemp) {
 	m_fluidTemperature = fluidTemp;
+	// viscosity is needed in each evaluation of the pressure loss, so we evaluate the spline only once here
+	m_fluidViscosity = m_fluid->m_kinematicViscosity.m_values.value(m_fluidTemperature);
 }
 
 
@@ -62,7 +66,7 @@ double HNPipeElement::pressureLossFriction(const double &mdot) const {
 	// for negative mass flow: Reynolds number is positive, velocity and pressure loss are negative
 	double fluidDensity = m_fluid->m_para[NANDRAD::HydraulicFluid::P_Density].value;
 	double velocity = mdot / (fluidDensity * m_diameter * m_diameter * PI / 4);
-	double Re = std::abs(velocity) * m_diameter / m_fluid->m_kinematicViscosity.m_values.value(m_fluidTemperature);
+	double Re = std::abs(velocity) * m_diameter / m_fluidViscosity;
 	double zeta = m_length / m_diameter * FrictionFactorSwamee(Re, m_diameter, m_roughness);
 	return zeta * fluidDensity / 2 * std::abs(velocity) * velocity;
 }
@@ -53,6 +53,9 @@ private:
 	/*! Fluid temperature [K], will be updated in each call to setFluidTemperature(). */
 	double							m_fluidTemperature = -999;
 
+	/*! Fluid kinematic viscosity [m2/s] at m_fluidTemperature, will be updated in each call to setFluidTemperature(). */
+	double							m_fluidViscosity = -999;
+
 }; // HNPipeElement
 
 
@@ -13,49 +13,64 @@
 
 #include <klu.h>
 
+#include <limits>
+
 #include "NM_HydraulicNetworkFlowElements.h"
 #include "NM_HydraulicNetworkModel_p.h"
 
 namespace NANDRAD_MODEL {
 
-// *** Pimpl class declaration ***
+// *** Solver for hydraulically separated parts of the network ***
 
-class HydraulicNetworkModelImpl {
+/*! Newton solver for a hydraulically connected part of the network (connected component of the network graph).
+
+	Mass fluxes and nodal pressures of each part are computed independently of all other parts of the network,
+	with an own equation system, jacobian (and KLU objects) and convergence check. Elements and nodes are indexed
+	locally within the component, the corresponding global indexes are stored in m_elementIndexes and m_nodeIndexes.
+*/
+class HydraulicNetworkComponentSolver {
 public:
-	HydraulicNetworkModelImpl(const std::vector<Element> &elems, unsigned int referenceElemIdx);
-	~HydraulicNetworkModelImpl();
+	~HydraulicNetworkComponentSolver();
 
-	/*! Initialized solver based on current content of m_flowElements.
-		Setup needs to be called whenever m_flowElements vector changes
-		(but not, when parameters inside flow elements change!).
-	*/
+	/*! Initializes solver and jacobian based on current content of m_network and m_flowElements. */
 	void setup();
-	/*! Solves the flow network equation system.
-		You must call setup() before calling solve.
+	/*! Solves the flow network equation system of the component, starting from the current content of m_y.
+		Returns 0 on success, otherwise a recoverable error occurred and m_errorMessage holds its description.
+		Components are solved concurrently, hence this function must not write messages itself.
 	*/
 	int solve();
 
-	/*! Container for flow element implementation objects.
-		Need to be populated before calling setup.
-	*/
+	/*! Network structure with local element and node indexes. */
+	Network												m_network;
+	/*! Flow element implementation objects of this component (owned by HydraulicNetworkModelImpl). */
 	std::vector<HydraulicNetworkAbstractFlowElement*>	m_flowElements;
-	/*! Index of node with reference pressure. */
+	/*! Global indexes of all elements in this component. */
+	std::vector<unsigned int>							m_elementIndexes;
+	/*! Global indexes of all nodes in this component. */
+	std::vector<unsigned int>							m_nodeIndexes;
+	/*! Local index of node with reference pressure. */
 	unsigned int										m_pressureRefNodeIdx = NANDRAD::INVALID_ID;
 	/*! Reference pressure. */
 	double												m_referencePressure = 0.0;
-	/*! Network structure. */
-	Network												m_network;
-	/*! Mass fluxes through all elements*/
+	/*! Mass fluxes through all elements of this component. */
 	std::vector<double>									m_fluidMassFluxes;
-	/*! Container with pressures for inlet node of each flow element.
-	*/
-	std::vector<double>									m_inletNodePressures;
-	/*! Container with pressures for each node of each flow element.
+	/*! Pressures of all nodes of this component. */
+	std::vector<double>									m_nodalPressures;
+	/*! Vector with unknowns (scaled mass fluxes and nodal pressures), also used as start solution for
+		the Newton iteration in the next solve() call.
 	*/
-	std::vector<double>									m_outletNodePressures;
-	/*! Container with pressure differences for each flow element.
+	std::vector<double>									m_y;
+
+	/*! If true, the factorized jacobian is reused in subsequent Newton iterations and solve() calls as long
+		as the residuals decrease fast enough (modified Newton method). Otherwise, the jacobian is updated and
+		factorized in each Newton iteration.
 	*/
-	std::vector<double>									m_pressureDifferences;
+	bool												m_modifiedNewton = true;
+
+	/*! Solver statistics (m_solverCalls is counted in HydraulicNetworkModelImpl). */
+	HydraulicNetworkModel::Statistics					m_statistics;
+	/*! Description of the error in the last solve() call, reported by HydraulicNetworkModelImpl::solve(). */
+	const char *										m_errorMessage = nullptr;
 
 private:
 
@@ -64,6 +79,18 @@ private:
 		LESSparse
 	};
 
+	/*! Method used to compose the jacobian. */
+	enum JacobianMethod {
+		/*! Jacobian is assembled from the partial derivatives of the flow elements (see
+			HydraulicNetworkAbstractFlowElement::partials()) and the constant coefficients of the nodal mass balances.
+		*/
+		JacobianAnalytical,
+		/*! Jacobian is approximated by finite-difference quotients, requires one evaluation of the system function
+			per column (dense) or per column group (sparse). Mainly used for verification of the analytical jacobian.
+		*/
+		JacobianFiniteDifferences
+	};
+
 	/*! Structure for dense jacobian */
 	struct DenseSolver {
 		// jacobian
@@ -85,6 +112,8 @@ private:
 		klu_numeric								*m_KLUNumeric = nullptr;
 		// parameters
 		klu_common								m_KLUParas;
+		// reciprocal condition estimate of last complete factorization, used to judge quality of refactorizations
+		double									m_rcondFactor = 0;
 	};
 
 	void printVars() const;
@@ -96,10 +125,24 @@ private:
 	/*! Initialize jacobian and create analytical structures (pattern, KLU reordering,..). */
 	void jacobianInit();
 
-	/*! Updates jacobian data and returns 1, if an error occured, otherwise 0. */
-
+	/*! Updates jacobian data and factorizes the jacobian, returns 1, if an error occured, otherwise 0.
+		For the sparse solver, the pivot ordering of the previous factorization is reused if possible.
+	*/
 	int jacobianSetup();
 
+	/*! Composes the jacobian from the partial derivatives of all flow elements.
+		Requires a call to updateG() with the current m_y beforehand, and a jacobian with all
+		values set to zero.
+	*/
+	template <typename MatrixType>
+	void jacobianAnalytical(MatrixType & jacobian);
+
+	/*! Composes the jacobian with finite-difference quotients.
+		Requires m_G to hold the system function for the current m_y.
+		Note: afterwards, the system function and cached quantities correspond to a modified m_y.
+	*/
+	void jacobianFiniteDifferences();
+
 	/*! Multiplies jacobian with b and stores result in res. */
 	void jacobianMultiply(const std::vector<double> &b, std::vector<double> &res);
 
@@ -112,23 +155,84 @@ private:
 	/*! Flag indicating whether a dense or sparse matrix representation should
 		be used*/
 	LESSolver							m_solverOptions = LESSparse;
+	/*! Method used for composing the jacobian. */
+	JacobianMethod						m_jacobianMethod = JacobianAnalytical;
 	/*! Structure storing dense jacobian information. */
 	DenseSolver							m_denseSolver;
 	/*! Stucture storing sparse jacobian and KLU solver information. */
 	SparseSolver						m_sparseSolver;
 
+	/*! True, if the current jacobian factorization may be reused (modified Newton method). */
+	bool								m_factorizationValid = false;
+
 	unsigned int						m_nodeCount;
 	unsigned int						m_elementCount;
 
-	std::vector<double>					m_nodalPressures;
-
-	/*! Vector with unknowns. */
-	std::vector<double>					m_y;
 	/*! Vector with system function. */
 	std::vector<double>					m_G;
 };
 
 
+// *** Pimpl class declaration ***
+
+class HydraulicNetworkModelImpl {
+public:
+	HydraulicNetworkModelImpl(const std::vector<Element> &elems, unsigned int referenceElemIdx);
+	~HydraulicNetworkModelImpl();
+
+	/*! Initialized solver based on current content of m_flowElements.
+		Setup needs to be called whenever m_flowElements vector changes
+		(but not, when parameters inside flow elements change!).
+		The network is split into hydraulically separated parts, which are solved independently.
+	*/
+	void setup();
+	/*! Solves the flow network equation systems of all hydraulically separated parts.
+		You must call setup() before calling solve.
+	*/
+	int solve();
+
+	/*! Container for flow element implementation objects.
+		Need to be populated before calling setup.
+	*/
+	std::vector<HydraulicNetworkAbstractFlowElement*>	m_flowElements;
+	/*! Index of node with reference pressure. */
+	unsigned int										m_pressureRefNodeIdx = NANDRAD::INVALID_ID;
+	/*! Reference pressure. */
+	double												m_referencePressure = 0.0;
+	/*! Network structure. */
+	Network												m_network;
+	/*! Mass fluxes through all elements*/
+	std::vector<double>									m_fluidMassFluxes;
+	/*! Container with pressures for inlet node of each flow element.
+	*/
+	std::vector<double>									m_inletNodePressures;
+	/*! Container with pressures for each node of each flow element.
+	*/
+	std::vector<double>									m_outletNodePressures;
+	/*! Container with pressure differences for each flow element.
+	*/
+	std::vector<double>									m_pressureDifferences;
+	/*! Vector with unknowns of all components (scaled mass fluxes of all elements, followed by nodal pressures of
+		all nodes), also used as start solution for the Newton iteration in the next solve() call.
+	*/
+	std::vector<double>									m_y;
+
+	/*! Solver statistics (sum of all components). */
+	HydraulicNetworkModel::Statistics					m_statistics;
+
+private:
+	/*! Solvers for all hydraulically separated parts of the network (owned). */
+	std::vector<HydraulicNetworkComponentSolver*>		m_componentSolvers;
+	/*! Return values of component solvers in last solve() call. */
+	std::vector<int>									m_componentSolverResults;
+
+	unsigned int										m_nodeCount;
+	unsigned int										m_elementCount;
+
+	std::vector<double>									m_nodalPressures;
+};
+
+
 // *** HydraulicNetworkModel members ***
 
 HydraulicNetworkModel::HydraulicNetworkModel(const NANDRAD::HydraulicNetwork & nw,
@@ -170,6 +274,11 @@ const Network * HydraulicNetworkModel::network() const {
 	return &m_p->m_network;
 }
 
+
+const HydraulicNetworkModel::Statistics & HydraulicNetworkModel::statistics() const {
+	return m_p->m_statistics;
+}
+
 void HydraulicNetworkModel::setup() {
 	FUNCID(HydraulicNetworkModel::setup);
 
@@ -380,6 +489,22 @@ void HydraulicNetworkModel::variableReferenceSubstitutionMap(std::map<std::strin
 }
 
 
+std::size_t HydraulicNetworkModel::serializationSize() const {
+	return vectorSerializationSize(m_p->m_y);
+}
+
+
+void HydraulicNetworkModel::serialize(void* & dataPtr) const {
+	// store last solution, so that the Newton method continues from the same start solution after restoring
+	serializeVector(dataPtr, m_p->m_y);
+}
+
+
+void HydraulicNetworkModel::deserialize(void* & dataPtr) {
+	deserializeVector(dataPtr, m_p->m_y);
+}
+
+
 void HydraulicNetworkModel::initInputReferences(const std::vector<AbstractModel *> & /*models*/) {
 	// no inputs for now
 }
@@ -460,9 +585,29 @@ const double JACOBIAN_EPS_ABSTOL = 1e-8; // in Pa and scaled kg/s
 
 // convergence threshold for WRMS norm
 const double THRESHOLD = 0.1;
+// modified Newton method: jacobian is updated, if the WRMS norm decreases by less than this factor per iteration
+const double JACOBIAN_UPDATE_RATIO = 0.5;
+// modified Newton method: convergence threshold for WRMS norm after steps with outdated jacobian
+const double THRESHOLD_MODIFIED_NEWTON = 0.01;
+// KLU refactorization is rejected, if the reciprocal condition estimate drops below this fraction of the estimate
+// of the last complete factorization (pivot ordering no longer suitable)
+const double REFACTOR_RCOND_RATIO = 1e-3;
 const double MASS_FLUX_SCALE = 1000;
 
 
+/*! Creates fast access connections between nodes and flow elements. */
+static void connectNodes(Network & network, unsigned int nodeCount) {
+	network.m_nodes.resize(nodeCount);
+	for (unsigned int i=0; i<network.m_elements.size(); ++i) {
+		const Element &fe = network.m_elements[i];
+		network.m_nodes[fe.m_nodeIndexInlet].m_elementIndexesOutlet.push_back(i);
+		network.m_nodes[fe.m_nodeIndexOutlet].m_elementIndexesInlet.push_back(i);
+		network.m_nodes[fe.m_nodeIndexInlet].m_elementIndexes.push_back(i);
+		network.m_nodes[fe.m_nodeIndexOutlet].m_elementIndexes.push_back(i);
+	}
+}
+
+
 HydraulicNetworkModelImpl::HydraulicNetworkModelImpl(const std::vector<Element> &elems, unsigned int referenceElemIdx) {
 	FUNCID(HydraulicNetworkModelImpl::HydraulicNetworkModelImpl);
 	// copy elements vector
@@ -475,14 +620,7 @@ HydraulicNetworkModelImpl::HydraulicNetworkModelImpl(const std::vector<Element>
 	}
 
 	// create fast access connections between nodes and flow elements
-	m_network.m_nodes.resize(nodeCount+1);
-	for (unsigned int i=0; i<elems.size(); ++i) {
-		const Element &fe = elems[i];
-		m_network.m_nodes[fe.m_nodeIndexInlet].m_elementIndexesOutlet.push_back(i);
-		m_network.m_nodes[fe.m_nodeIndexOutlet].m_elementIndexesInlet.push_back(i);
-		m_network.m_nodes[fe.m_nodeIndexInlet].m_elementIndexes.push_back(i);
-		m_network.m_nodes[fe.m_nodeIndexOutlet].m_elementIndexes.push_back(i);
-	}
+	connectNodes(m_network, nodeCount+1);
 
 	// set reference nodeindex: inlet node of reference element
 	m_pressureRefNodeIdx = elems[referenceElemIdx].m_nodeIndexInlet;
@@ -495,15 +633,8 @@ HydraulicNetworkModelImpl::HydraulicNetworkModelImpl(const std::vector<Element>
 
 
 HydraulicNetworkModelImpl::~HydraulicNetworkModelImpl() {
-	// delete KLU specific pointer
-	if (m_sparseSolver.m_KLUSymbolic !=  nullptr) {
-		klu_free_symbolic(&(m_sparseSolver.m_KLUSymbolic), &(m_sparseSolver.m_KLUParas));
-		delete m_sparseSolver.m_KLUSymbolic;
-	}
-	if (m_sparseSolver.m_KLUNumeric !=  nullptr) {
-		klu_free_numeric(&(m_sparseSolver.m_KLUNumeric), &(m_sparseSolver.m_KLUParas));
-		delete m_sparseSolver.m_KLUNumeric;
-	}
+	for (HydraulicNetworkComponentSolver * solver : m_componentSolvers)
+		delete solver;
 }
 
 
@@ -519,6 +650,12 @@ void HydraulicNetworkModelImpl::setup() {
 	for (unsigned int i=0; i<m_network.m_nodes.size(); ++i) {
 		const Node &node = m_network.m_nodes[i];
 		// error check 1
+		if(node.m_elementIndexes.empty()){
+			throw IBK::Exception(IBK::FormatString(
+					"Node %1 is not connected to any flow element of hydraulic network!")
+					 .arg(i).str(),
+					FUNC_ID);
+		}
 		if(node.m_elementIndexes.size() == 1){
 			throw IBK::Exception(IBK::FormatString(
 					"FlowElement with id %1 is an open end of hydraulic network!")
@@ -539,8 +676,8 @@ void HydraulicNetworkModelImpl::setup() {
 	}
 
 
-	// 3.) no distinct networks
-	// -> each node must connect to any other
+	// 3.) distinct networks are solved independently
+	// -> determine connected components of the network graph
 
 	// create adjancency information between connected nodes
 	std::vector<std::vector<unsigned int> > nodeConnections(m_network.m_nodes.size());
@@ -561,83 +698,64 @@ void HydraulicNetworkModelImpl::setup() {
 		nodeConnections[j].push_back(i);
 	}
 
-	// use Cuthill McKee algorithm in order to check connectivity
-	// create path vector
-	std::vector<unsigned int>	path(m_nodeCount, (unsigned int)(-1));
-	std::vector<unsigned int>   nodeList(m_nodeCount, (unsigned int)(-1));
-	unsigned int subPathLen = 1; // remaining length of path is 1
-	// set path index (index of node
-	unsigned int subPathStartIdx = 0;
-
-	// we start numbering using CMK algorithm
-	path[0] = 0;
-
-	// number all nodes, n is the new node number
-	for (unsigned int n = 0; n < m_nodeCount; ++n) {
-
-		// if path is empty and we still have nodes (k<n) registert, than
-		// the graph is not fully connected
-		if (subPathLen == 0) {
-			std::set<unsigned int> disjunctElements;
-			// find out disjunct network elements
-			for (unsigned int j = 0; j < m_nodeCount; ++j) {
-				disjunctElements.insert(j);
-			}
-			for (unsigned int j = 0; j < m_nodeCount; ++j) {
-				if (nodeList[j] != (unsigned int)(-1)) {
-					disjunctElements.erase(nodeList[j]);
-				}
+	// breadth-first search starting from the lowest node index not yet assigned to a component
+	std::vector<unsigned int> nodeComponent(m_nodeCount, (unsigned int)(-1));
+	unsigned int componentCount = 0;
+	std::vector<unsigned int> path;
+	for (unsigned int startIdx = 0; startIdx < m_nodeCount; ++startIdx) {
+		if (nodeComponent[startIdx] != (unsigned int)(-1))
+			continue;
+		nodeComponent[startIdx] = componentCount;
+		path.assign(1, startIdx);
+		for (unsigned int k=0; k<path.size(); ++k) {
+			for (unsigned int nextNodeIdx : nodeConnections[path[k]]) {
+				if (nodeComponent[nextNodeIdx] != (unsigned int)(-1))
+					continue;
+				nodeComponent[nextNodeIdx] = componentCount;
+				path.push_back(nextNodeIdx);
 			}
-			// create a string for all missing elements
-			IBK_ASSERT(!disjunctElements.empty());
-			std::string networkStr(IBK::val2string<unsigned int>(*disjunctElements.begin()));
-
-			for(std::set<unsigned int>::const_iterator elemIt = disjunctElements.begin();
-				elemIt != disjunctElements.end(); ++elemIt)
-				networkStr += std::string(",") + IBK::val2string<unsigned int>(*elemIt);
-
-			throw IBK::Exception(IBK::FormatString(
-					"Network is not completely connected! Distinct network formed by flow elements (%1)!")
-					.arg(networkStr).str(),
-					FUNC_ID);
 		}
+		++componentCount;
+	}
 
-		// get next node number from registered path
-		unsigned int nodeIdx = path[subPathStartIdx++]; // increase path index
-		--subPathLen; // decrease length of remaining path
-
-		// relabel node and store node mapping
-		nodeList[nodeIdx] = n;
-
-		// create convenience pointer to node numbers connected to this node
-		const std::vector<unsigned int> &nodeConnect = nodeConnections[nodeIdx];
-
-		// get degree of this node
-		unsigned int nNeighbors = nodeConnect.size();
+	if (componentCount > 1)
+		IBK::IBK_Message(IBK::FormatString("Network consists of %1 hydraulically separated parts, which are solved "
+										   "independently.\n").arg(componentCount), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 
-		// loop through all neighbors and connect to corresponding nodes
-		for (unsigned int j=0; j < nNeighbors; ++j) {
-			// get node number of neighboring node (nnn == old numbering)
-			unsigned int nextNodeIdx = nodeConnect[j];
+	// create solvers for all components, local element and node indexes are assigned in the order of global indexes
+	for (HydraulicNetworkComponentSolver * solver : m_componentSolvers)
+		delete solver;
+	m_componentSolvers.clear();
+	for (unsigned int c=0; c<componentCount; ++c)
+		m_componentSolvers.push_back(new HydraulicNetworkComponentSolver);
 
-			// check if this node has already been renumbered
-			if (nodeList[nextNodeIdx] != (unsigned int)(-1) )
-				continue; // skip this node
+	std::vector<unsigned int> localNodeIndexes(m_nodeCount);
+	for (unsigned int i=0; i<m_nodeCount; ++i) {
+		HydraulicNetworkComponentSolver * solver = m_componentSolvers[nodeComponent[i]];
+		localNodeIndexes[i] = solver->m_nodeIndexes.size();
+		solver->m_nodeIndexes.push_back(i);
+	}
+	for (unsigned int i=0; i<m_elementCount; ++i) {
+		const Element &fe = m_network.m_elements[i];
+		HydraulicNetworkComponentSolver * solver = m_componentSolvers[nodeComponent[fe.m_nodeIndexInlet]];
+		solver->m_network.m_elements.push_back(Element(localNodeIndexes[fe.m_nodeIndexInlet],
+													   localNodeIndexes[fe.m_nodeIndexOutlet]));
+		solver->m_flowElements.push_back(m_flowElements[i]);
+		solver->m_elementIndexes.push_back(i);
+	}
 
-			// check if this node is already in the list
-			unsigned int k = subPathStartIdx;
-			for (; k < subPathStartIdx + subPathLen; ++k) {
-				if (path[k] == nextNodeIdx)
-					break;
-			}
-			if (k != subPathStartIdx + subPathLen)
-				continue;
-			// register node in path
-			path[k] = nextNodeIdx;
-			// correct sub path lenght from current node
-			++subPathLen;
-		}
+	for (HydraulicNetworkComponentSolver * solver : m_componentSolvers) {
+		connectNodes(solver->m_network, solver->m_nodeIndexes.size());
+		// reference pressure is applied to the reference node, in all other parts of the network to the
+		// inlet node of the first element
+		if (solver == m_componentSolvers[nodeComponent[m_pressureRefNodeIdx]])
+			solver->m_pressureRefNodeIdx = localNodeIndexes[m_pressureRefNodeIdx];
+		else
+			solver->m_pressureRefNodeIdx = solver->m_network.m_elements[0].m_nodeIndexInlet;
+		solver->m_referencePressure = m_referencePressure;
+		solver->setup();
 	}
+	m_componentSolverResults.resize(componentCount);
 
 	// count number of nodes
 	unsigned int n = m_nodeCount + m_elementCount;
@@ -645,12 +763,36 @@ void HydraulicNetworkModelImpl::setup() {
 	// set initial conditions (pressures and mass fluxes)
 	m_y.resize(n, 10);
 
-	m_G.resize(n);
 	m_fluidMassFluxes.resize(m_elementCount);
 	m_inletNodePressures.resize(m_elementCount);
 	m_outletNodePressures.resize(m_elementCount);
 	m_nodalPressures.resize(m_nodeCount);
 	m_pressureDifferences.resize(m_elementCount);
+}
+
+
+HydraulicNetworkComponentSolver::~HydraulicNetworkComponentSolver() {
+	// delete KLU specific pointer
+	if (m_sparseSolver.m_KLUSymbolic !=  nullptr) {
+		klu_free_symbolic(&(m_sparseSolver.m_KLUSymbolic), &(m_sparseSolver.m_KLUParas));
+		delete m_sparseSolver.m_KLUSymbolic;
+	}
+	if (m_sparseSolver.m_KLUNumeric !=  nullptr) {
+		klu_free_numeric(&(m_sparseSolver.m_KLUNumeric), &(m_sparseSolver.m_KLUParas));
+		delete m_sparseSolver.m_KLUNumeric;
+	}
+}
+
+
+void HydraulicNetworkComponentSolver::setup() {
+	m_nodeCount = m_network.m_nodes.size();
+	m_elementCount = m_network.m_elements.size();
+
+	unsigned int n = m_nodeCount + m_elementCount;
+	m_y.resize(n, 10);
+	m_G.resize(n);
+	m_fluidMassFluxes.resize(m_elementCount);
+	m_nodalPressures.resize(m_nodeCount);
 
 	// create jacobian
 	jacobianInit();
@@ -667,7 +809,7 @@ double WRMSNorm(const std::vector<double> & vec) {
 }
 
 
-void HydraulicNetworkModelImpl::printVars() const {
+void HydraulicNetworkComponentSolver::printVars() const {
 	std::cout << "Mass fluxes [kg/s]" << std::endl;
 	for (unsigned int i=0; i<m_elementCount; ++i)
 		std::cout << "  " << i << "   " << m_y[i]/MASS_FLUX_SCALE  << std::endl;
@@ -678,7 +820,7 @@ void HydraulicNetworkModelImpl::printVars() const {
 }
 
 
-void HydraulicNetworkModelImpl::writeNetworkGraph() const {
+void HydraulicNetworkComponentSolver::writeNetworkGraph() const {
 #if 0
 	// generate dot graph file for plotting
 	std::stringstream strm;
@@ -701,11 +843,91 @@ void HydraulicNetworkModelImpl::writeNetworkGraph() const {
 
 int HydraulicNetworkModelImpl::solve() {
 	FUNCID(HydraulicNetworkModelImpl::solve);
+	++m_statistics.m_solverCalls;
+
+	// distribute current solution to all parts of the network
+	for (HydraulicNetworkComponentSolver * solver : m_componentSolvers) {
+		const unsigned int elementCount = solver->m_elementIndexes.size();
+		for (unsigned int i=0; i<elementCount; ++i)
+			solver->m_y[i] = m_y[solver->m_elementIndexes[i]];
+		for (unsigned int i=0; i<solver->m_nodeIndexes.size(); ++i)
+			solver->m_y[elementCount + i] = m_y[m_elementCount + solver->m_nodeIndexes[i]];
+	}
+
+	// separated parts of the network are independent equation systems, each with own Newton iteration
+	// and convergence check; flow elements are only accessed by the solver of their part
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic) if(m_componentSolvers.size() > 1)
+#endif
+	for (int c=0; c<(int)m_componentSolvers.size(); ++c)
+		m_componentSolverResults[c] = m_componentSolvers[c]->solve();
 
+	// report errors of component solvers only after the parallel loop, message handler is not thread-safe
+	for (unsigned int c=0; c<m_componentSolvers.size(); ++c) {
+		if (m_componentSolverResults[c] == 0)
+			continue;
+		if (m_componentSolvers.size() == 1) {
+			IBK_FastMessage(IBK::VL_DETAILED)(m_componentSolvers[c]->m_errorMessage, IBK::MSG_ERROR, FUNC_ID, IBK::VL_DETAILED);
+		}
+		else {
+			IBK_FastMessage(IBK::VL_DETAILED)(IBK::FormatString("Network part #%1: %2").arg(c+1)
+											  .arg(std::string(m_componentSolvers[c]->m_errorMessage)), IBK::MSG_ERROR, FUNC_ID, IBK::VL_DETAILED);
+		}
+	}
+
+	// collect results and statistics
+	unsigned int newtonIterations = 0;
+	unsigned int jacobianUpdates = 0;
+	unsigned int factorizations = 0;
+	unsigned int refactorizations = 0;
+	for (const HydraulicNetworkComponentSolver * solver : m_componentSolvers) {
+		const unsigned int elementCount = solver->m_elementIndexes.size();
+		for (unsigned int i=0; i<elementCount; ++i) {
+			m_y[solver->m_elementIndexes[i]] = solver->m_y[i];
+			m_fluidMassFluxes[solver->m_elementIndexes[i]] = solver->m_fluidMassFluxes[i];
+		}
+		for (unsigned int i=0; i<solver->m_nodeIndexes.size(); ++i) {
+			m_y[m_elementCount + solver->m_nodeIndexes[i]] = solver->m_y[elementCount + i];
+			m_nodalPressures[solver->m_nodeIndexes[i]] = solver->m_nodalPressures[i];
+		}
+		newtonIterations += solver->m_statistics.m_newtonIterations;
+		jacobianUpdates += solver->m_statistics.m_jacobianUpdates;
+		factorizations += solver->m_statistics.m_factorizations;
+		refactorizations += solver->m_statistics.m_refactorizations;
+	}
+	m_statistics.m_newtonIterations = newtonIterations;
+	m_statistics.m_jacobianUpdates = jacobianUpdates;
+	m_statistics.m_factorizations = factorizations;
+	m_statistics.m_refactorizations = refactorizations;
+
+	// update nodal values
+	for(unsigned int i = 0; i < m_network.m_elements.size(); ++i) {
+		const Element &e = m_network.m_elements[i];
+		double inletNodePressure = m_nodalPressures[e.m_nodeIndexInlet];
+		double outletNodePressure = m_nodalPressures[e.m_nodeIndexOutlet];
+		m_inletNodePressures[i] = inletNodePressure;
+		m_outletNodePressures[i] = outletNodePressure;
+		m_pressureDifferences[i] = inletNodePressure - outletNodePressure;
+	}
+
+	for (int res : m_componentSolverResults) {
+		if (res != 0)
+			return res;
+	}
+	return 0;
+}
+
+
+int HydraulicNetworkComponentSolver::solve() {
 	unsigned int n = m_nodeCount + m_elementCount;
 
 	std::vector<double> rhs(n);
 
+	// solution and residual norm before last Newton step, used for modified Newton method
+	std::vector<double> yLast;
+	double resNormLast = std::numeric_limits<double>::max();
+	bool lastStepWithOutdatedJacobian = false;
+
 	// now start the Newton iteration
 	int iterations = 100;
 	while (--iterations > 0) {
@@ -720,20 +942,41 @@ int HydraulicNetworkModelImpl::solve() {
 		// and evaluate residuals
 		double resNorm = WRMSNorm(m_G);
 //		std::cout << "res = " << resNorm << std::endl;
-		if (resNorm < THRESHOLD)
+		// steps with outdated jacobian converge only linearly, hence we require a smaller residual norm
+		// to obtain the same accuracy as with the full Newton method
+		if (resNorm < (lastStepWithOutdatedJacobian ? THRESHOLD_MODIFIED_NEWTON : THRESHOLD))
 			break;
 
-		// now compose Jacobian with FD quotients
+		// step with outdated jacobian did not reduce residuals: discard step and retry with updated jacobian
+		if (lastStepWithOutdatedJacobian && resNorm >= resNormLast) {
+			m_y = yLast;
+			m_factorizationValid = false;
+			lastStepWithOutdatedJacobian = false;
+			continue;
+		}
 
-		// perform jacobian update
-		int res = jacobianSetup();
-		// error signaled:
-		// may be result of a diverging Newton iteration
-		// -> regsiter a recoverable error and allow a retry
-		if (res != 0) {
-			IBK_FastMessage(IBK::VL_DETAILED)("Error during Jacobian setup.", IBK::MSG_ERROR, FUNC_ID, IBK::VL_DETAILED);
-			return 1;
+		// modified Newton: reuse factorized jacobian of previous iterations/solve() calls as long as the
+		// residuals decrease fast enough
+		bool updateJacobian = !m_modifiedNewton || !m_factorizationValid || resNorm > JACOBIAN_UPDATE_RATIO*resNormLast;
+		if (updateJacobian) {
+			// perform jacobian update
+			int res = jacobianSetup();
+			// error signaled:
+			// may be result of a diverging Newton iteration
+			// -> regsiter a recoverable error and allow a retry
+			if (res != 0) {
+				m_factorizationValid = false;
+				m_errorMessage = "Error during Jacobian setup.";
+				return 1;
+			}
+			m_factorizationValid = true;
 		}
+		else {
+			yLast = m_y;
+		}
+		lastStepWithOutdatedJacobian = !updateJacobian;
+		resNormLast = resNorm;
+		++m_statistics.m_newtonIterations;
 
 //		std::cout << "\n\n*** Iter " << 100-iterations  << std::endl;
 
@@ -745,10 +988,11 @@ int HydraulicNetworkModelImpl::solve() {
 #endif // RESIDUAL_TEST
 
 		// now solve the equation system
-		res = jacobianBacksolve(rhs);
+		int res = jacobianBacksolve(rhs);
 		// backsolving problems imply coarse structural errors
 		if (res != 0) {
-			IBK_FastMessage(IBK::VL_DETAILED)("Error solving equation system.", IBK::MSG_ERROR, FUNC_ID, IBK::VL_DETAILED);
+			m_factorizationValid = false;
+			m_errorMessage = "Error solving equation system.";
 			return 2;
 		}
 
@@ -788,29 +1032,19 @@ int HydraulicNetworkModelImpl::solve() {
 	printVars();
 #endif // NANDRAD_NETWORK_DEBUG_OUTPUTS
 
-	// update nodal values
-	for(unsigned int i = 0; i < m_network.m_elements.size(); ++i) {
-		const Element &e = m_network.m_elements[i];
-		double inletNodePressure = m_nodalPressures[e.m_nodeIndexInlet];
-		double outletNodePressure = m_nodalPressures[e.m_nodeIndexOutlet];
-		m_inletNodePressures[i] = inletNodePressure;
-		m_outletNodePressures[i] = outletNodePressure;
-		m_pressureDifferences[i] = inletNodePressure - outletNodePressure;
-	}
-
-
 	if (iterations > 0)
 		return 0;
 	// we register a recoverable error if the system did not converge
 	// (and allow a retry with a new guess)
 	else {
-		IBK_FastMessage(IBK::VL_DETAILED)("Not converged within given number of iterations.", IBK::MSG_ERROR, FUNC_ID, IBK::VL_DETAILED);
+		m_factorizationValid = false;
+		m_errorMessage = "Not converged within given number of iterations.";
 		return 1;
 	}
 
 }
 
-void HydraulicNetworkModelImpl::jacobianInit() {
+void HydraulicNetworkComponentSolver::jacobianInit() {
 
 	unsigned int n = m_nodeCount + m_elementCount;
 	// if sparse solver is not available use dense matrix
@@ -959,7 +1193,125 @@ void HydraulicNetworkModelImpl::jacobianInit() {
 }
 
 
-int HydraulicNetworkModelImpl::jacobianSetup() {
+int HydraulicNetworkComponentSolver::jacobianSetup() {
+
+	++m_statistics.m_jacobianUpdates;
+	if (m_jacobianMethod == JacobianAnalytical) {
+		if (m_denseSolver.m_jacobian.n() > 0) {
+			m_denseSolver.m_jacobian.setZero();
+			jacobianAnalytical(m_denseSolver.m_jacobian);
+		}
+		else {
+			IBKMK::SparseMatrixCSR &jacobian = m_sparseSolver.m_jacobian;
+			std::fill(jacobian.data(), jacobian.data() + jacobian.dataSize(), 0);
+			jacobianAnalytical(jacobian);
+		}
+
+#ifdef NANDRAD_NETWORK_JACOBIAN_CHECK
+		// compare with finite-difference approximation
+		std::vector<double> analyticalJacobian;
+		if (m_denseSolver.m_jacobian.n() > 0)
+			analyticalJacobian = m_denseSolver.m_jacobian.data();
+		else
+			analyticalJacobian.assign(m_sparseSolver.m_jacobian.data(),
+									  m_sparseSolver.m_jacobian.data() + m_sparseSolver.m_jacobian.dataSize());
+		jacobianFiniteDifferences();
+		double * fdJacobian = (m_denseSolver.m_jacobian.n() > 0) ? &m_denseSolver.m_jacobian.data()[0] : m_sparseSolver.m_jacobian.data();
+		double maxDeviation = 0;
+		for (unsigned int i=0; i<analyticalJacobian.size(); ++i) {
+			double deviation = std::fabs(analyticalJacobian[i] - fdJacobian[i])/(std::fabs(fdJacobian[i]) + 1e-6);
+			maxDeviation = std::max(maxDeviation, deviation);
+		}
+		std::cout << "Max. relative deviation analytical/FD jacobian = " << maxDeviation << std::endl;
+		// restore analytical jacobian and system function
+		std::copy(analyticalJacobian.begin(), analyticalJacobian.end(), fdJacobian);
+		updateG();
+#endif // NANDRAD_NETWORK_JACOBIAN_CHECK
+	}
+	else {
+		jacobianFiniteDifferences();
+	}
+
+	if (m_denseSolver.m_jacobian.n() > 0) {
+		IBKMK::DenseMatrix &jacobian = m_denseSolver.m_jacobian;
+		IBKMK::DenseMatrix &jacobianFac = m_denseSolver.m_jacobianFactorized;
+		// copy jacobian
+		std::copy(jacobian.data().begin(), jacobian.data().end(),
+				  jacobianFac.data().begin());
+		// factorize matrix
+		++m_statistics.m_factorizations;
+		int res = jacobianFac.lu(); // Note: might be singular!!!
+		// singular
+		if( res != 0)
+			return 1;
+	}
+	// we use a sparse jacobian representation
+	else if(m_sparseSolver.m_jacobian.nnz() > 0) {
+		IBKMK::SparseMatrixCSR &jacobian = m_sparseSolver.m_jacobian;
+		// if we have a previous factorization, try to reuse its pivot ordering (pattern is fixed)
+		if (m_sparseSolver.m_KLUNumeric != nullptr) {
+			int success = klu_refactor((int*) jacobian.ia(),
+						(int*) jacobian.ja(),
+						 jacobian.data(),
+						 m_sparseSolver.m_KLUSymbolic,
+						 m_sparseSolver.m_KLUNumeric,
+						 &(m_sparseSolver.m_KLUParas));
+			// accept refactorization only if pivots are still acceptable
+			if (success &&
+				klu_rcond(m_sparseSolver.m_KLUSymbolic, m_sparseSolver.m_KLUNumeric, &(m_sparseSolver.m_KLUParas)) &&
+				m_sparseSolver.m_KLUParas.rcond >= REFACTOR_RCOND_RATIO*m_sparseSolver.m_rcondFactor)
+			{
+				++m_statistics.m_refactorizations;
+				return 0;
+			}
+			// fall back to complete factorization
+			klu_free_numeric(&(m_sparseSolver.m_KLUNumeric), &(m_sparseSolver.m_KLUParas));
+		}
+		// calculate lu composition for klu object (creating a new pivit ordering)
+		++m_statistics.m_factorizations;
+		m_sparseSolver.m_KLUNumeric = klu_factor((int*) jacobian.ia(),
+					(int*) jacobian.ja(),
+					 jacobian.data(),
+					 m_sparseSolver.m_KLUSymbolic,
+					 &(m_sparseSolver.m_KLUParas));
+		// error treatment: singular matrix
+		if (m_sparseSolver.m_KLUNumeric == nullptr)
+			return 1;
+		klu_rcond(m_sparseSolver.m_KLUSymbolic, m_sparseSolver.m_KLUNumeric, &(m_sparseSolver.m_KLUParas));
+		m_sparseSolver.m_rcondFactor = m_sparseSolver.m_KLUParas.rcond;
+	}
+	return 0;
+}
+
+
+template <typename MatrixType>
+void HydraulicNetworkComponentSolver::jacobianAnalytical(MatrixType & jacobian) {
+	// flow element equations: derivatives of system function with respect to
+	// (scaled) mass flux and inlet/outlet node pressures
+	for (unsigned int i=0; i<m_elementCount; ++i) {
+		const Element &fe = m_network.m_elements[i];
+		double df_dmdot, df_dp_inlet, df_dp_outlet;
+		m_flowElements[i]->partials(m_fluidMassFluxes[i], m_nodalPressures[fe.m_nodeIndexInlet],
+									m_nodalPressures[fe.m_nodeIndexOutlet], df_dmdot, df_dp_inlet, df_dp_outlet);
+		jacobian(i, i) = df_dmdot/MASS_FLUX_SCALE;
+		jacobian(i, fe.m_nodeIndexInlet + m_elementCount) += df_dp_inlet;
+		jacobian(i, fe.m_nodeIndexOutlet + m_elementCount) += df_dp_outlet;
+	}
+
+	// nodal equations: mass balances are linear in the scaled mass fluxes, mass flux leaves the
+	// inlet node and enters the outlet node of each flow element
+	for (unsigned int i=0; i<m_elementCount; ++i) {
+		const Element &fe = m_network.m_elements[i];
+		jacobian(fe.m_nodeIndexInlet + m_elementCount, i) -= 1;
+		jacobian(fe.m_nodeIndexOutlet + m_elementCount, i) += 1;
+	}
+
+	// nodal constraint to reference node
+	jacobian(m_pressureRefNodeIdx + m_elementCount, m_pressureRefNodeIdx + m_elementCount) += 1;
+}
+
+
+void HydraulicNetworkComponentSolver::jacobianFiniteDifferences() {
 
 	unsigned int n = m_nodeCount + m_elementCount;
 	std::vector<double> Gy(n);
@@ -970,7 +1322,6 @@ int HydraulicNetworkModelImpl::jacobianSetup() {
 	if (m_denseSolver.m_jacobian.n() > 0) {
 
 		IBKMK::DenseMatrix &jacobian = m_denseSolver.m_jacobian;
-		IBKMK::DenseMatrix &jacobianFac = m_denseSolver.m_jacobianFactorized;
 		// loop over all variables
 		for (unsigned int j=0; j<n; ++j) {
 			// modify y_j by a small EPS
@@ -989,14 +1340,6 @@ int HydraulicNetworkModelImpl::jacobianSetup() {
 			// restore y
 			m_y[j] -= eps;
 		}
-		// copy jacobian
-		std::copy(jacobian.data().begin(), jacobian.data().end(),
-				  jacobianFac.data().begin());
-		// factorize matrix
-		int res = jacobianFac.lu(); // Note: might be singular!!!
-		// singular
-		if( res != 0)
-			return 1;
 	}
 	// we use a sparse jacobian representation
 	else if(m_sparseSolver.m_jacobian.nnz() > 0) {
@@ -1051,20 +1394,11 @@ int HydraulicNetworkModelImpl::jacobianSetup() {
 				m_y[j] -= eps;
 			}
 		} // for i
-		// calculate lu composition for klu object (creating a new pivit ordering)
-		m_sparseSolver.m_KLUNumeric = klu_factor((int*) jacobian.ia(),
-					(int*) jacobian.ja(),
-					 jacobian.data(),
-					 m_sparseSolver.m_KLUSymbolic,
-					 &(m_sparseSolver.m_KLUParas));
-		// error treatment: singular matrix
-		if (m_sparseSolver.m_KLUNumeric == nullptr)
-			return 1;
 	}
-	return 0;
 }
 
-void HydraulicNetworkModelImpl::jacobianMultiply(const std::vector<double> &b, std::vector<double> &res) {
+
+void HydraulicNetworkComponentSolver::jacobianMultiply(const std::vector<double> &b, std::vector<double> &res) {
 
 	if(m_denseSolver.m_jacobian.n() > 0)
 		m_denseSolver.m_jacobian.multiply(&b[0], &res[0]);
@@ -1073,7 +1407,7 @@ void HydraulicNetworkModelImpl::jacobianMultiply(const std::vector<double> &b, s
 }
 
 
-int HydraulicNetworkModelImpl::jacobianBacksolve(std::vector<double> & rhs) {
+int HydraulicNetworkComponentSolver::jacobianBacksolve(std::vector<double> & rhs) {
 
 	// decide which matrix to use
 	if(m_denseSolver.m_jacobian.n() > 0) {
@@ -1097,7 +1431,7 @@ int HydraulicNetworkModelImpl::jacobianBacksolve(std::vector<double> & rhs) {
 }
 
 
-void HydraulicNetworkModelImpl::jacobianWrite(std::vector<double> & rhs) {
+void HydraulicNetworkComponentSolver::jacobianWrite(std::vector<double> & rhs) {
 
 	std::cout << "Jacobian:" << std::endl;
 
@@ -1109,7 +1443,7 @@ void HydraulicNetworkModelImpl::jacobianWrite(std::vector<double> & rhs) {
 
 #ifdef PRESSURES_FIRST
 
-void HydraulicNetworkModelImpl::updateG() {
+void HydraulicNetworkComponentSolver::updateG() {
 
 	// extract mass flows
 	for (unsigned int i=0; i<m_elementCount; ++i) {
@@ -1160,7 +1494,7 @@ void HydraulicNetworkModelImpl::updateG() {
 
 #else
 
-void HydraulicNetworkModelImpl::updateG() {
+void HydraulicNetworkComponentSolver::updateG() {
 
 	// extract mass flows
 	for (unsigned int i=0; i<m_elementCount; ++i) {
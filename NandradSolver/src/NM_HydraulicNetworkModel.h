@@ -28,6 +28,20 @@ struct Network;
 */
 class HydraulicNetworkModel : public AbstractModel, public AbstractStateDependency {
 public:
+	/*! Counters collected by the network solver. */
+	struct Statistics {
+		/*! Number of network solver calls. */
+		unsigned int	m_solverCalls = 0;
+		/*! Total number of Newton iterations. */
+		unsigned int	m_newtonIterations = 0;
+		/*! Number of jacobian updates. */
+		unsigned int	m_jacobianUpdates = 0;
+		/*! Number of complete factorizations (including pivot search). */
+		unsigned int	m_factorizations = 0;
+		/*! Number of numerical refactorizations that reuse the pivot ordering of a previous factorization (KLU only). */
+		unsigned int	m_refactorizations = 0;
+	};
+
 	/*! Constructor. */
 	HydraulicNetworkModel(const NANDRAD::HydraulicNetwork & nw,
 		unsigned int id, const std::string &displayName);
@@ -38,6 +52,9 @@ public:
 	/*! Constant access to network topology*/
 	const Network *network() const;
 
+	/*! Returns network solver statistics. */
+	const Statistics & statistics() const;
+
 	/*! Initializes model.
 		\param nw The hydraulic network model definition/parametrization.
 	*/
@@ -78,6 +95,15 @@ public:
 	*/
 	void variableReferenceSubstitutionMap(std::map<std::string, std::string> & varSubstMap) override;
 
+	/*! Returns size needed to serialize the current network solution. */
+	virtual std::size_t serializationSize() const override;
+
+	/*! Stores current network solution (start solution for next Newton iteration). */
+	virtual void serialize(void* & dataPtr) const override;
+
+	/*! Restores network solution. */
+	virtual void deserialize(void* & dataPtr) override;
+
 
 	// *** Re-implemented from AbstractStateDependency
 
@@ -34,6 +34,7 @@
 #include <IBK_FileUtils.h>
 #include <IBK_physics.h>
 #include <IBK_ScalarFunction.h>
+#include <IBK_StopWatch.h>
 #include <IBK_messages.h>
 #include <IBK_Constants.h>
 #include <IBK_FormatString.h>
@@ -56,7 +57,7 @@ inline bool nearlyEqual(double a, double b, double eps = 1e-5) {
 // *** Loads ***
 
 void Loads::setup(const NANDRAD::Location & location, const NANDRAD::SimulationParameter &simPara,
-	const std::map<std::string, IBK::Path> & pathPlaceHolders)
+	const std::map<std::string, IBK::Path> & pathPlaceHolders, const Loads * climateDataSource)
 {
 	FUNCID(Loads::setup);
 
@@ -70,8 +71,13 @@ void Loads::setup(const NANDRAD::Location & location, const NANDRAD::SimulationP
 		IBK::Path climateFile = IBK::Path(location.m_climateFilePath).withReplacedPlaceholders(pathPlaceHolders);
 
 		try {
-			IBK::IBK_Message(IBK::FormatString("Reading climate data file '%1'\n").arg(climateFile), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-			m_solarRadiationModel.m_climateDataLoader.readClimateData(climateFile);
+			if (climateDataSource != nullptr) {
+				m_solarRadiationModel.m_climateDataLoader = climateDataSource->m_solarRadiationModel.m_climateDataLoader;
+			}
+			else {
+				IBK::IBK_Message(IBK::FormatString("Reading climate data file '%1'\n").arg(climateFile), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+				m_solarRadiationModel.m_climateDataLoader.readClimateData(climateFile);
+			}
 		}
 		catch (IBK::Exception &ex) {
 			throw IBK::Exception(ex, IBK::FormatString("Error reading climate data from file '%1")
@@ -93,10 +99,12 @@ void Loads::setup(const NANDRAD::Location & location, const NANDRAD::SimulationP
 		// cases to completely wrong results (at least, when latitude is changed).
 
 
-		IBK::IBK_Message(IBK::FormatString("Climate data set location: Latitude: %1 deg, Longitude: %2 deg\n")
-						 .arg(m_solarRadiationModel.m_climateDataLoader.m_latitudeInDegree)
-						 .arg(m_solarRadiationModel.m_climateDataLoader.m_longitudeInDegree), IBK::MSG_PROGRESS,
-						 FUNC_ID, IBK::VL_INFO);
+		// replicas (climateDataSource != nullptr) do not repeat the messages of the source model
+		if (climateDataSource == nullptr)
+			IBK::IBK_Message(IBK::FormatString("Climate data set location: Latitude: %1 deg, Longitude: %2 deg\n")
+							 .arg(m_solarRadiationModel.m_climateDataLoader.m_latitudeInDegree)
+							 .arg(m_solarRadiationModel.m_climateDataLoader.m_longitudeInDegree), IBK::MSG_PROGRESS,
+							 FUNC_ID, IBK::VL_INFO);
 
 		// latitude
 		const IBK::Parameter &latitude = location.m_para[NANDRAD::Location::P_Latitude];
@@ -106,8 +114,9 @@ void Loads::setup(const NANDRAD::Location & location, const NANDRAD::SimulationP
 				throw IBK::Exception(IBK::FormatString("Error initializing climate data: "
 					"Location parameter 'Latitude' is expected to be between -90 and 90 degrees."), FUNC_ID);
 			}
-			IBK::IBK_Message(IBK::FormatString("Setting latitude to %1 deg\n").arg(latInDeg),
-							 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
+			if (climateDataSource == nullptr)
+				IBK::IBK_Message(IBK::FormatString("Setting latitude to %1 deg\n").arg(latInDeg),
+								 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
 			m_solarRadiationModel.m_climateDataLoader.m_latitudeInDegree = latInDeg;
 		}
 
@@ -119,8 +128,9 @@ void Loads::setup(const NANDRAD::Location & location, const NANDRAD::SimulationP
 				throw IBK::Exception(IBK::FormatString("Error initializing climate data: "
 					"Location parameter 'Longitude' is expected to be between -180 and 180 degrees."), FUNC_ID);
 			}
-			IBK::IBK_Message(IBK::FormatString("Setting latitude to %1 deg\n").arg(longInDeg),
-							 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
+			if (climateDataSource == nullptr)
+				IBK::IBK_Message(IBK::FormatString("Setting latitude to %1 deg\n").arg(longInDeg),
+								 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
 			m_solarRadiationModel.m_climateDataLoader.m_longitudeInDegree = longInDeg;
 		}
 		// ensure that either both latitude and longitude are given, or none
@@ -149,6 +159,16 @@ void Loads::setup(const NANDRAD::Location & location, const NANDRAD::SimulationP
 			m_solarRadiationModel.m_diffuseRadiationPerezEnabled = true;
 
 
+		// precomputed radiation table, computed in initResults() once all surfaces are known
+		const IBK::Parameter &tableStep = location.m_para[NANDRAD::Location::P_SolarRadiationTableStep];
+		if (!tableStep.name.empty()) {
+			if (tableStep.value <= 0 || tableStep.value > 3600)
+				throw IBK::Exception(IBK::FormatString("Error initializing climate data: "
+					"Location parameter 'SolarRadiationTableStep' is expected between 0 and 60 min."), FUNC_ID);
+			m_radiationTableStep = tableStep.value;
+		}
+		m_climateDataSource = climateDataSource;
+
 		// store start time offset as year and start time
 		m_year = simPara.m_intPara[NANDRAD::SimulationParameter::IP_StartYear].value;
 		m_startTime = simPara.m_interval.m_para[NANDRAD::Interval::P_Start].value;
@@ -211,10 +231,29 @@ void Loads::setup(const NANDRAD::Location & location, const NANDRAD::SimulationP
 
 
 void Loads::initResults(const std::vector<AbstractModel*> & models) {
-//	FUNCID(Loads::initResults);
+	FUNCID(Loads::initResults);
 	// resize m_results vector from keyword list
 	DefaultModel::initResults(models);
 
+	// all surfaces are registered now, so we can compute the radiation table
+	if (m_radiationTableStep > 0) {
+		try {
+			if (m_climateDataSource != nullptr) {
+				// surfaces are registered in the same order as in the source model, hence we can share the table
+				m_solarRadiationModel.copyRadiationTable(m_climateDataSource->m_solarRadiationModel);
+			}
+			else {
+				IBK::StopWatch w;
+				m_solarRadiationModel.computeRadiationTable(m_radiationTableStep);
+				IBK::IBK_Message(IBK::FormatString("Solar radiation table with step size %1 min computed in %2 ms\n")
+								 .arg(m_radiationTableStep/60).arg(w.difference()), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
+			}
+		}
+		catch (IBK::Exception & ex) {
+			throw IBK::Exception(ex, "Error initializing solar radiation table.", FUNC_ID);
+		}
+	}
+
 	// transfer constant parameters - other models may access these values, but they are constant values and
 	// never updated during the simulation.
 	m_results[R_Albedo] = m_solarRadiationModel.m_albedo;
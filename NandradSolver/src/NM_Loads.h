@@ -98,9 +98,11 @@ public:
 		This function checks for parameters.
 		\param location Location data.
 		\param pathPlaceHolders Path placeholders to resolve path to climate data
+		\param climateDataSource If not nullptr, climate data is copied from this (already initialized) loads model
+			instead of being read from file. Also, the solar radiation table (if used) is copied in initResults().
 	*/
 	void setup(const NANDRAD::Location & location, const NANDRAD::SimulationParameter &simPara,
-				const std::map<std::string, IBK::Path> & pathPlaceHolders) ;
+				const std::map<std::string, IBK::Path> & pathPlaceHolders, const Loads * climateDataSource = nullptr);
 
 
 	// *** Re-implemented from AbstractModel
@@ -119,7 +121,9 @@ public:
 	*/
 	virtual void resultDescriptions(std::vector<QuantityDescription> & resDesc) const override;
 
-	/*! Resizes m_results vector. */
+	/*! Resizes m_results vector.
+		Also computes the solar radiation table if enabled, since at this time all surfaces have been registered.
+	*/
 	virtual void initResults(const std::vector<AbstractModel*> & /* models */) override;
 
 
@@ -182,6 +186,10 @@ private:
 	double									m_startTime = 0;
 	/*! Simulation time.*/
 	double									m_t = 0;
+	/*! Step size of solar radiation table in [s], 0 if radiation loads are computed exactly. */
+	double									m_radiationTableStep = 0;
+	/*! Loads model that climate data (and radiation table) are copied from, nullptr if data is read from file. */
+	const Loads								*m_climateDataSource = nullptr;
 
 	/*! The solar radiation model from CCM, includes the Climate data loader. */
 	CCM::SolarRadiationModel				m_solarRadiationModel;
@@ -26,11 +26,17 @@
 #endif // _OPENMP
 
 #include <memory>
+#include <limits>
+#include <cstdio>
 
 #include <IBK_Version.h>
 #include <IBK_messages.h>
+#include <IBK_MessageHandler.h>
+#include <IBK_MessageHandlerRegistry.h>
 #include <IBK_FormatString.h>
 #include <IBK_FileUtils.h>
+#include <IBK_InputOutput.h>
+#include <IBK_crypt.h>
 
 #include <CCM_Constants.h>
 
@@ -54,6 +60,7 @@
 #include <SOLFRA_LESKLU.h>
 #include <SOLFRA_PrecondILU.h>
 #include <SOLFRA_PrecondILUT.h>
+#include <SOLFRA_PrecondBlockJacobi.h>
 
 #ifdef IBK_STATISTICS
 #define NANDRAD_TIMER_TIMEDEPENDENT 11
@@ -85,9 +92,18 @@
 #include "NM_HydraulicNetworkModel.h"
 #include "NM_ThermalNetworkStatesModel.h"
 #include "NM_ThermalNetworkBalanceModel.h"
+#include "NM_ResultReferenceIndex.h"
 
 namespace NANDRAD_MODEL {
 
+/*! Version number of the binary data block created in NandradModel::serialize().
+	Increase whenever the layout of serialized data changes.
+*/
+const uint32_t SERIALIZATION_VERSION = 1;
+
+/*! Version number of init cache files written in NandradModel::writeInitCache(). */
+const uint32_t INIT_CACHE_VERSION = 2;
+
 NandradModel::NandradModel() :
 	m_project(new NANDRAD::Project)
 {
@@ -100,7 +116,11 @@ NandradModel::~NandradModel() {
 		m_outputHandler->flushCache();
 
 	// free memory of owned instances
-	delete m_project;
+	// replicas reference our project data, so delete them first
+	for (NandradModel * r : m_replicas)
+		delete r;
+	if (m_master == nullptr)
+		delete m_project;
 	delete m_lesSolver;
 	delete m_jacobian;
 	delete m_preconditioner;
@@ -178,45 +198,134 @@ void NandradModel::init(const NANDRAD::ArgsParser & args) {
 	IBK::IBK_Message( IBK::FormatString("Initializing model\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 	IBK_MSG_INDENT;
 
+	// durations of all initialization phases are collected and printed at the end
+	IBK::StopWatch phaseTimer;
+	m_initPhaseTimes.clear();
+
 	// *** Initialize solver parameters (and apply command line overrides) ***
 	initSolverParameter(args);
 	// *** Initialize simulation parameters ***
 	initSimulationParameter();
+	initPhaseCompleted("Parameters", phaseTimer);
 	// *** Initialize Climatic Loads ***
 	initClimateData();
+	initPhaseCompleted("Climate data", phaseTimer);
 	// *** Initialize Schedules ***
 	initSchedules();
+	initPhaseCompleted("Schedules", phaseTimer);
 	// *** Initialize RoomBalanceModels and ConstantZoneModels ***
 	initZones();
+	initPhaseCompleted("Zones", phaseTimer);
 	// *** Initialize Wall/Construction Modules ***
 	initWallsAndInterfaces();
+	initPhaseCompleted("Walls and interfaces", phaseTimer);
 	// *** Initialize Networks ***
 	initNetworks();
+	initPhaseCompleted("Networks", phaseTimer);
 	// *** Initialize ModelGroups ***
 //	initModelGroups();
 	// *** Initialize all internal fmus ***
 //	initFMUComponents();
 	// *** Initialize all models ***
 	initModels();
+	initPhaseCompleted("Models", phaseTimer);
 	// *** Initialize Object Lists ***
 	initObjectLists();
+	initPhaseCompleted("Object lists", phaseTimer);
 	// *** Initialize outputs ***
 	initOutputs(args.m_restart || args.m_restartFrom);
+	initPhaseCompleted("Outputs", phaseTimer);
 
 	// Here, *all* model objects must be created and stored in m_modelContainer !!!
 
+	// *** Setup init cache directory ***
+	m_initCacheDir = m_dirs.m_varDir;
+	if (args.IBK::ArgParser::hasOption("init-cache-dir")) {
+		m_initCacheDir = IBK::Path(args.IBK::ArgParser::option("init-cache-dir")).absolutePath();
+		if (!m_initCacheDir.exists() && !IBK::Path::makePath(m_initCacheDir))
+			throw IBK::Exception(IBK::FormatString("Cannot create init cache directory '%1'.").arg(m_initCacheDir), FUNC_ID);
+	}
+
 	// *** Setup model dependencies ***
-	initModelDependencies();
+	phaseTimer.start();
+	initModelDependencies(); // records its own phases
+	phaseTimer.start();
 	// *** Setup states model graph and generate model groups ***
 	initModelGraph();
+	initPhaseCompleted("Model graph", phaseTimer);
 	// *** Initialize list with output references ***
 	initOutputReferenceList();
+	initPhaseCompleted("Output reference list", phaseTimer);
 	// *** Initialize Global Solver ***
 	initSolverVariables();
+	initPhaseCompleted("Solver variables", phaseTimer);
 	// *** Initialize sparse solver matrix ***
 	initSolverMatrix();
+	initPhaseCompleted("Solver matrix", phaseTimer);
 	// *** Init statistics/feedback output ***
 	initStatistics(this, args.m_restart);
+	initPhaseCompleted("Statistics", phaseTimer);
+
+	// *** Print durations of initialization phases ***
+	IBK::IBK_Message( IBK::FormatString("Initialization times\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	{
+		IBK_MSG_INDENT;
+		double totalTime = 0;
+		for (unsigned int i=0; i<m_initPhaseTimes.size(); ++i) {
+			std::stringstream strm;
+			strm << std::setw(25) << std::left << m_initPhaseTimes[i].first;
+			IBK::IBK_Message( IBK::FormatString("%1 %2 ms\n").arg(strm.str()).arg(m_initPhaseTimes[i].second, 8, 'f', 0),
+							  IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+			totalTime += m_initPhaseTimes[i].second;
+		}
+		std::stringstream strm;
+		strm << std::setw(25) << std::left << "Total";
+		IBK::IBK_Message( IBK::FormatString("%1 %2 ms\n").arg(strm.str()).arg(totalTime, 8, 'f', 0),
+						  IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	}
+}
+
+
+void NandradModel::initReplica(const NandradModel & master) {
+	FUNCID(NandradModel::initReplica);
+
+	m_master = &master;
+	// share project data with master model
+	delete m_project;
+	m_project = master.m_project;
+	m_projectFilePath = master.m_projectFilePath;
+	m_dirs = master.m_dirs;
+
+	// replicas are evaluated concurrently within parallel regions, hence use serial code
+	m_numThreads = 1;
+
+	// initialization of a replica produces the same messages as that of the main model, so hide them
+	m_quiet = true;
+	try {
+		initSimulationParameter();
+		initClimateData();
+		initSchedules();
+		initZones();
+		initWallsAndInterfaces();
+		initNetworks();
+		initModels();
+		initModelDependencies();
+		initModelGraph();
+		initSolverVariables();
+	}
+	catch (IBK::Exception & ex) {
+		throw IBK::Exception(ex, "Error initializing model replica.", FUNC_ID);
+	}
+
+	if (m_n != master.m_n || m_modelContainer.size() > master.m_modelContainer.size())
+		throw IBK::Exception("Model replica does not match main model.", FUNC_ID);
+	m_y = master.m_y;
+}
+
+
+void NandradModel::initPhaseCompleted(const char * phaseName, IBK::StopWatch & phaseTimer) {
+	m_initPhaseTimes.push_back(std::make_pair(std::string(phaseName), phaseTimer.difference()));
+	phaseTimer.start();
 }
 
 
@@ -334,7 +443,9 @@ SOLFRA::ModelInterface::CalculationResult NandradModel::ydot(double * ydot) {
 		IBK_FastMessage(IBK::VL_DEVELOPER)(IBK::FormatString("    ydot: t=%1 [%2]\n")
 							.arg(m_t).arg(IBK::Time(2000,m_t).toTOYFormat()),
 							IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_DEVELOPER);
-		m_feedback.writeFeedbackFromF(m_t);
+		// feedback is only written by the main model, replicas may be evaluated concurrently
+		if (m_master == nullptr)
+			m_feedback.writeFeedbackFromF(m_t);
 	}
 	catch (IBK::Exception & ex) {
 		throw IBK::Exception(ex, "Error retrieving divergences!", FUNC_ID);
@@ -386,6 +497,9 @@ void NandradModel::stepCompleted(double t, const double * /*y*/ ) {
 	{
 		(*it)->stepCompleted(t);
 	}
+
+	// replicas are brought to the new state when requested for the next Jacobian evaluation
+	m_replicasOutdated = true;
 }
 
 
@@ -423,6 +537,7 @@ SOLFRA::LESInterface * NandradModel::lesInterface() {
 			SOLFRA::JacobianSparseCSR *jacSparse = new SOLFRA::JacobianSparseCSR(n(), nnz(), &m_ia[0], &m_ja[0],
 				&m_iaT[0], &m_jaT[0]);
 			m_jacobian = jacSparse;
+			initJacobianColors(jacSparse);
 			// create KLU solver
 			m_lesSolver = new SOLFRA::LESKLU;
 			IBK_Message(IBK::FormatString("Using generic KLU solver!\n"),
@@ -459,6 +574,7 @@ SOLFRA::LESInterface * NandradModel::lesInterface() {
 				&m_iaT[0], &m_jaT[0]);
 
 			m_jacobian = jacSparse;
+			initJacobianColors(jacSparse);
 
 			// ILUT preconditioner
 			if (!m_project->m_solverParameter.m_intPara[NANDRAD::SolverParameter::IP_PreILUWidth].name.empty()) {
@@ -475,6 +591,24 @@ SOLFRA::LESInterface * NandradModel::lesInterface() {
 			}
 		} break;
 
+		// Block-Jacobi preconditioner
+		case NANDRAD::SolverParameter::PRE_BlockJacobi : {
+			SOLFRA::JacobianSparseCSR *jacSparse = new SOLFRA::JacobianSparseCSR(n(), nnz(), &m_ia[0], &m_ja[0],
+				&m_iaT[0], &m_jaT[0]);
+
+			m_jacobian = jacSparse;
+			initJacobianColors(jacSparse);
+
+			// each zone, construction and network forms a block
+			std::vector<unsigned int> blockOffsets(m_zoneVariableOffset);
+			blockOffsets.insert(blockOffsets.end(), m_constructionVariableOffset.begin(), m_constructionVariableOffset.end());
+			blockOffsets.insert(blockOffsets.end(), m_networkVariableOffset.begin(), m_networkVariableOffset.end());
+			blockOffsets.push_back(m_n);
+
+			m_preconditioner = new SOLFRA::PrecondBlockJacobi(SOLFRA::PrecondInterface::Right, blockOffsets);
+			precondName = IBK::FormatString("Block-Jacobi preconditioner (%1 blocks)").arg(blockOffsets.size()-1).str();
+		} break;
+
 		// no preconditioner
 		case NANDRAD::SolverParameter::NUM_PRE : ;
 	}
@@ -584,19 +718,119 @@ bool NandradModel::hasErrorWeightsFunction() {
 
 
 std::size_t NandradModel::serializationSize() const {
-	// nothing to serialize
-	size_t s = 0;
+	// header: version number and total size
+	size_t s = sizeof(uint32_t) + sizeof(uint64_t);
+	// time point and solution variables
+	s += sizeof(double) + sizeof(uint32_t) + m_n*sizeof(double);
+	// time-dependent states of all models
+	for (const AbstractModel * m : m_modelContainer)
+		s += m->serializationSize();
 	return s;
 }
 
 
-void NandradModel::serialize(void* & /*dataPtr*/) const {
-	// nothing to serialize
+void NandradModel::serialize(void* & dataPtr) const {
+	*(uint32_t*)dataPtr = SERIALIZATION_VERSION;
+	dataPtr = (char*)dataPtr + sizeof(uint32_t);
+	*(uint64_t*)dataPtr = (uint64_t)serializationSize();
+	dataPtr = (char*)dataPtr + sizeof(uint64_t);
+
+	*(double*)dataPtr = m_t;
+	dataPtr = (char*)dataPtr + sizeof(double);
+	*(uint32_t*)dataPtr = (uint32_t)m_n;
+	dataPtr = (char*)dataPtr + sizeof(uint32_t);
+	std::memcpy(dataPtr, &m_y[0], m_n*sizeof(double));
+	dataPtr = (char*)dataPtr + m_n*sizeof(double);
+
+	// models serialize in order of the model container, which is fixed after initialization
+	for (const AbstractModel * m : m_modelContainer)
+		m->serialize(dataPtr);
+}
+
+
+void NandradModel::deserialize(void* & dataPtr) {
+	FUNCID(NandradModel::deserialize);
+
+	uint32_t version = *(uint32_t*)dataPtr;
+	dataPtr = (char*)dataPtr + sizeof(uint32_t);
+	if (version != SERIALIZATION_VERSION)
+		throw IBK::Exception(IBK::FormatString("Invalid/unsupported version %1 of serialized model data (expected %2).")
+							 .arg(version).arg(SERIALIZATION_VERSION), FUNC_ID);
+	uint64_t dataSize = *(uint64_t*)dataPtr;
+	dataPtr = (char*)dataPtr + sizeof(uint64_t);
+	if (dataSize != (uint64_t)serializationSize())
+		throw IBK::Exception("Size of serialized model data does not match model (different project?).", FUNC_ID);
+
+	m_t = *(double*)dataPtr;
+	dataPtr = (char*)dataPtr + sizeof(double);
+	unsigned int n = *(uint32_t*)dataPtr;
+	dataPtr = (char*)dataPtr + sizeof(uint32_t);
+	if (n != m_n)
+		throw IBK::Exception("Number of unknowns in serialized model data does not match model.", FUNC_ID);
+	std::memcpy(&m_y[0], dataPtr, m_n*sizeof(double));
+	dataPtr = (char*)dataPtr + m_n*sizeof(double);
+
+	for (AbstractModel * m : m_modelContainer)
+		m->deserialize(dataPtr);
+
+	// all time- and state-dependent results must be recomputed on next call to ydot()
+	m_tChanged = true;
+	m_yChanged = true;
+
+	m_replicasOutdated = true;
 }
 
 
-void NandradModel::deserialize(void* & /*dataPtr*/) {
-	// nothing to serialize
+unsigned int NandradModel::nReplicas() const {
+	// small problems are evaluated with serial code, for these the threading overhead outweighs the gain
+	if (m_master != nullptr || m_useSerialCode)
+		return 0;
+	return (unsigned int)m_numThreads - 1;
+}
+
+
+SOLFRA::ModelInterface * NandradModel::replica(unsigned int i) {
+	FUNCID(NandradModel::replica);
+	if (i >= nReplicas())
+		return nullptr;
+	// create missing replicas
+	while (m_replicas.size() <= i) {
+		IBK::IBK_Message(IBK::FormatString("Creating model replica #%1\n").arg((unsigned int)m_replicas.size()+1),
+						 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		NandradModel * r = new NandradModel;
+		m_replicas.push_back(r); // transfer ownership
+		r->initReplica(*this);
+		m_replicasOutdated = true;
+	}
+	// bring replicas to our time-dependent state
+	updateReplicas();
+	return m_replicas[i];
+}
+
+
+void NandradModel::updateReplicas() {
+	if (m_replicas.empty() || !m_replicasOutdated)
+		return;
+
+	// replicas hold the same models in the same order as we do, except for the output files which
+	// are appended at the end of our model container
+	const unsigned int nModels = (unsigned int)m_replicas.front()->m_modelContainer.size();
+	std::size_t s = 0;
+	for (unsigned int i=0; i<nModels; ++i)
+		s += m_modelContainer[i]->serializationSize();
+	m_replicaStateBuffer.resize(s);
+	void * dataPtr = m_replicaStateBuffer.data();
+	for (unsigned int i=0; i<nModels; ++i)
+		m_modelContainer[i]->serialize(dataPtr);
+
+	for (NandradModel * r : m_replicas) {
+		dataPtr = m_replicaStateBuffer.data();
+		for (unsigned int i=0; i<nModels; ++i)
+			r->m_modelContainer[i]->deserialize(dataPtr);
+		r->m_tChanged = true;
+		r->m_yChanged = true;
+	}
+	m_replicasOutdated = false;
 }
 
 
@@ -656,6 +890,41 @@ void NandradModel::writeMetrics(double simtime, std::ostream * metricsFile) {
 		.arg(m_nYdotCalls, 8),
 		IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 #endif
+
+#ifdef _OPENMP
+	if (!m_useSerialCode && m_stateDependencyScheduler.statistics().m_evaluations > 0) {
+		FUNCID(NandradModel::writeMetrics);
+		const StateDependencyScheduler::Statistics & stats = m_stateDependencyScheduler.statistics();
+		double nEvals = stats.m_evaluations;
+		IBK::IBK_Message(IBK::FormatString("Nandrad model: State model graph per call  = %1 us\n")
+			.arg(stats.m_wallTime / nEvals * 1e6, 13, 'f', 2),
+			IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+#ifdef IBK_STATISTICS
+		IBK::IBK_Message(IBK::FormatString("Nandrad model: Critical path per call      = %1 us (%2 %%)\n")
+			.arg(stats.m_criticalPathTime / nEvals * 1e6, 13, 'f', 2)
+			.arg(stats.m_wallTime > 0 ? stats.m_criticalPathTime / stats.m_wallTime * 100 : 0.0, 5, 'f', 2),
+			IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		IBK::IBK_Message(IBK::FormatString("Nandrad model: Thread idle time per call   = %1 us (%2 %%)\n")
+			.arg(stats.m_idleTime / nEvals * 1e6, 13, 'f', 2)
+			.arg(stats.m_wallTime > 0 ? stats.m_idleTime / (stats.m_wallTime * m_numThreads) * 100 : 0.0, 5, 'f', 2),
+			IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+#endif // IBK_STATISTICS
+	}
+#endif // _OPENMP
+
+	for (const HydraulicNetworkModel * nwmodel : m_hydraulicNetworkModelContainer) {
+		FUNCID(NandradModel::writeMetrics);
+		const HydraulicNetworkModel::Statistics & stats = nwmodel->statistics();
+		IBK::IBK_Message(IBK::FormatString("Hydraulic network #%1: Newton iterations   = %2  (%3 solver calls)\n")
+			.arg(nwmodel->id()).arg(stats.m_newtonIterations, 8).arg(stats.m_solverCalls),
+			IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		IBK::IBK_Message(IBK::FormatString("Hydraulic network #%1: Jacobian updates    = %2\n")
+			.arg(nwmodel->id()).arg(stats.m_jacobianUpdates, 8),
+			IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		IBK::IBK_Message(IBK::FormatString("Hydraulic network #%1: Factorizations      = %2  (%3 refactorizations)\n")
+			.arg(nwmodel->id()).arg(stats.m_factorizations, 8).arg(stats.m_refactorizations),
+			IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	}
 }
 
 
@@ -768,6 +1037,9 @@ void NandradModel::initSolverParameter(const NANDRAD::ArgsParser & args) {
 					NANDRAD::KeywordList::Keyword("SolverParameter::intPara_t", NANDRAD::SolverParameter::IP_PreILUWidth),
 					(int)args.m_preconditionerOption);
 		}
+		else if (IBK::toupper_string(args.m_preconditionerName) == "BLOCKJACOBI") {
+			solverParameter.m_preconditioner = NANDRAD::SolverParameter::PRE_BlockJacobi;
+		}
 		else {
 			throw IBK::Exception( IBK::FormatString("Unknown/unsupported preconditioner '%1'.").arg(args.m_preconditionerName), FUNC_ID);
 		}
@@ -843,7 +1115,8 @@ void NandradModel::initSolverParameter(const NANDRAD::ArgsParser & args) {
 void NandradModel::initSimulationParameter() {
 	FUNCID(NandradModel::initSimulationParameter);
 
-	IBK::IBK_Message( IBK::FormatString("Initializing Simulation Parameter\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	if (!m_quiet)
+		IBK::IBK_Message( IBK::FormatString("Initializing Simulation Parameter\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 
 	const NANDRAD::SimulationParameter &simPara = m_project->m_simulationParameter;
 
@@ -868,8 +1141,9 @@ void NandradModel::initSimulationParameter() {
 void NandradModel::initClimateData() {
 	FUNCID(NandradModel::initClimateData);
 
-	IBK::IBK_Message(IBK::FormatString("Initializing Climatic Data\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-	IBK_MSG_INDENT;
+	if (!m_quiet)
+		IBK::IBK_Message(IBK::FormatString("Initializing Climatic Data\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	IBK::MessageIndentor indent(!m_quiet); (void)indent;
 
 	try {
 		m_loads = new Loads;
@@ -878,7 +1152,9 @@ void NandradModel::initClimateData() {
 		// insert into time model container
 		m_timeModelContainer.push_back(m_loads);
 
-		m_loads->setup(m_project->m_location, m_project->m_simulationParameter, m_project->m_placeholders);
+		// replicas copy the climate data of the main model
+		m_loads->setup(m_project->m_location, m_project->m_simulationParameter, m_project->m_placeholders,
+					   m_master != nullptr ? m_master->m_loads : nullptr);
 	}
 	catch (IBK::Exception & ex) {
 		throw IBK::Exception(ex, IBK::FormatString("Error initializing climatic loads model."), FUNC_ID);
@@ -888,8 +1164,9 @@ void NandradModel::initClimateData() {
 
 void NandradModel::initSchedules() {
 	FUNCID(NandradModel::initSchedules);
-	IBK::IBK_Message(IBK::FormatString("Initializing Schedules\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-	IBK_MSG_INDENT;
+	if (!m_quiet)
+		IBK::IBK_Message(IBK::FormatString("Initializing Schedules\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	IBK::MessageIndentor indent(!m_quiet); (void)indent;
 
 	try {
 		m_schedules = new Schedules; // owned, memory released in destructor
@@ -932,8 +1209,9 @@ void NandradModel::initFMI() {
 
 void NandradModel::initZones() {
 	FUNCID(NandradModel::initZones);
-	IBK::IBK_Message( IBK::FormatString("Initializing Zones\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-	IBK_MSG_INDENT;
+	if (!m_quiet)
+		IBK::IBK_Message( IBK::FormatString("Initializing Zones\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	IBK::MessageIndentor indent(!m_quiet); (void)indent;
 
 	// create model instances for all active zones
 	// for each active zone, we need:
@@ -951,10 +1229,12 @@ void NandradModel::initZones() {
 	for (const NANDRAD::Zone & zone : m_project->m_zones) {
 
 
-		IBK::IBK_Message( IBK::FormatString("Zone [%1] '%2':").arg(zone.m_id).arg(zone.m_displayName), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
+		if (!m_quiet)
+			IBK::IBK_Message( IBK::FormatString("Zone [%1] '%2':").arg(zone.m_id).arg(zone.m_displayName), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
 		switch (zone.m_type) {
 			case NANDRAD::Zone::ZT_Active : {
-				IBK::IBK_Message( IBK::FormatString(" ACTIVE\n").arg(zone.m_id).arg(zone.m_displayName), IBK::MSG_CONTINUED, FUNC_ID, IBK::VL_INFO);
+				if (!m_quiet)
+					IBK::IBK_Message( IBK::FormatString(" ACTIVE\n").arg(zone.m_id).arg(zone.m_displayName), IBK::MSG_CONTINUED, FUNC_ID, IBK::VL_INFO);
 
 				// create implicit room state and room balance models
 				RoomStatesModel * roomStatesModel = new RoomStatesModel(zone.m_id, zone.m_displayName);
@@ -1041,14 +1321,16 @@ void NandradModel::initZones() {
 	} // for (Zones)
 
 	m_nZones = (unsigned int) m_roomBalanceModelContainer.size();
-	IBK::IBK_Message( IBK::FormatString("%1 active zones.\n").arg(m_nZones), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
+	if (!m_quiet)
+		IBK::IBK_Message( IBK::FormatString("%1 active zones.\n").arg(m_nZones), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
 }
 
 
 void NandradModel::initWallsAndInterfaces() {
 	FUNCID(NandradModel::initWallsAndInterfaces);
-	IBK::IBK_Message( IBK::FormatString("Initializing Constructions and Interfaces\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-	IBK_MSG_INDENT;
+	if (!m_quiet)
+		IBK::IBK_Message( IBK::FormatString("Initializing Constructions and Interfaces\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	IBK::MessageIndentor indent(!m_quiet); (void)indent;
 
 	// *** check databases used by construction instances ***
 
@@ -1138,9 +1420,10 @@ void NandradModel::initWallsAndInterfaces() {
 			// For now, we simply check if either side has boundary conditions assigned and issue a warning if no boundary
 			// conditions are present.
 			if (!ci.m_interfaceA.haveBCParameters() && !ci.m_interfaceB.haveBCParameters()) {
-				IBK::IBK_Message("Construction instance #%1 '%2' does not have boundary conditions on either side. To "
-								 "improve performance, this construction instance should be removed, unless it is "
-								 "otherwise needed.", IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+				if (!m_quiet)
+					IBK::IBK_Message("Construction instance #%1 '%2' does not have boundary conditions on either side. To "
+									 "improve performance, this construction instance should be removed, unless it is "
+									 "otherwise needed.", IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
 			}
 
 			// *** construction states model ***
@@ -1148,9 +1431,10 @@ void NandradModel::initWallsAndInterfaces() {
 			ConstructionStatesModel * statesModel = new ConstructionStatesModel(ci.m_id, ci.m_displayName);
 			m_modelContainer.push_back(statesModel); // transfer ownership
 
-			IBK::IBK_Message(IBK::FormatString("Initializating construction model (id=%1)\n").arg(ci.m_id),
-							 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
-			IBK_MSG_INDENT;
+			if (!m_quiet)
+				IBK::IBK_Message(IBK::FormatString("Initializating construction model (id=%1)\n").arg(ci.m_id),
+								 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
+			IBK::MessageIndentor indent(!m_quiet); (void)indent;
 			// does the entire initialization
 			statesModel->setup(ci, m_project->m_simulationParameter, m_project->m_solverParameter, *m_loads);
 
@@ -1205,20 +1489,23 @@ void NandradModel::initWallsAndInterfaces() {
 
 	}
 	m_nWalls = (unsigned int) m_constructionBalanceModelContainer.size();
-	IBK::IBK_Message( IBK::FormatString("%1 construction models.\n").arg(m_nZones), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
+	if (!m_quiet)
+		IBK::IBK_Message( IBK::FormatString("%1 construction models.\n").arg(m_nZones), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
 
 }
 
 
 void NandradModel::initModels() {
 	FUNCID(NandradModel::initModels);
-	IBK::IBK_Message(IBK::FormatString("Initializing Models\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-	IBK_MSG_INDENT;
+	if (!m_quiet)
+		IBK::IBK_Message(IBK::FormatString("Initializing Models\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	IBK::MessageIndentor indent(!m_quiet); (void)indent;
 
 	// natural ventilation
 	if (!m_project->m_models.m_naturalVentilationModels.empty()) {
-		IBK::IBK_Message(IBK::FormatString("Initializing natural ventilation models\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-		IBK_MSG_INDENT;
+		if (!m_quiet)
+			IBK::IBK_Message(IBK::FormatString("Initializing natural ventilation models\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		IBK::MessageIndentor indent(!m_quiet); (void)indent;
 
 		for (const NANDRAD::NaturalVentilationModel & m : m_project->m_models.m_naturalVentilationModels) {
 			NANDRAD_MODEL::NaturalVentilationModel * mod = new NANDRAD_MODEL::NaturalVentilationModel(m.m_id, m.m_displayName);
@@ -1247,8 +1534,9 @@ void NandradModel::initModels() {
 			}
 		}
 
-		IBK::IBK_Message(IBK::FormatString("Initializing internal loads models\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-		IBK_MSG_INDENT;
+		if (!m_quiet)
+			IBK::IBK_Message(IBK::FormatString("Initializing internal loads models\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		IBK::MessageIndentor indent(!m_quiet); (void)indent;
 
 		for (const NANDRAD::InternalLoadsModel & m : m_project->m_models.m_internalLoadsModels) {
 			NANDRAD_MODEL::InternalLoadsModel * mod = new NANDRAD_MODEL::InternalLoadsModel(m.m_id, m.m_displayName);
@@ -1366,13 +1654,15 @@ void NandradModel::initObjectLists() {
 void NandradModel::initNetworks() {
 	if (!m_project->m_hydraulicNetworks.empty()) {
 		FUNCID(NandradModel::initNetworks);
-		IBK::IBK_Message(IBK::FormatString("Initializing Networks\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-		IBK_MSG_INDENT;
+		if (!m_quiet)
+			IBK::IBK_Message(IBK::FormatString("Initializing Networks\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		IBK::MessageIndentor indent(!m_quiet); (void)indent;
 		// process all networks and create NM::HydraulicNetworkModel instances
 		for (NANDRAD::HydraulicNetwork & nw : m_project->m_hydraulicNetworks) {
-			IBK::IBK_Message(IBK::FormatString("Initializing network '%1' (#%2)\n").arg(nw.m_displayName).arg(nw.m_id),
-							 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-			IBK_MSG_INDENT;
+			if (!m_quiet)
+				IBK::IBK_Message(IBK::FormatString("Initializing network '%1' (#%2)\n").arg(nw.m_displayName).arg(nw.m_id),
+								 IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+			IBK::MessageIndentor indent(!m_quiet); (void)indent;
 			// check network parameters
 			try {
 				nw.checkParameters(m_project->m_placeholders, m_project->m_zones, m_project->m_constructionInstances);
@@ -1384,6 +1674,7 @@ void NandradModel::initNetworks() {
 			// create a network model object
 			HydraulicNetworkModel * nwmodel = new HydraulicNetworkModel(nw, nw.m_id, nw.m_displayName);
 			m_modelContainer.push_back(nwmodel); // transfer ownership
+			m_hydraulicNetworkModelContainer.push_back(nwmodel);
 			// initialize
 			nwmodel->setup();
 			// register model for evaluation
@@ -1454,18 +1745,20 @@ void NandradModel::initModelDependencies() {
 	// *** complete initialization for all models ***
 
 	IBK::StopWatch timer;
+	IBK::StopWatch phaseTimer;
 
 	// *** initializing model results ***
 
-	IBK::IBK_Message(IBK::FormatString("Initializing all model results\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-	std::unique_ptr<IBK::MessageIndentor> indent(new IBK::MessageIndentor);
+	if (!m_quiet)
+		IBK::IBK_Message(IBK::FormatString("Initializing all model results\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	std::unique_ptr<IBK::MessageIndentor> indent(new IBK::MessageIndentor(!m_quiet));
 
 	// The key is of type QuantityDescription, a simply class that identifies a variable based on reference type and id
 	// (both addressing an object) and variable name (identifying the variable of the object).
-	// The map can be used to quickly find the object the holds a required result variable.
+	// The index can be used to quickly find the object the holds a required result variable.
 	// It maps QuantityDescription (i.e. global identification of a result variable) to the object that provides this variable.
 	// Note: the object's reference type must not necessarily match the reference type stored in the QuantityDescription.
-	std::map<QuantityDescription, AbstractModel*> modelResultReferences;
+	ResultReferenceIndex modelResultReferences;
 
 	// prepare for parallelization - get number of threads and prepare thread-storage vectors
 #if defined(_OPENMP)
@@ -1486,7 +1779,7 @@ void NandradModel::initModelDependencies() {
 #else
 		{
 #endif
-			if (timer.intervalCompleted()) // side-effect guarded by _OPENMP ifdef
+			if (timer.intervalCompleted() && !m_quiet) // side-effect guarded by _OPENMP ifdef
 				IBK::IBK_Message(IBK::FormatString("  Loop 1: %1 %% done\n").arg(i*100.0 / m_modelContainer.size()), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 		} // end master section
 
@@ -1513,9 +1806,10 @@ void NandradModel::initModelDependencies() {
 				}
 
 #if !defined(_OPENMP)
-				IBK_FastMessage(IBK::VL_DETAILED)(IBK::FormatString("%1(id=%2).%3 [%4]\n")
-												  .arg(NANDRAD::KeywordList::Keyword("ModelInputReference::referenceType_t",resRef.m_referenceType))
-												  .arg(resRef.m_id).arg(resRef.m_name).arg(resRef.m_unit), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_DETAILED);
+				if (!m_quiet)
+					IBK_FastMessage(IBK::VL_DETAILED)(IBK::FormatString("%1(id=%2).%3 [%4]\n")
+													  .arg(NANDRAD::KeywordList::Keyword("ModelInputReference::referenceType_t",resRef.m_referenceType))
+													  .arg(resRef.m_id).arg(resRef.m_name).arg(resRef.m_unit), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_DETAILED);
 #endif
 
 #if defined(_OPENMP)
@@ -1524,10 +1818,9 @@ void NandradModel::initModelDependencies() {
 #else
 				// ensure that this variable is not yet existing in our map, this would be a programming
 				// error, since global uniqueness would not be guaranteed
-				IBK_ASSERT(modelResultReferences.find(resRef) == modelResultReferences.end());
-
-				// single-core run, store directly in map
-				modelResultReferences[resRef] = currentModel;
+				bool inserted = modelResultReferences.insert(resRef, currentModel); // single-core run, store directly in index
+				IBK_ASSERT(inserted);
+				(void)inserted;
 #endif
 			}
 		}
@@ -1555,45 +1848,58 @@ void NandradModel::initModelDependencies() {
 			throw IBK::Exception(threadErrors[i], FUNC_ID);
 		}
 
-	// merge thread-specific vectors into global map
+	// merge thread-specific vectors into global index
+	unsigned int resultCount = 0;
+	for (unsigned int i=0; i<(unsigned int)m_numThreads; ++i)
+		resultCount += modelResultReferencesVec[i].size();
+	modelResultReferences.reserve(resultCount);
 	for (unsigned int i=0; i<(unsigned int)m_numThreads; ++i) {
-		IBK::IBK_Message(IBK::FormatString("  Loop 1: merging %1 model result references from thread #%2\n")
-						 .arg(modelResultReferencesVec[i].size()).arg(i), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		if (!m_quiet)
+			IBK::IBK_Message(IBK::FormatString("  Loop 1: merging %1 model result references from thread #%2\n")
+							 .arg(modelResultReferencesVec[i].size()).arg(i), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 		for (unsigned int j=0; j<modelResultReferencesVec[i].size(); ++j)
-			modelResultReferences[ modelResultReferencesVec[i][j].first] = modelResultReferencesVec[i][j].second;
+			modelResultReferences.insert(modelResultReferencesVec[i][j].first, modelResultReferencesVec[i][j].second);
 	}
 #endif
+	if (!m_quiet)
+		IBK::IBK_Message(IBK::FormatString("%1 model results with %2 distinct quantity names\n")
+						 .arg(modelResultReferences.size()).arg(modelResultReferences.nameCount()), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	initPhaseCompleted("Model results", phaseTimer);
 
 	// *** check for ambiguities in vector-valued model results
 
-	std::map<std::string, std::set<unsigned int> > vectorValuedModelResults;
-	for (auto refDesc : modelResultReferences) {
+	// sets of ids, index is interned quantity name
+	std::vector<std::set<unsigned int> > vectorValuedModelResults(modelResultReferences.nameCount());
+	for (unsigned int i=0; i<modelResultReferences.size(); ++i) {
+		const QuantityDescription & resDesc = modelResultReferences.quantity(i);
 		// we only check model results (because they can have vector valued results that
 		// may have ambiguous ids - since users may define model parameter blocks
 		// with overlapping object lists
-		if (refDesc.first.m_referenceType != NANDRAD::ModelInputReference::MRT_MODEL)
+		if (resDesc.m_referenceType != NANDRAD::ModelInputReference::MRT_MODEL)
 			continue;
 		// only process vector-valued results with indexes of type ModelID
-		if (refDesc.first.m_indexKeyType != VectorValuedQuantityIndex::IK_ModelID)
+		if (resDesc.m_indexKeyType != VectorValuedQuantityIndex::IK_ModelID)
 			continue;
-		std::set<unsigned int> & idSet = vectorValuedModelResults[refDesc.first.m_name];
-		for (unsigned int id : refDesc.first.m_indexKeys) {
+		std::set<unsigned int> & idSet = vectorValuedModelResults[modelResultReferences.nameIndex(i)];
+		for (unsigned int id : resDesc.m_indexKeys) {
 			// check for existance of ID, and add if not yet existing
 			if (idSet.find(id) != idSet.end())
 				throw IBK::Exception(IBK::FormatString("Ambiguous model parametrization block for model with id=%1 resulting "
 													   "from two (overlapping) objects lists which reference the same object "
 													   "(results for object with ID %2 are generated twice).")
-									 .arg(refDesc.first.m_id).arg(id), FUNC_ID);
+									 .arg(resDesc.m_id).arg(id), FUNC_ID);
 			idSet.insert(id);
 		}
 	}
+	initPhaseCompleted("Result ambiguity check", phaseTimer);
 
 
 	// *** initializing model input references ***
 
 	delete indent.release();
-	IBK::IBK_Message(IBK::FormatString("Initializing all model input references\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-	indent.reset(new IBK::MessageIndentor);
+	if (!m_quiet)
+		IBK::IBK_Message(IBK::FormatString("Initializing all model input references\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	indent.reset(new IBK::MessageIndentor(!m_quiet));
 
 #if defined(_OPENMP)
 #pragma omp parallel for schedule(static,200)
@@ -1605,7 +1911,7 @@ void NandradModel::initModelDependencies() {
 #else
 		{
 #endif
-			if (timer.intervalCompleted()) // side-effect guarded by _OPENMP ifdef
+			if (timer.intervalCompleted() && !m_quiet) // side-effect guarded by _OPENMP ifdef
 				IBK::IBK_Message(IBK::FormatString("  Loop 2: %1 %% done\n").arg(i*100.0 / m_modelContainer.size()), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 		} // end master section
 
@@ -1651,7 +1957,9 @@ void NandradModel::initModelDependencies() {
 				// may generate a variable Zone[13].AirTemperature and thus override the air temperature
 				// variable generated by the zone model (instance with id=13) itself. All models using this
 				// temperature will use the variable from the FMI import model, instead.
-				srcVarAddress = m_fmiInputOutput->resolveResultReference(inputRef, quantityDesc);
+				// Note: the FMI interface model is only created by initFMI(), not for model replicas.
+				if (m_fmiInputOutput != nullptr)
+					srcVarAddress = m_fmiInputOutput->resolveResultReference(inputRef, quantityDesc);
 
 
 				std::string lookupErrorMessage;
@@ -1659,16 +1967,11 @@ void NandradModel::initModelDependencies() {
 				if (srcVarAddress == nullptr) {
 					// compose search key - for vector valued quantities we ignore the index in ValueReference,
 					// since we only want to find the object that actually provides the *variable*
-					QuantityDescription valueRef;
-					valueRef.m_id = inputRef.m_id;
-					valueRef.m_referenceType = inputRef.m_referenceType;
-					valueRef.m_name = inputRef.m_name.m_name;
-
-					std::map<QuantityDescription, AbstractModel*>::const_iterator it = modelResultReferences.find(valueRef);
-					if (it != modelResultReferences.end()) {
+					int resIdx = modelResultReferences.find(inputRef.m_referenceType, inputRef.m_id, inputRef.m_name.m_name);
+					if (resIdx != -1) {
 						// remember source object's pointer, to create the dependency graph afterwards
-						srcObject = it->second;
-						quantityDesc = it->first;
+						srcObject = modelResultReferences.model((unsigned int)resIdx);
+						quantityDesc = modelResultReferences.quantity((unsigned int)resIdx);
 						// request the address to the requested variable from the source object
 						try {
 							srcVarAddress = srcObject->resultValueRef(inputRef);
@@ -1678,8 +1981,8 @@ void NandradModel::initModelDependencies() {
 							// in case of error, simply cache a warning to be used in the error message if this variable
 							// is required
 							lookupErrorMessage = IBK::FormatString("Error resolving variable reference %1(id=%2).%3. %4")
-								.arg(NANDRAD::KeywordList::Keyword("ModelInputReference::referenceType_t",valueRef.m_referenceType))
-								.arg(valueRef.m_id).arg(inputRef.m_name.encodedString()).arg(ex.what()).str();
+								.arg(NANDRAD::KeywordList::Keyword("ModelInputReference::referenceType_t",inputRef.m_referenceType))
+								.arg(inputRef.m_id).arg(inputRef.m_name.encodedString()).arg(ex.what()).str();
 						}
 					}
 				}
@@ -1768,12 +2071,8 @@ void NandradModel::initModelDependencies() {
 		if (!threadErrors[i].empty()) {
 			throw IBK::Exception(threadErrors[i], FUNC_ID);
 		}
-
-	for (unsigned int i=0; i<(unsigned int)m_numThreads; ++i) {
-		for (unsigned int j=0; j<modelInputReferencesVec[i].size(); ++j)
-			modelInputReferences[ modelInputReferencesVec[i][j].first] = modelInputReferencesVec[i][j].second;
-	}
 #endif
+	initPhaseCompleted("Input references", phaseTimer);
 
 	// set backward connections for all objects before initializing model graph
 	// we will need parents for identifying single sequential connections
@@ -1787,6 +2086,7 @@ void NandradModel::initModelDependencies() {
 
 		currentStateDependency->updateParents();
 	}
+	initPhaseCompleted("Model graph parents", phaseTimer);
 
 
 	// now all model objects have pointers to their input variables stored and can access these variable values
@@ -1812,8 +2112,9 @@ void NandradModel::initModelGraph() {
 
 	// *** create state dependency graph ***
 
-	IBK::IBK_Message(IBK::FormatString("Creating Dependency Graph for %1 State-Dependent Models\n").arg((int)
-		m_unorderedStateDependencies.size()), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	if (!m_quiet)
+		IBK::IBK_Message(IBK::FormatString("Creating Dependency Graph for %1 State-Dependent Models\n").arg((int)
+			m_unorderedStateDependencies.size()), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 
 	try {
 		std::vector<ZEPPELIN::DependencyObject*> stateDepObjects(m_unorderedStateDependencies.begin(),
@@ -1981,8 +2282,9 @@ void NandradModel::initOutputReferenceList() {
 
 void NandradModel::initSolverVariables() {
 	FUNCID(NandradModel::initSolverVariables);
-	IBK::IBK_Message( IBK::FormatString("Initializing Solver Variables\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
-	IBK_MSG_INDENT;
+	if (!m_quiet)
+		IBK::IBK_Message( IBK::FormatString("Initializing Solver Variables\n"), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	IBK::MessageIndentor indent(!m_quiet); (void)indent;
 
 	// In this function the number of conserved variables is calculated (summing up states in zones and constructions)
 	// and linear memory arrays for y, y0 and ydot are created.
@@ -2018,6 +2320,17 @@ void NandradModel::initSolverVariables() {
 		m_n += nUnknowns;
 	}
 
+	// *** collect element data of all constructions in element pool ***
+
+	m_constructionElementPool.clear();
+	for (unsigned int i=0; i<m_nWalls; ++i)
+		m_constructionStatesModelContainer[i]->registerElementPool(m_constructionElementPool, m_constructionVariableOffset[i]);
+	m_constructionElementPool.setup();
+	if (m_constructionElementPool.constructionCount() != 0 && !m_quiet)
+		IBK::IBK_Message(IBK::FormatString("Using %1 kernel for %2 constructions\n")
+			.arg(ConstructionElementPool::instructionSet()).arg(m_constructionElementPool.constructionCount()),
+			IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
+
 	// *** count number of unknowns in thermal networks and initialize wall offsets ***
 
 	// m_n counts the number of unknowns
@@ -2084,16 +2397,113 @@ void NandradModel::initSolverVariables() {
 
 	// *** Select serial code for small problem sizes ***
 
-	IBK::IBK_Message( IBK::FormatString("%1 unknowns\n").arg(m_n), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	if (!m_quiet)
+		IBK::IBK_Message( IBK::FormatString("%1 unknowns\n").arg(m_n), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 
 	if (m_numThreads > 1 && m_n > 1000) {
 		m_useSerialCode = false;
 	}
 	else {
-		if (m_numThreads > 1)
+		if (m_numThreads > 1 && !m_quiet)
 			IBK::IBK_Message(IBK::FormatString("Only %1 unknowns, using serial code in model evaluation!\n").arg(m_n), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 		m_useSerialCode = true;
 	}
+
+	// *** Partition ydot assembly among threads ***
+
+	if (!m_useSerialCode) {
+		// collect start offsets of all balance models, these are sorted in increasing order
+		std::vector<unsigned int> balanceModelOffsets(m_zoneVariableOffset);
+		balanceModelOffsets.insert(balanceModelOffsets.end(), m_constructionVariableOffset.begin(), m_constructionVariableOffset.end());
+		balanceModelOffsets.insert(balanceModelOffsets.end(), m_networkVariableOffset.begin(), m_networkVariableOffset.end());
+		unsigned int nBalanceModels = (unsigned int)balanceModelOffsets.size();
+
+		// one partition per thread, each a contiguous range of balance models with approximately m_n/m_numThreads unknowns
+		m_ydotPartition.resize((unsigned int)m_numThreads + 1, nBalanceModels);
+		m_ydotPartition[0] = 0;
+		unsigned int modelIdx = 0;
+		for (unsigned int t=1; t<(unsigned int)m_numThreads; ++t) {
+			unsigned int targetOffset = (unsigned int)((double)m_n*t/m_numThreads);
+			while (modelIdx < nBalanceModels && balanceModelOffsets[modelIdx] < targetOffset)
+				++modelIdx;
+			m_ydotPartition[t] = modelIdx;
+		}
+
+		// *** Setup task graph for state dependent models ***
+		initStateDependencyScheduler();
+	}
+}
+
+
+void NandradModel::initStateDependencyScheduler() {
+	FUNCID(NandradModel::initStateDependencyScheduler);
+
+	m_stateDependencyScheduler.clear();
+
+	// tasks of the previous section that must be finished before the next section starts
+	std::vector<unsigned int> sectionTasks;
+	// index of barrier task that separates sections, -1 if no barrier exists yet
+	int barrierIdx = -1;
+
+	// head and tail models have fixed evaluation priorities, so we keep strict level ordering
+	// by inserting a barrier task after each level
+	const unsigned int nHead = (unsigned int)m_orderedStateDependentSubModelsHead.size();
+	const unsigned int nTail = (unsigned int)m_orderedStateDependentSubModelsTail.size();
+	const unsigned int nLevels = (unsigned int)m_orderedStateDependentSubModels.size();
+	IBK_ASSERT(nLevels >= nHead + nTail);
+
+	// maps models in dependency graph to the index of the task that evaluates them
+	std::map<const AbstractStateDependency*, unsigned int> modelTaskMap;
+
+	for (unsigned int k = 0; k < nLevels; ++k) {
+		const ParallelStateObjects & parallelObjects = m_orderedStateDependentSubModels[k];
+		bool graphLevel = (k >= nHead && k < nLevels - nTail);
+
+		for (unsigned int i = 0; i < parallelObjects.size(); ++i) {
+			unsigned int taskIdx = m_stateDependencyScheduler.addTask(parallelObjects[i]);
+			if (barrierIdx != -1)
+				m_stateDependencyScheduler.addDependency(taskIdx, (unsigned int)barrierIdx);
+			sectionTasks.push_back(taskIdx);
+
+			if (!graphLevel)
+				continue;
+
+			// the dependency graph contains only model groups, each model is part of exactly one group
+			const StateModelGroup * group = dynamic_cast<const StateModelGroup *>(parallelObjects[i]);
+			IBK_ASSERT(group != nullptr);
+			for (const AbstractStateDependency * model : group->models())
+				modelTaskMap[model] = taskIdx;
+
+			// all groups we depend on have already been added (they are in previous levels)
+			for (const AbstractStateDependency * model : group->models()) {
+				for (const ZEPPELIN::DependencyObject * obj : model->dependencies()) {
+					const AbstractStateDependency * depModel = dynamic_cast<const AbstractStateDependency *>(obj);
+					if (depModel == nullptr)
+						continue; // dependencies to groups are covered by dependencies to their models
+					std::map<const AbstractStateDependency*, unsigned int>::const_iterator it = modelTaskMap.find(depModel);
+					// models not in dependency graph are head/tail models and handled by the barriers,
+					// dependencies within the group are resolved by the group itself
+					if (it == modelTaskMap.end() || it->second == taskIdx)
+						continue;
+					m_stateDependencyScheduler.addDependency(taskIdx, it->second);
+				}
+			}
+		}
+
+		// add a barrier after each head level, after the complete graph section and after each tail level
+		if (sectionTasks.empty() || (graphLevel && k+1 < nLevels - nTail))
+			continue;
+		barrierIdx = (int)m_stateDependencyScheduler.addTask(nullptr);
+		for (unsigned int t : sectionTasks)
+			m_stateDependencyScheduler.addDependency((unsigned int)barrierIdx, t);
+		sectionTasks.clear();
+	}
+
+	m_stateDependencyScheduler.setup((unsigned int)m_numThreads);
+
+	IBK::IBK_Message(IBK::FormatString("State dependency task graph with %1 tasks, critical path length = %2 models (%3 levels)\n")
+		.arg(m_stateDependencyScheduler.taskCount()).arg(m_stateDependencyScheduler.criticalPathTaskCount()).arg(nLevels),
+		IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 }
 
 
@@ -2408,19 +2818,8 @@ void NandradModel::initSolverMatrix() {
 			}
 		}
 
-		/// create a sparse matrix pattern and a transpose pattern
-		IBKMK::SparseMatrixPattern pattern(nUnknowns);
-		IBKMK::SparseMatrixPattern transposePattern(nUnknowns);
-
-
-		// we first add direct connections between ydots and their respective y
-		// even if these should be evaluated to be 0 during Jacobi matrix calculation
-		// we need those positions in the matrix pattern
-		for (unsigned int i=0; i<nYStates; ++i) {
-			pattern.set(i+nYStates, i);
-			transposePattern.set(i, i+nYStates);
-		}
-
+		// collect all dependencies as (row, column) entries of the pattern
+		std::vector<std::pair<unsigned int, unsigned int> > patternEntries;
 
 		// add all dependencies
 		// all room state models
@@ -2462,11 +2861,7 @@ void NandradModel::initSolverMatrix() {
 				unsigned int i = resultRefIt->second;
 				unsigned int j = inputRefIt->second;
 				// register pattern entry
-				if (!pattern.test(i, j))
-					pattern.set(i, j);
-				// register transpose pattern entry
-				if (!transposePattern.test(j, i))
-					transposePattern.set(j, i);
+				patternEntries.push_back(std::make_pair(i, j));
 			}
 		}
 
@@ -2508,11 +2903,7 @@ void NandradModel::initSolverMatrix() {
 				unsigned int i = resultRefIt->second;
 				unsigned int j = inputRefIt->second;
 				// register pattern entry
-				if (!pattern.test(i, j))
-					pattern.set(i, j);
-				// register transpose pattern entry
-				if (!transposePattern.test(j, i))
-					transposePattern.set(j, i);
+				patternEntries.push_back(std::make_pair(i, j));
 			}
 		}
 
@@ -2554,11 +2945,7 @@ void NandradModel::initSolverMatrix() {
 				unsigned int i = resultRefIt->second;
 				unsigned int j = inputRefIt->second;
 				// register pattern entry
-				if (!pattern.test(i, j))
-					pattern.set(i, j);
-				// register transpose pattern entry
-				if (!transposePattern.test(j, i))
-					transposePattern.set(j, i);
+				patternEntries.push_back(std::make_pair(i, j));
 			}
 		}
 
@@ -2601,44 +2988,80 @@ void NandradModel::initSolverMatrix() {
 				unsigned int i = resultRefIt->second;
 				unsigned int j = inputRefIt->second;
 				// register pattern entry
-				if (!pattern.test(i, j))
-					pattern.set(i, j);
-				// register transpose pattern entry
-				if (!transposePattern.test(j, i))
-					transposePattern.set(j, i);
+				patternEntries.push_back(std::make_pair(i, j));
 			}
 		}
 
-		// calculate transitive closure over all algebraic dependencies (block nY + nYdot -> nUnknowns)
-		// this will add entries for ydot-y dependencies
-		IBKMK::SparseMatrixPattern::calculateTransitiveClosure(pattern, transposePattern,
-			nUnknowns, nYStates + nYdotStates, nUnknowns);
+		// The pattern is fully determined by the dependency entries and the number of unknowns. The hash
+		// of these values is used as key into the init cache: if a cache file with this key exists,
+		// we can skip the expensive transitive closure computation (and later the Jacobian coloring).
+		std::string topology;
+		unsigned int header[3] = {nUnknowns, nYStates, nYdotStates};
+		topology.append(reinterpret_cast<const char*>(header), sizeof(header));
+		if (!patternEntries.empty())
+			topology.append(reinterpret_cast<const char*>(&patternEntries[0]), patternEntries.size()*sizeof(std::pair<unsigned int, unsigned int>));
+		m_initCacheHash = IBK::md5_str(topology);
+		topology.clear();
+
+		bool haveCachedPattern = readInitCache();
+		if (haveCachedPattern) {
+			IBK::IBK_Message(IBK::FormatString("Using cached Jacobian pattern from '%1'\n").arg(initCacheFile()),
+				IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		}
+		else {
+			/// create a sparse matrix pattern and a transpose pattern
+			IBKMK::SparseMatrixPattern pattern(nUnknowns);
+			IBKMK::SparseMatrixPattern transposePattern(nUnknowns);
+
+			// we first add direct connections between ydots and their respective y
+			// even if these should be evaluated to be 0 during Jacobi matrix calculation
+			// we need those positions in the matrix pattern
+			for (unsigned int i=0; i<nYStates; ++i) {
+				pattern.set(i+nYStates, i);
+				transposePattern.set(i, i+nYStates);
+			}
 
-		// clear ia and ja
-		if (!m_ia.empty())
-			m_ia.clear();
-		if (!m_ja.empty())
-			m_ja.clear();
+			// now add all dependencies
+			for (const std::pair<unsigned int, unsigned int> & entry : patternEntries) {
+				// register pattern entry
+				if (!pattern.test(entry.first, entry.second))
+					pattern.set(entry.first, entry.second);
+				// register transpose pattern entry
+				if (!transposePattern.test(entry.second, entry.first))
+					transposePattern.set(entry.second, entry.first);
+			}
 
-		// calculate CSR pattern: we only consider ydot-> y block (row nY -> nY + nYdot - 1, column 0 -> nY)
-		for (unsigned int i = nYStates; i < nYStates + nYdotStates; ++i) {
-			// filter all value references refering to ydot
-			m_ia.push_back((unsigned int)m_ja.size());
-			// retreive all indices
-			std::vector<unsigned int> columns;
-			pattern.indexesPerRow(i, columns);
-			// fill all column entries into inderx vectoe
-			for (unsigned int jIdx = 0; jIdx < columns.size(); ++jIdx) {
-				// ignore columns that do not assign a y-component (columnns are sorted)
-				unsigned int j = columns[jIdx];
-				if (j >= nYStates)
-					break;
-				// find index inside result index vector
-				m_ja.push_back(j);
+			// calculate transitive closure over all algebraic dependencies (block nY + nYdot -> nUnknowns)
+			// this will add entries for ydot-y dependencies
+			IBKMK::SparseMatrixPattern::calculateTransitiveClosure(pattern, transposePattern,
+				nUnknowns, nYStates + nYdotStates, nUnknowns);
+
+			// clear ia and ja
+			if (!m_ia.empty())
+				m_ia.clear();
+			if (!m_ja.empty())
+				m_ja.clear();
+
+			// calculate CSR pattern: we only consider ydot-> y block (row nY -> nY + nYdot - 1, column 0 -> nY)
+			for (unsigned int i = nYStates; i < nYStates + nYdotStates; ++i) {
+				// filter all value references refering to ydot
+				m_ia.push_back((unsigned int)m_ja.size());
+				// retreive all indices
+				std::vector<unsigned int> columns;
+				pattern.indexesPerRow(i, columns);
+				// fill all column entries into inderx vectoe
+				for (unsigned int jIdx = 0; jIdx < columns.size(); ++jIdx) {
+					// ignore columns that do not assign a y-component (columnns are sorted)
+					unsigned int j = columns[jIdx];
+					if (j >= nYStates)
+						break;
+					// find index inside result index vector
+					m_ja.push_back(j);
+				}
 			}
+			// set last element
+			m_ia.push_back((unsigned int)m_ja.size());
 		}
-		// set last element
-		m_ia.push_back((unsigned int)m_ja.size());
 
 		// clear iaT and jaT
 		if (!m_iaT.empty())
@@ -2647,10 +3070,128 @@ void NandradModel::initSolverMatrix() {
 			m_jaT.clear();
 		// generate transpose index
 		IBKMK::SparseMatrixCSR::generateTransposedIndex(m_ia, m_ja, m_iaT, m_jaT);
+
+		// store pattern in cache for next solver run
+		if (!haveCachedPattern)
+			writeInitCache();
 	}
 	catch (IBK::Exception &ex) {
 		throw IBK::Exception(ex, "Error initializing global solver matrix!", FUNC_ID);
 	}
+
+	IBK::IBK_Message(IBK::FormatString("Jacobian pattern with %1 non-zero elements created in %2 s\n")
+		.arg(nnz()).arg(timer.difference()/1000.0), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_INFO);
+}
+
+
+IBK::Path NandradModel::initCacheFile() const {
+	return m_initCacheDir / ("init_" + m_initCacheHash + ".cache");
+}
+
+
+bool NandradModel::readInitCache() {
+	FUNCID(NandradModel::readInitCache);
+
+	IBK::Path cacheFile = initCacheFile();
+	if (!cacheFile.exists())
+		return false;
+
+	std::vector<unsigned int> ia, ja;
+	std::vector<std::vector<unsigned int> > colors;
+	try {
+		std::unique_ptr<std::ifstream> in( IBK::create_ifstream(cacheFile, std::ios_base::binary) );
+		if (!(*in))
+			throw IBK::Exception("Cannot open file.", FUNC_ID);
+		uint32_t version;
+		IBK::read_uint32_binary(*in, version);
+		if (!(*in) || version != INIT_CACHE_VERSION)
+			throw IBK::Exception("Invalid or unsupported file version.", FUNC_ID);
+		std::string hash;
+		IBK::read_string_binary(*in, hash, 100);
+		if (hash != m_initCacheHash)
+			throw IBK::Exception("Mismatching topology hash.", FUNC_ID);
+		// number of nonzero elements, limited to a dense n x n matrix
+		uint32_t nnz;
+		IBK::read_uint32_binary(*in, nnz);
+		std::size_t nnzMax = std::min<std::size_t>((std::size_t)m_n*m_n, std::numeric_limits<uint32_t>::max());
+		if (!(*in) || nnz > nnzMax)
+			throw IBK::Exception("Invalid number of nonzero elements.", FUNC_ID);
+		IBK::read_vector_binary(*in, ia, m_n + 1);
+		if (ia.size() != m_n + 1 || ia[m_n] != nnz)
+			throw IBK::Exception("Invalid sparse matrix pattern.", FUNC_ID);
+		IBK::read_vector_binary(*in, ja, nnz);
+		uint32_t nColors;
+		IBK::read_uint32_binary(*in, nColors);
+		if (!(*in) || nColors > m_n)
+			throw IBK::Exception("Invalid number of colors.", FUNC_ID);
+		colors.resize(nColors);
+		for (std::vector<unsigned int> & c : colors)
+			IBK::read_vector_binary(*in, c, m_n);
+		if (!(*in))
+			throw IBK::Exception("Error reading file.", FUNC_ID);
+		// check consistency of pattern
+		if (ja.size() != nnz || ia[0] != 0)
+			throw IBK::Exception("Invalid sparse matrix pattern.", FUNC_ID);
+		for (unsigned int i=0; i<m_n; ++i)
+			if (ia[i] > ia[i+1])
+				throw IBK::Exception("Invalid sparse matrix pattern.", FUNC_ID);
+		for (unsigned int j : ja)
+			if (j >= m_n)
+				throw IBK::Exception("Invalid sparse matrix pattern.", FUNC_ID);
+	}
+	catch (IBK::Exception & ex) {
+		IBK::IBK_Message(IBK::FormatString("Ignoring init cache file '%1': %2\n").arg(cacheFile).arg(ex.what()),
+			IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+		return false;
+	}
+	m_ia.swap(ia);
+	m_ja.swap(ja);
+	m_jacobianColors.swap(colors);
+	return true;
+}
+
+
+void NandradModel::writeInitCache() const {
+	FUNCID(NandradModel::writeInitCache);
+
+	IBK::Path cacheFile = initCacheFile();
+	// write to temporary file first and rename afterwards, so that concurrently running solvers
+	// never read a partially written cache file
+	IBK::Path tmpFile(cacheFile.str() + ".tmp");
+	{
+		std::unique_ptr<std::ofstream> out( IBK::create_ofstream(tmpFile, std::ios_base::binary | std::ios_base::trunc) );
+		if (!(*out)) {
+			IBK::IBK_Message(IBK::FormatString("Cannot write init cache file '%1'.\n").arg(tmpFile),
+				IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+			return;
+		}
+		IBK::write_uint32_binary(*out, INIT_CACHE_VERSION);
+		IBK::write_string_binary(*out, m_initCacheHash);
+		IBK::write_uint32_binary(*out, (uint32_t)m_ja.size());
+		IBK::write_vector_binary(*out, m_ia);
+		IBK::write_vector_binary(*out, m_ja);
+		IBK::write_uint32_binary(*out, (uint32_t)m_jacobianColors.size());
+		for (const std::vector<unsigned int> & c : m_jacobianColors)
+			IBK::write_vector_binary(*out, c);
+	}
+#if defined(_WIN32)
+	// rename() does not replace existing files on Windows
+	if (cacheFile.exists())
+		IBK::Path::remove(cacheFile);
+#endif
+	if (std::rename(tmpFile.str().c_str(), cacheFile.str().c_str()) != 0)
+		IBK::IBK_Message(IBK::FormatString("Cannot write init cache file '%1'.\n").arg(cacheFile),
+			IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
+}
+
+
+void NandradModel::initJacobianColors(SOLFRA::JacobianSparseCSR * jacobian) {
+	if (m_jacobianColors.empty()) {
+		// no colors in cache, generate colors and update cache
+		SOLFRA::JacobianSparseCSR::generateColors(m_n, &m_ia[0], &m_ja[0], &m_iaT[0], &m_jaT[0], m_jacobianColors);
+		writeInitCache();
+	}
+	jacobian->setColors(m_jacobianColors);
 }
 
 
@@ -2754,6 +3295,13 @@ int NandradModel::updateTimeDependentModels() {
 
 int NandradModel::updateStateDependentModels() {
 
+	// when evaluated within a parallel region (e.g. concurrently with model replicas), we must use serial code
+	bool useSerialCode = m_useSerialCode;
+#ifdef _OPENMP
+	if (omp_in_parallel())
+		useSerialCode = true;
+#endif // _OPENMP
+
 	// *** update global states (head models) ***
 
 	// Only transfers room energy - cheap functions, does not need to be parallelized
@@ -2762,17 +3310,25 @@ int NandradModel::updateStateDependentModels() {
 	}
 
 	// update states in all construction solver models
-	// Note: since setY() is already a very very fast function, this parallel loop is not
-	//       making much difference in the overall simulation performance of larger models.
+	// Note: element temperatures and fluxes of all thermal-only constructions are computed first in
+	//       the element pool, afterwards the construction models compute surface temperatures and boundary conditions.
 #ifdef _OPENMP
-	if (!m_useSerialCode) {
-#pragma omp parallel for
-		for (int i = 0; i < (int)m_constructionStatesModelContainer.size(); ++i) {
-			m_constructionStatesModelContainer[i]->setY(&m_y[0] + m_constructionVariableOffset[i]);
+	if (!useSerialCode) {
+#pragma omp parallel
+		{
+#pragma omp for
+			for (int i = 0; i < (int)m_constructionElementPool.constructionCount(); ++i) {
+				m_constructionElementPool.updateConstruction((unsigned int)i, &m_y[0]);
+			}
+#pragma omp for
+			for (int i = 0; i < (int)m_constructionStatesModelContainer.size(); ++i) {
+				m_constructionStatesModelContainer[i]->update(&m_y[0] + m_constructionVariableOffset[i]);
+			}
 		}
-}
+	}
 #endif // _OPENMP
-	if (m_useSerialCode) {
+	if (useSerialCode) {
+		m_constructionElementPool.update(&m_y[0]);
 		for (unsigned int i = 0; i < m_constructionStatesModelContainer.size(); ++i) {
 			m_constructionStatesModelContainer[i]->update(&m_y[0] + m_constructionVariableOffset[i]);
 		}
@@ -2790,43 +3346,18 @@ int NandradModel::updateStateDependentModels() {
 
 	// to keep original serial code performance, distinguish between serial and OpenMP code
 #ifdef _OPENMP
-	if (!m_useSerialCode) {
-
-		// create storage vector for thread-specific return codes
-		std::vector<int> calculationResultFlags(m_numThreads, 0);
-
-		// process all parallel object groups
-		for (unsigned int k = 0; k < m_orderedStateDependentSubModels.size(); ++k) {
-			ParallelStateObjects &parallelObjects = m_orderedStateDependentSubModels[k];
+	if (!useSerialCode) {
 
-	#pragma omp parallel
-			{
-				// store target location for thread-specific error codes
-				int & calculationResultFlag = calculationResultFlags[omp_get_thread_num()];
-	#pragma omp for
-				for (int i = 0; i < (int)parallelObjects.size(); ++i) {
-					calculationResultFlag |= parallelObjects[i]->update();
-				} // end for
-
-			} // end parallel region
-
-		} // end m_orderedStateDependentSubModels loop
-
-		// in multi-threaded code, check all return codes
-		for (int i=0; i<m_numThreads; ++i) {
-			if (calculationResultFlags[i] != 0) {
-	//			IBK::IBK_Message(IBK::FormatString("Error code %1 in thread #%2").arg(calculationResultFlags[i]).arg(i), IBK::MSG_WARNING, FUNC_ID, IBK::VL_STANDARD);
-				if (calculationResultFlags[i] & 2)
-					return 2;
-				else
-					return 1;
-			}
-		}
+		// evaluate all models following the task graph, each model is updated as soon as all models
+		// it depends on are updated
+		calculationResultFlag = m_stateDependencyScheduler.evaluate();
+		if (calculationResultFlag != 0)
+			return calculationResultFlag;
 	} // use serial code
 
 #endif // _OPENMP
 
-	if (m_useSerialCode) {
+	if (useSerialCode) {
 		for (unsigned int k = 0; k < m_orderedStateDependentSubModels.size(); ++k) {
 			ParallelStateObjects &parallelObjects = m_orderedStateDependentSubModels[k];
 
@@ -2866,59 +3397,105 @@ int NandradModel::updateStateDependentModels() {
 
 	// *** update ydot-values and store in (locally numbered) m_ydot vector***
 
-	// update states in all room state models
-	for (unsigned int i=0; i<m_roomBalanceModelContainer.size(); ++i) {
+#ifdef _OPENMP
+	if (!useSerialCode) {
+
+		// create storage vector for partition-specific return codes
+		const int nPartitions = (int)m_ydotPartition.size() - 1;
+		std::vector<int> calculationResultFlags(nPartitions, 0);
+
+		const unsigned int nZones = (unsigned int)m_roomBalanceModelContainer.size();
+		const unsigned int nZonesAndWalls = nZones + (unsigned int)m_constructionBalanceModelContainer.size();
+
+		// each partition is a range of balance models (see initSolverVariables()); partitions are
+		// distributed over the threads, so that all of them are processed regardless of the actual
+		// number of threads in the team
+#pragma omp parallel for schedule(static,1)
+		for (int p=0; p<nPartitions; ++p) {
+			int & calculationResultFlag = calculationResultFlags[p];
+
+			for (unsigned int j = m_ydotPartition[p]; j < m_ydotPartition[p + 1]; ++j) {
+				if (j < nZones) {
+					calculationResultFlag |= m_roomBalanceModelContainer[j]->ydot(&m_ydot[0] + m_zoneVariableOffset[j]);
+				}
+				else if (j < nZonesAndWalls) {
+					unsigned int i = j - nZones;
+					calculationResultFlag |= m_constructionBalanceModelContainer[i]->ydot(&m_ydot[0] + m_constructionVariableOffset[i]);
+				}
+				else {
+					unsigned int i = j - nZonesAndWalls;
+					calculationResultFlag |= m_networkBalanceModelContainer[i]->ydot(&m_ydot[0] + m_networkVariableOffset[i]);
+				}
+			}
+		} // end parallel region
+
+		// in multi-threaded code, check all return codes
+		for (int i=0; i<nPartitions; ++i) {
+			if (calculationResultFlags[i] != 0) {
+				if (calculationResultFlags[i] & 2)
+					return 2;
+				else
+					return 1;
+			}
+		}
+	} // use serial code
+#endif // _OPENMP
+
+	if (useSerialCode) {
+		// update states in all room state models
+		for (unsigned int i=0; i<m_roomBalanceModelContainer.size(); ++i) {
 #ifdef IBK_STATISTICS
-		SUNDIALS_TIMED_FUNCTION(NANDRAD_TIMER_YDOT,
-			calculationResultFlag |= m_roomBalanceModelContainer[i]->update();
-			calculationResultFlag |= m_roomBalanceModelContainer[i]->ydot(&m_ydot[0] + m_zoneVariableOffset[i]);
-		);
+			SUNDIALS_TIMED_FUNCTION(NANDRAD_TIMER_YDOT,
+				calculationResultFlag |= m_roomBalanceModelContainer[i]->update();
+				calculationResultFlag |= m_roomBalanceModelContainer[i]->ydot(&m_ydot[0] + m_zoneVariableOffset[i]);
+			);
 #else
-		calculationResultFlag |= m_roomBalanceModelContainer[i]->ydot(&m_ydot[0] + m_zoneVariableOffset[i]);
+			calculationResultFlag |= m_roomBalanceModelContainer[i]->ydot(&m_ydot[0] + m_zoneVariableOffset[i]);
 #endif
-	}
-	if (calculationResultFlag != 0) {
-		if (calculationResultFlag & 2)
-			return 2;
-		else
-			return 1;
-	}
+		}
+		if (calculationResultFlag != 0) {
+			if (calculationResultFlag & 2)
+				return 2;
+			else
+				return 1;
+		}
 
-	// update states in all construction solver models
-	for (unsigned int i=0; i<m_constructionBalanceModelContainer.size(); ++i) {
+		// update states in all construction solver models
+		for (unsigned int i=0; i<m_constructionBalanceModelContainer.size(); ++i) {
 #ifdef IBK_STATISTICS
-		SUNDIALS_TIMED_FUNCTION(NANDRAD_TIMER_YDOT,
-			calculationResultFlag |= m_constructionBalanceModelContainer[i]->ydot(&m_ydot[0] + m_constructionVariableOffset[i]);
-		);
-		++m_nYdotCalls;
+			SUNDIALS_TIMED_FUNCTION(NANDRAD_TIMER_YDOT,
+				calculationResultFlag |= m_constructionBalanceModelContainer[i]->ydot(&m_ydot[0] + m_constructionVariableOffset[i]);
+			);
+			++m_nYdotCalls;
 #else
-		calculationResultFlag |= m_constructionBalanceModelContainer[i]->ydot(&m_ydot[0] + m_constructionVariableOffset[i]);
+			calculationResultFlag |= m_constructionBalanceModelContainer[i]->ydot(&m_ydot[0] + m_constructionVariableOffset[i]);
 #endif
-	}
-	if (calculationResultFlag != 0) {
-		if (calculationResultFlag & 2)
-			return 2;
-		else
-			return 1;
-	}
+		}
+		if (calculationResultFlag != 0) {
+			if (calculationResultFlag & 2)
+				return 2;
+			else
+				return 1;
+		}
 
-	// update states in all thermal network models
-	for (unsigned int i=0; i<m_networkBalanceModelContainer.size(); ++i) {
+		// update states in all thermal network models
+		for (unsigned int i=0; i<m_networkBalanceModelContainer.size(); ++i) {
 #ifdef IBK_STATISTICS
-		SUNDIALS_TIMED_FUNCTION(NANDRAD_TIMER_YDOT,
-			calculationResultFlag |= m_networkBalanceModelContainer[i]->ydot(&m_ydot[0] + m_networkVariableOffset[i]);
-		);
-		++m_nYdotCalls;
+			SUNDIALS_TIMED_FUNCTION(NANDRAD_TIMER_YDOT,
+				calculationResultFlag |= m_networkBalanceModelContainer[i]->ydot(&m_ydot[0] + m_networkVariableOffset[i]);
+			);
+			++m_nYdotCalls;
 #else
-		calculationResultFlag |= m_networkBalanceModelContainer[i]->ydot(&m_ydot[0] + m_networkVariableOffset[i]);
+			calculationResultFlag |= m_networkBalanceModelContainer[i]->ydot(&m_ydot[0] + m_networkVariableOffset[i]);
 #endif
-	}
-	if (calculationResultFlag != 0) {
-		if (calculationResultFlag & 2)
-			return 2;
-		else
-			return 1;
-	}
+		}
+		if (calculationResultFlag != 0) {
+			if (calculationResultFlag & 2)
+				return 2;
+			else
+				return 1;
+		}
+	} // use serial code
 
 	// mark solution as updated
 	m_yChanged = false;
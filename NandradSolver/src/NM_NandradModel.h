@@ -36,12 +36,22 @@
 #include <ZEPPELIN_DependencyGraph.h>
 
 #include "NM_Directories.h"
+#include "NM_StateDependencyScheduler.h"
+#include "NM_ConstructionElementPool.h"
 
 namespace NANDRAD {
 	class ArgsParser;
 	class Project;
 }
 
+namespace SOLFRA {
+	class JacobianSparseCSR;
+}
+
+namespace IBK {
+	class StopWatch;
+}
+
 /*! The namespace NANDRAD_MODEL contains all classes/functions of the
 	NANDRAD command line solver. The central class is NandradModel, which implements
 	the integrator interface used by the SOLFRA integrator classes.
@@ -69,6 +79,7 @@ class ConstructionBalanceModel;
 
 class ThermalNetworkStatesModel;
 class ThermalNetworkBalanceModel;
+class HydraulicNetworkModel;
 
 /*! Main NANDRAD model implementation class.
 	This class implements the interface of SOLFRA::ModelInterface and SOLFRA::OutputScheduler and contains
@@ -189,17 +200,38 @@ public:
 	/*! Informs the integrator whether the model owns an error weighting function. */
 	virtual bool hasErrorWeightsFunction() override;
 
-	/*! Computes and returns serialization size, by default returns 0 which means feature not supported. */
+	/*! Computes and returns serialization size of the complete model state in bytes. */
 	virtual std::size_t serializationSize() const override;
 
 	/*! Stores content at memory location pointed to by dataPtr and increases
-		pointer afterwards to point just behind the memory occupied by the copied data.*/
+		pointer afterwards to point just behind the memory occupied by the copied data.
+		The data block holds a version number, the total size, current time point and solution
+		variables and afterwards the time-dependent states of all models in m_modelContainer
+		(see AbstractModel::serialize()).
+	*/
 	virtual void serialize(void* & dataPtr) const override;
 
 	/*! Restores content from memory at location pointed to by dataPtr and increases
-		pointer afterwards to point just behind the memory occupied by the copied data.*/
+		pointer afterwards to point just behind the memory occupied by the copied data.
+		All dependent quantities are recomputed on next call to ydot().
+		Throws an IBK::Exception if data does not match the current model.
+	*/
 	virtual void deserialize(void* & dataPtr) override;
 
+	/*! Returns number of model replicas available for concurrent evaluation, i.e. number of threads - 1.
+		Returns 0 if the model uses serial code (see m_useSerialCode). Replicas themselves do not provide
+		further replicas.
+	*/
+	virtual unsigned int nReplicas() const override;
+
+	/*! Returns model replica with index i, with 0 <= i < nReplicas().
+		Replicas are created on first request (see initReplica()). They share the project data with this
+		model, but own all model objects and hence all state and result storage. stepCompleted() and
+		deserialize() only mark the replicas as outdated, their time-dependent states are updated here on
+		the next request (see updateReplicas()).
+	*/
+	virtual SOLFRA::ModelInterface * replica(unsigned int i) override;
+
 	/*! Writes currently collected solver metrics/statistics to output.
 		\param simtime Totel elapsed wall clock time of simulation in [s] (needed for percentage calculation)
 		\param metricsFile If not nullptr, computer-readible metrics are written to the file.
@@ -220,6 +252,20 @@ public:
 
 private:
 
+	/*! Initializes this model as replica of the given model.
+		The project data (m_project) and directories are shared with the master model, climate data is copied.
+		All models are created and initialized as in init(), except for the outputs and the FMI interface model.
+		Since object lists in the project have already been resolved, initObjectLists() is not called again.
+		Replicas always use serial code, so that they can be evaluated concurrently within a parallel region.
+		Initialization messages are suppressed (see m_quiet).
+	*/
+	void initReplica(const NandradModel & master);
+
+	/*! Copies time-dependent states of all models (see AbstractModel::serialize()) to all replicas, if
+		these have changed since the last update (see m_replicasOutdated).
+	*/
+	void updateReplicas();
+
 	/*! Initializes/checks solver parameter.
 		Override-optiones specified via command line are used to modify the
 		m_project->m_solverParameter data structure.
@@ -272,10 +318,32 @@ private:
 	/*! Selects information about the discretisation matrix and provide optimal ordering for band matrices,
 		index vector for sparse matrices.*/
 	void initSolverMatrix();
+	/*! Returns path to init cache file for the current topology hash m_initCacheHash. */
+	IBK::Path initCacheFile() const;
+	/*! Reads Jacobian pattern (m_ia, m_ja) and colors (m_jacobianColors) from init cache file.
+		\return Returns true, if a valid cache file for the current topology hash was found, false otherwise.
+	*/
+	bool readInitCache();
+	/*! Writes Jacobian pattern and (if already computed) colors to init cache file.
+		Failure to write the cache file is not an error, only a warning is issued.
+	*/
+	void writeInitCache() const;
+	/*! Transfers Jacobian colors to the sparse Jacobian, either from the init cache or by
+		generating colors (in which case the init cache is updated).
+	*/
+	void initJacobianColors(SOLFRA::JacobianSparseCSR * jacobian);
+	/*! Creates the task graph for parallel evaluation of state-dependent models from the ordered head/tail
+		models and the dependency graph. Only used in parallel code.
+	*/
+	void initStateDependencyScheduler();
 	/*! Initializes model-specific statistics output files.
 		\param restart If true, the statistics file is opened in append mode.
 	*/
 	void initStatistics(SOLFRA::ModelInterface * modelInterface, bool restart);
+	/*! Stores the time elapsed since the last phase (in phaseTimer) as duration of the given initialization phase
+		in m_initPhaseTimes and restarts the timer.
+	*/
+	void initPhaseCompleted(const char * phaseName, IBK::StopWatch & phaseTimer);
 	/*! Depending on model's priorityOfModelEvaluation() (-1 for unordered, or a number for
 		head/tail ordering) the model is added to m_orderedStateDependentSubModelsHead or
 		m_orderedStateDependentSubModelsTail.
@@ -359,6 +427,15 @@ private:
 	std::vector<unsigned int>								m_ja;
 	std::vector<unsigned int>								m_iaT;
 	std::vector<unsigned int>								m_jaT;
+	/*! Column colors of the Jacobian, either read from init cache or generated in initJacobianColors(). */
+	std::vector<std::vector<unsigned int> >					m_jacobianColors;
+
+	/*! Directory to store init cache files in, defaults to var directory, can be changed with
+		command line option --init-cache-dir.
+	*/
+	IBK::Path												m_initCacheDir;
+	/*! Hash (md5) of the model topology (number of unknowns and dependency pattern), set in initSolverMatrix(). */
+	std::string												m_initCacheHash;
 
 
 	// *** Parallelization ***
@@ -372,6 +449,31 @@ private:
 		Set in initSolverVariables().
 	*/
 	bool													m_useSerialCode;
+	/*! Partition of the ydot assembly work among threads.
+		All balance models are numbered consecutively in the order of their variable offsets (zones, constructions,
+		networks). Partition i contains the balance models with indexes [m_ydotPartition[i], m_ydotPartition[i+1]),
+		so that each partition covers about the same number of unknowns and a contiguous memory block of m_ydot.
+		Partitions are distributed among the threads with a static schedule, one partition per thread.
+		Size m_numThreads + 1, set in initSolverVariables() and only used in parallel code.
+	*/
+	std::vector<unsigned int>								m_ydotPartition;
+
+	/*! Model this object is a replica of, nullptr for the main model (see initReplica()).
+		Replicas do not own m_project.
+	*/
+	const NandradModel										*m_master = nullptr;
+	/*! Replicas of this model for concurrent evaluation (owned), created on request in replica(). */
+	std::vector<NandradModel*>								m_replicas;
+	/*! If true, time-dependent states of the models have changed since the last updateReplicas() call. */
+	bool													m_replicasOutdated = false;
+	/*! Serialized time-dependent model states transferred to the replicas, kept to reuse its memory. */
+	std::vector<char>										m_replicaStateBuffer;
+	/*! If true, initialization messages are suppressed (set for replicas, whose initialization repeats
+		that of the main model).
+	*/
+	bool													m_quiet = false;
+	/*! Durations of initialization phases in [ms] (phase name and duration), printed at the end of init(). */
+	std::vector<std::pair<std::string, double> >			m_initPhaseTimes;
 
 
 	// *** State model containers and organization data structures ***
@@ -452,6 +554,11 @@ private:
 		The container is populated in registerStateDependendModel().
 	*/
 	std::vector<ParallelStateObjects>						m_orderedStateDependentSubModelsTail;
+	/*! Task scheduler that evaluates all models in m_orderedStateDependentSubModels in parallel code,
+		respecting individual model dependencies instead of synchronizing after each level.
+		Set up in initStateDependencyScheduler().
+	*/
+	StateDependencyScheduler								m_stateDependencyScheduler;
 
 	/*! Stores different dependency patterns.
 		Index 0: ydot-y dependencies
@@ -480,7 +587,14 @@ private:
 		\endcode
 	*/
 	std::vector<unsigned int>								m_constructionVariableOffset;
+	/*! Contiguous storage of element coefficients of all thermal-only constructions, used to compute
+		element temperatures and heat conduction fluxes of all constructions with a vectorized kernel.
+		Set up in initSolverVariables().
+	*/
+	ConstructionElementPool									m_constructionElementPool;
 
+	/*! Holds references to hydraulic network models (does not own the models). */
+	std::vector<HydraulicNetworkModel*>						m_hydraulicNetworkModelContainer;
 	/*! Holds references to thermal network state models (does not own the models). */
 	std::vector<ThermalNetworkStatesModel*>					m_networkStatesModelContainer;
 	/*! Holds references to thermal network balance models (does not own the models). */
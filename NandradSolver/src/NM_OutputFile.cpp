@@ -28,6 +28,7 @@
 #include <IBK_assert.h>
 #include <IBK_UnitList.h>
 #include <IBK_FileUtils.h>
+#include <IBK_CSVReader.h>
 
 #include <NANDRAD_ObjectList.h>
 #include <NANDRAD_KeywordList.h>
@@ -64,27 +65,54 @@ void OutputFile::stepCompleted(double t) {
 	m_tLastStep = m_tCurrentStep;
 	m_tCurrentStep = t;
 
-	// loop over all *available* variables and handle those with OTT_MEAN or OTT_INTEGRAL
-	unsigned int col=0; // storage column index
-	for (unsigned int i=0; i<m_valueRefs.size(); ++i) {
-		if (m_valueRefs[i] == nullptr) continue; // skip unavailable vars
-		const NANDRAD::OutputDefinition & od = m_outputDefinitions[ m_outputDefMap[i] ];
-		if (od.m_timeType != NANDRAD::OutputDefinition::OTT_NONE) {
+	// loop over all variables with OTT_MEAN or OTT_INTEGRAL
+	for (unsigned int col : m_integralColumns) {
+		m_integrals[0][col] = m_integrals[1][col];
+		// now retrieve value
+		double val = *m_columnValueRefs[col];
 
-			m_integrals[0][col] = m_integrals[1][col];
-			// now retrieve value
-			double val = *m_valueRefs[i];
-
-			// integrate over interval, using simple rectangular rule
-			double dVal = val*dt;
-			// add add to integral
-			m_integrals[1][col] = dVal + m_integrals[0][col];
-		}
-		++col;
+		// integrate over interval, using simple rectangular rule
+		double dVal = val*dt;
+		// add add to integral
+		m_integrals[1][col] = dVal + m_integrals[0][col];
 	}
 }
 
 
+std::size_t OutputFile::serializationSize() const {
+	return 3*sizeof(double)
+			+ vectorSerializationSize(m_integrals[0])
+			+ vectorSerializationSize(m_integrals[1])
+			+ vectorSerializationSize(m_integralsAtLastOutput);
+}
+
+
+void OutputFile::serialize(void* & dataPtr) const {
+	*(double*)dataPtr = m_tLastStep;
+	dataPtr = (char*)dataPtr + sizeof(double);
+	*(double*)dataPtr = m_tCurrentStep;
+	dataPtr = (char*)dataPtr + sizeof(double);
+	*(double*)dataPtr = m_tLastOutput;
+	dataPtr = (char*)dataPtr + sizeof(double);
+	serializeVector(dataPtr, m_integrals[0]);
+	serializeVector(dataPtr, m_integrals[1]);
+	serializeVector(dataPtr, m_integralsAtLastOutput);
+}
+
+
+void OutputFile::deserialize(void* & dataPtr) {
+	m_tLastStep = *(double*)dataPtr;
+	dataPtr = (char*)dataPtr + sizeof(double);
+	m_tCurrentStep = *(double*)dataPtr;
+	dataPtr = (char*)dataPtr + sizeof(double);
+	m_tLastOutput = *(double*)dataPtr;
+	dataPtr = (char*)dataPtr + sizeof(double);
+	deserializeVector(dataPtr, m_integrals[0]);
+	deserializeVector(dataPtr, m_integrals[1]);
+	deserializeVector(dataPtr, m_integralsAtLastOutput);
+}
+
+
 void OutputFile::setInputValueRefs(const std::vector<QuantityDescription> & resultDescriptions,
 								   const std::vector<const double *> & resultValueRefs)
 {
@@ -137,6 +165,15 @@ void OutputFile::setInputValueRefs(const std::vector<QuantityDescription> & resu
 	// we go through all variables and count the number of non-zero values
 	m_numCols = 0;
 	m_haveIntegrals = false;
+	m_columnValueRefs.clear();
+	m_valueColumns.clear();
+	m_integralColumns.clear();
+	m_meanColumns.clear();
+	m_unitFactors.clear();
+	m_unitOffsetColumns.clear();
+	m_unitOffsets.clear();
+	m_specialUnitColumns.clear();
+	m_specialUnits.clear();
 	for (unsigned int i=0; i<m_valueRefs.size(); ++i) {
 		if (m_valueRefs[i] == nullptr) {
 			IBK::IBK_Message(IBK::FormatString("Output for %1(id=%2).%3 not available, skipped.\n")
@@ -145,11 +182,45 @@ void OutputFile::setInputValueRefs(const std::vector<QuantityDescription> & resu
 							 .arg(m_inputRefs[i].m_name.m_name), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 		}
 		else {
-			++m_numCols;
+			unsigned int col = m_numCols++;
+			m_columnValueRefs.push_back(m_valueRefs[i]);
 			// decide integration based on original output definition
 			const NANDRAD::OutputDefinition & od = m_outputDefinitions[ m_outputDefMap[i] ];
-			if (od.m_timeType != NANDRAD::OutputDefinition::OTT_NONE)
+			if (od.m_timeType != NANDRAD::OutputDefinition::OTT_NONE) {
 				m_haveIntegrals = true;
+				m_integralColumns.push_back(col);
+				if (od.m_timeType == NANDRAD::OutputDefinition::OTT_MEAN)
+					m_meanColumns.push_back(col);
+			}
+			else
+				m_valueColumns.push_back(col);
+
+			// determine conversion from base SI unit to output unit, so that we need not look up
+			// units for each output value
+			double fact;
+			unsigned int op;
+			IBK::UnitList::instance().relate_units(IBK::UnitList::instance().retrieve(m_valueUnits[i].base_id()),
+												   IBK::UnitList::instance().retrieve(m_valueUnits[i].id()), fact, op);
+			switch (op) {
+				case IBK::UnitList::OP_MUL :
+					m_unitFactors.push_back(fact);
+				break;
+
+				case IBK::UnitList::OP_ADD :
+					m_unitFactors.push_back(1);
+					m_unitOffsetColumns.push_back(col);
+					m_unitOffsets.push_back(fact);
+				break;
+
+				case IBK::UnitList::OP_SPECIAL :
+					m_unitFactors.push_back(1);
+					m_specialUnitColumns.push_back(col);
+					m_specialUnits.push_back(m_valueUnits[i]);
+				break;
+
+				default :
+					m_unitFactors.push_back(1);
+			}
 		}
 	}
 
@@ -311,7 +382,8 @@ void OutputFile::createFile(bool restart, bool binary, const std::string & timeC
 
 	// now we have the header completed, and the first row's values and we write to file
 	if (binary) {
-		/// \todo implement binary format writing
+		// header in binary table format, see IBK::CSVReader
+		IBK::CSVReader::writeBinaryHeader(*m_ofstream, headerLabels);
 	}
 	else {
 		// header
@@ -332,105 +404,118 @@ void OutputFile::cacheOutputs(double t_out, double t_timeOfYear) {
 
 	// NOTE: t_out is already converted to output time unit!!!
 
-	// append data to cache
-	std::vector<double> vals(m_numCols+1);
-	vals[0] = t_timeOfYear;
-	unsigned int col=1; // Mind: column 0 is the time column
-	for (unsigned int i=0; i<m_valueRefs.size(); ++i) {
-		if (m_valueRefs[i] == nullptr) continue; // skip unavailable vars
-
-		const NANDRAD::OutputDefinition & od = m_outputDefinitions[ m_outputDefMap[i] ];
-		switch (od.m_timeType) {
-			case NANDRAD::OutputDefinition::OTT_NONE :
-			default :
-				// retrieve value for this variable and store in cache vector
-				vals[col] = *m_valueRefs[i];
-			break;
-
-			case NANDRAD::OutputDefinition::OTT_MEAN :
-			case NANDRAD::OutputDefinition::OTT_INTEGRAL : {
-				// interpolate linearly in interval [t_mLast, t_mCurrent]
-				IBK_ASSERT(m_tLastStep <= t_out);
-				IBK_ASSERT(t_out <= m_tCurrentStep);
-				// special handling when m_tLast == m_tCurrent = t_start
-				if (m_tLastStep == m_tCurrentStep)
-					vals[col] = 0;
-				else {
-					IBK_ASSERT(m_tLastStep < m_tCurrentStep);
-					double alpha = (t_out-m_tLastStep)/(m_tCurrentStep - m_tLastStep);
-					// NOTE: the column index in the target vector 'vals' starts with 1 for the first value
-					//       since column 0 is the time column. In the m_integrals vector, however, the
-					//       first value is in column 0. Hence, we need to shift the column when retrieving the integral value.
-					vals[col] = m_integrals[1][col-1]*alpha + m_integrals[0][col-1]*(1-alpha);
-				}
-
-				// next part only for MEAN
-				if (od.m_timeType == NANDRAD::OutputDefinition::OTT_MEAN) {
-
-					// special handling for first output value: we store the current values
-					if (m_tLastStep == m_tCurrentStep) {
-						vals[col] = *m_valueRefs[i];
-						m_integralsAtLastOutput[col] = 0; // initialize last output values with 0
-					}
-					else {
-						// we first compute the change in integral values between integral value at last output and
-						// the current interval value stored in vals[col]
-						double deltaValue = vals[col] - m_integralsAtLastOutput[col];
-						double deltaTime = t_out - m_tLastOutput;
-						IBK_ASSERT(deltaTime > 0);
-						// store current integral value
-						m_integralsAtLastOutput[col] = vals[col];
-						// compute and store average value
-						vals[col] = deltaValue/deltaTime;
-					}
-				}
+	// append row to cache, once the cache has been written the capacity is retained and no memory is allocated
+	std::size_t rowStart = m_cache.size();
+	m_cache.resize(rowStart + m_numCols + 1);
+	m_cache[rowStart] = t_timeOfYear;
+	// Mind: column 0 is the time column, hence 'vals' points to the first value column
+	double * vals = &m_cache[rowStart + 1];
+
+	// retrieve current values
+	for (unsigned int col : m_valueColumns)
+		vals[col] = *m_columnValueRefs[col];
+
+	if (!m_integralColumns.empty()) {
+		// interpolate integral values linearly in interval [t_mLast, t_mCurrent]
+		IBK_ASSERT(m_tLastStep <= t_out);
+		IBK_ASSERT(t_out <= m_tCurrentStep);
+		// special handling when m_tLast == m_tCurrent = t_start
+		if (m_tLastStep == m_tCurrentStep) {
+			for (unsigned int col : m_integralColumns)
+				vals[col] = 0;
+			// for mean values we store the current values at first output
+			for (unsigned int col : m_meanColumns) {
+				vals[col] = *m_columnValueRefs[col];
+				m_integralsAtLastOutput[col] = 0; // initialize last output values with 0
+			}
+		}
+		else {
+			IBK_ASSERT(m_tLastStep < m_tCurrentStep);
+			double alpha = (t_out-m_tLastStep)/(m_tCurrentStep - m_tLastStep);
+			const double * integralsLast = &m_integrals[0][0];
+			const double * integralsCurrent = &m_integrals[1][0];
+			for (unsigned int col : m_integralColumns)
+				vals[col] = integralsCurrent[col]*alpha + integralsLast[col]*(1-alpha);
+
+			// compute mean values from change in integral values between last and current output
+			double deltaTime = t_out - m_tLastOutput;
+			IBK_ASSERT(m_meanColumns.empty() || deltaTime > 0);
+			for (unsigned int col : m_meanColumns) {
+				double deltaValue = vals[col] - m_integralsAtLastOutput[col];
+				// store current integral value
+				m_integralsAtLastOutput[col] = vals[col];
+				// compute and store average value
+				vals[col] = deltaValue/deltaTime;
 			}
-			break;
-		} // switch
+		}
+	}
 
-		// perform target unit conversion
-		IBK::UnitList::instance().convert(m_valueUnits[i].base_unit(), m_valueUnits[i], vals[col]);
+	// perform target unit conversion
+	const double * unitFactors = &m_unitFactors[0];
+	for (unsigned int col=0; col<m_numCols; ++col)
+		vals[col] *= unitFactors[col];
+	for (unsigned int k=0; k<m_unitOffsetColumns.size(); ++k)
+		vals[m_unitOffsetColumns[k]] += m_unitOffsets[k];
+	for (unsigned int k=0; k<m_specialUnitColumns.size(); ++k)
+		IBK::UnitList::instance().convert(m_specialUnits[k].base_unit(), m_specialUnits[k], vals[m_specialUnitColumns[k]]);
 
-		++col;
-	}
 	// finally update last outputs time point
 	m_tLastOutput = t_out;
-
-	m_cache.emplace_back(vals); // like push-back, but without re-allocation
 }
 
 
 unsigned int OutputFile::cacheSize() const {
-	unsigned int cache = m_numCols * m_cache.size() * sizeof(double);
+	unsigned int cache = m_cache.size() * sizeof(double);
 	return cache;
 }
 
 
 void OutputFile::flushCache() {
+	swapCache();
+	writeCache();
+}
+
+
+void OutputFile::swapCache() {
 	// no outputs - nothing to do
 	if (m_numCols == 0 || m_ofstream == nullptr)
 		return;
 
-	// dump all rows of the cache into file
-	for (std::vector<double> & vals : m_cache) {
-		if (m_binary) {
-			/// \todo implement binary file writing
-		}
-		else {
-			// dump vector in ascii mode
-			// first values
-			for (unsigned int i=0; i<vals.size(); ++i) {
-				if (i != 0)
-					*m_ofstream << "\t";
-				*m_ofstream << vals[i];
-			}
+	if (m_writeCache.empty())
+		m_writeCache.swap(m_cache);
+	else {
+		// append rows to write buffer, keeping the order of output time points
+		m_writeCache.insert(m_writeCache.end(), m_cache.begin(), m_cache.end());
+		m_cache.clear();
+	}
+}
+
+
+void OutputFile::writeCache() {
+	// no outputs - nothing to do
+	if (m_numCols == 0 || m_ofstream == nullptr)
+		return;
+
+	if (m_binary) {
+		// dump all rows in binary mode at once, each row holds m_numCols+1 values
+		if (!m_writeCache.empty())
+			m_ofstream->write(reinterpret_cast<const char *>(&m_writeCache[0]), (std::streamsize)(m_writeCache.size()*sizeof(double)));
+	}
+	else {
+		// dump all rows in ascii mode
+		const unsigned int rowSize = m_numCols+1;
+		for (std::size_t rowStart=0; rowStart<m_writeCache.size(); rowStart += rowSize) {
+			const double * vals = &m_writeCache[rowStart];
+			*m_ofstream << vals[0];
+			for (unsigned int i=1; i<rowSize; ++i)
+				*m_ofstream << '\t' << vals[i];
 			*m_ofstream << '\n';
 		}
 	}
 	// flush stream
 	m_ofstream->flush();
-	// and clear cache
-	m_cache.clear();
+	// and clear write buffer, capacity is retained
+	m_writeCache.clear();
 }
 
 
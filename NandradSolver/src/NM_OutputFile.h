@@ -74,6 +74,15 @@ public:
 
 	virtual const char * ModelIDName() const override { return "OutputFile"; }
 
+	/*! Returns size needed to serialize integration time points and integral values. */
+	virtual std::size_t serializationSize() const override;
+
+	/*! Stores integration time points and integral values. */
+	virtual void serialize(void* & dataPtr) const override;
+
+	/*! Restores integration time points and integral values. */
+	virtual void deserialize(void* & dataPtr) override;
+
 
 	// *** Re-implemented from AbstractTimeDependency
 
@@ -142,9 +151,22 @@ private:
 
 	/*! Called from output handler once sufficient real time has elapsed or amount of data cache exceeds
 		defined limit.
+		Writes all rows in m_cache (and any rows still waiting in m_writeCache) to file.
 	*/
 	void flushCache();
 
+	/*! Moves all cached rows from m_cache to the end of the write buffer m_writeCache.
+		Afterwards m_cache is empty and can be filled again, while m_writeCache is written
+		to file by writeCache() (possibly in a different thread).
+	*/
+	void swapCache();
+
+	/*! Writes all rows in m_writeCache to file and clears the write buffer.
+		This function only accesses m_writeCache and the file stream, and may thus be called from the
+		output writer thread while m_cache is being filled.
+	*/
+	void writeCache();
+
 
 	/*! Cached flag to know whether to write in binary or ASCII mode. */
 	bool										m_binary;
@@ -196,6 +218,30 @@ private:
 	*/
 	std::vector<IBK::Unit>						m_valueUnits;
 
+	/*! Pointers to variables to monitor for all available output columns (size m_numCols).
+		Populated in setInputValueRef().
+	*/
+	std::vector<const double*>					m_columnValueRefs;
+	/*! Column indexes (0-based, time column excluded) of all outputs with OTT_NONE time type. */
+	std::vector<unsigned int>					m_valueColumns;
+	/*! Column indexes (0-based, time column excluded) of all outputs with OTT_MEAN or OTT_INTEGRAL time type. */
+	std::vector<unsigned int>					m_integralColumns;
+	/*! Column indexes (0-based, time column excluded) of all outputs with OTT_MEAN time type (subset of m_integralColumns). */
+	std::vector<unsigned int>					m_meanColumns;
+
+	/*! Factors for converting values from base SI unit to output unit (size m_numCols).
+		Conversion is done via: value*factor + offset
+	*/
+	std::vector<double>							m_unitFactors;
+	/*! Column indexes of all outputs whose unit conversion requires an offset (e.g. K -> C). */
+	std::vector<unsigned int>					m_unitOffsetColumns;
+	/*! Offsets for unit conversion, same size and order as m_unitOffsetColumns. */
+	std::vector<double>							m_unitOffsets;
+	/*! Column indexes of all outputs that require non-linear unit conversion via IBK::UnitList::convert(). */
+	std::vector<unsigned int>					m_specialUnitColumns;
+	/*! Output units of columns in m_specialUnitColumns. */
+	std::vector<IBK::Unit>						m_specialUnits;
+
 	/*! Number of columns with actual values in the output file.
 		Can (remain) 0 if non of the requested variables for this file are available from the model.
 		In this case the file is not created and writing outputs does nothing.
@@ -206,9 +252,12 @@ private:
 		New values are added in cacheOutputs(). In case of current values (OTT_NONE), the values are retrieved
 		from the result value references. In case of integral or mean values (OTT_MEAN and OTT_INTEGRAL), the
 		value is computed from the stored integral values.
-		Size of inner vector matches m_numCols+1, since time column is also added to cache as first column;
+		Rows are stored consecutively, each row holds m_numCols+1 values, since time column is also added to cache
+		as first column. The vector is only cleared and thus keeps its capacity after values have been written.
 	*/
-	std::vector< std::vector<double> >			m_cache;
+	std::vector<double>							m_cache;
+	/*! Write buffer holding rows moved from m_cache in swapCache() until they are written in writeCache(). */
+	std::vector<double>							m_writeCache;
 
 
 	/*! Time point (simulation time) in [s] at previous stepCompleted() call (begin of integration interval). */
@@ -101,6 +101,15 @@ const char * const NETWORK_ELEMENT_QUANTITIES[] = {
 namespace NANDRAD_MODEL {
 
 OutputHandler::~OutputHandler() {
+	// terminate background writer thread
+	if (m_writerThread.joinable()) {
+		{
+			std::unique_lock<std::mutex> lock(m_writerMutex);
+			m_stopWriter = true;
+		}
+		m_writerCondition.notify_all();
+		m_writerThread.join();
+	}
 	delete m_outputTimer;
 	// Note: Objects m_outputFiles are owned by NandradModel (stored in m_modelContainer).
 }
@@ -479,7 +488,7 @@ void OutputHandler::writeOutputs(double t_out, double t_secondsOfYear) {
 			IBK::IBK_Message("Flushing output cache (cache limit exceeded).\n", IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_DETAILED);
 		else
 			IBK::IBK_Message( IBK::FormatString("Flushing output cache (time delay reached, cache size = %1 Mb).\n").arg(storedBytes/1024./1024.), IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_DETAILED);
-		flushCache();
+		flushCacheAsync();
 		// restart timer
 		m_outputTimer->start();
 	}
@@ -487,9 +496,57 @@ void OutputHandler::writeOutputs(double t_out, double t_secondsOfYear) {
 
 
 void OutputHandler::flushCache() {
+	// wait for background writer to finish, so that data is written in correct order
+	waitForPendingWrite();
 	for (OutputFile * of : m_outputFiles)
 		of->flushCache();
 }
 
 
+void OutputHandler::flushCacheAsync() {
+	// start writer thread on first call
+	if (!m_writerThread.joinable())
+		m_writerThread = std::thread(&OutputHandler::writerThreadLoop, this);
+
+	// wait until previous write has completed - this limits memory use to cache and one write buffer per file
+	std::unique_lock<std::mutex> lock(m_writerMutex);
+	m_writerCondition.wait(lock, [this]{ return !m_writeRequested; });
+
+	// writer thread is idle now, move cached data to write buffers
+	for (OutputFile * of : m_outputFiles)
+		of->swapCache();
+	m_writeRequested = true;
+	lock.unlock();
+	m_writerCondition.notify_all();
+}
+
+
+void OutputHandler::waitForPendingWrite() {
+	if (!m_writerThread.joinable())
+		return;
+	std::unique_lock<std::mutex> lock(m_writerMutex);
+	m_writerCondition.wait(lock, [this]{ return !m_writeRequested; });
+}
+
+
+void OutputHandler::writerThreadLoop() {
+	std::unique_lock<std::mutex> lock(m_writerMutex);
+	for (;;) {
+		m_writerCondition.wait(lock, [this]{ return m_writeRequested || m_stopWriter; });
+		if (m_writeRequested) {
+			// write buffers are not touched by solver thread while m_writeRequested is set,
+			// so we can write without holding the lock
+			lock.unlock();
+			for (OutputFile * of : m_outputFiles)
+				of->writeCache();
+			lock.lock();
+			m_writeRequested = false;
+			m_writerCondition.notify_all();
+		}
+		else if (m_stopWriter)
+			break;
+	}
+}
+
+
 } // namespace NANDRAD_MODEL
@@ -24,6 +24,9 @@
 
 #include <vector>
 #include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include <IBK_Unit.h>
 #include <IBK_Path.h>
@@ -53,6 +56,13 @@ class AbstractModel;
 	After some real time (or when output cache exceeds a limit), the output handler requests the output files
 	to flush their caches.
 
+	Flushing during simulation is done asynchronously: the caches of all output files are moved into their
+	write buffers and a background writer thread writes these to file, while the solver continues and fills
+	the (now empty) caches again. At most one such write request is pending at any time, so the memory
+	needed is bounded by twice the output cache limit. The final flush (flushCache()) waits for a pending
+	write to complete and writes the remaining data synchronously, so that file contents are always complete
+	and in order once flushCache() returns.
+
 	Output files are created on first call.
 
 	\note Note that output handler operates with three time points (within writeOutputs()):
@@ -104,9 +114,17 @@ public:
 	*/
 	void writeOutputs(double t_out, double t_secondsOfYear);
 
-	/*! When called, asks all output files to flush their cached data to file. */
+	/*! When called, asks all output files to flush their cached data to file.
+		Waits for a pending background write to complete, so that all data is written once the function returns.
+	*/
 	void flushCache();
 
+	/*! Moves cached data of all output files to their write buffers and lets the background writer thread
+		write it to file. Returns immediately unless a previous write request is still being processed, in
+		which case the function waits for the previous write to finish first.
+	*/
+	void flushCacheAsync();
+
 
 	/*! Vector with output file objects.
 		Objects are not owned by us, but rather by NandradModel, since the output file objects
@@ -139,6 +157,24 @@ public:
 
 	/*! Number of seconds to wait before before flushing the cache. */
 	double										m_realTimeOutputDelay;
+
+private:
+	/*! Thread function of the background writer thread. */
+	void writerThreadLoop();
+
+	/*! Blocks until the background writer has finished a pending write request. */
+	void waitForPendingWrite();
+
+	/*! Background writer thread, started on first call to flushCacheAsync(). */
+	std::thread									m_writerThread;
+	/*! Mutex protecting m_writeRequested and m_stopWriter. */
+	std::mutex									m_writerMutex;
+	/*! Used to signal new write requests to the writer thread and completed writes to the solver thread. */
+	std::condition_variable						m_writerCondition;
+	/*! If true, the write buffers of the output files hold data to be written by the writer thread. */
+	bool										m_writeRequested = false;
+	/*! If true, the writer thread shall terminate. */
+	bool										m_stopWriter = false;
 };
 
 
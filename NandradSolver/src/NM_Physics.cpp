@@ -11,6 +11,17 @@
 
 namespace NANDRAD_MODEL {
 
+/*! Turbulent Nusselt correlation with precomputed Prandtl number term and geometry factor. */
+static double nusseltNumberTurbulent(const double &reynolds, const double &prandtl,
+									 const double &prandtlTerm, const double &geometryFactor)
+{
+	IBK_ASSERT(reynolds>0);
+	double zeta = std::pow(1.8 * std::log10(reynolds) - 1.5, -2.0);
+	return zeta / 8. * reynolds*prandtl /
+		(1. + 12.7 * std::sqrt(zeta / 8.) * prandtlTerm) *
+							 geometryFactor;
+}
+
 
 double FrictionFactorSwamee(const double &reynolds, const double &diameter, const double &roughness){
 	if (reynolds < RE_LAMINAR)
@@ -43,31 +54,48 @@ double NusseltNumber(const double &reynolds, const double &prandtl, const double
 	}
 }
 
+double NusseltNumber(const double &reynolds, const double &prandtl, const double &turbulentPrandtlTerm,
+					 const double &l, const double &d, const double &turbulentGeometryFactor)
+{
+	if (reynolds < RE_LAMINAR){
+		return NusseltNumberLaminar(reynolds, prandtl, l, d);
+	}
+	else if (reynolds < RE_TURBULENT){
+		double nuLam = NusseltNumberLaminar(RE_LAMINAR, prandtl, l, d);
+		double nuTurb = nusseltNumberTurbulent(RE_TURBULENT, prandtl, turbulentPrandtlTerm, turbulentGeometryFactor);
+		return nuLam + (reynolds - RE_LAMINAR) * (nuTurb - nuLam) / (RE_TURBULENT - RE_LAMINAR);
+	}
+	else {
+		return nusseltNumberTurbulent(reynolds, prandtl, turbulentPrandtlTerm, turbulentGeometryFactor);
+	}
+}
+
 double NusseltNumberTurbulent(const double &reynolds, const double &prandtl, const double &l, const double &d)
 {
-	IBK_ASSERT(reynolds>0);
-	double zeta = std::pow(1.8 * std::log10(reynolds) - 1.5, -2.0);
-	return zeta / 8. * reynolds*prandtl /
-		(1. + 12.7 * std::sqrt(zeta / 8.) * (std::pow(prandtl, 0.6667) - 1.)) *
-							 (1. + std::pow(d / l, 0.6667));
+	return NusseltNumberTurbulent(reynolds, prandtl, TurbulentNusseltGeometryFactor(l, d));
 }
 
-double NusseltNumberLaminar(const double &reynolds, const double &prandtl, const double &l, const double &d)
+double NusseltNumberTurbulent(const double &reynolds, const double &prandtl, const double &geometryFactor)
 {
-	if (reynolds <=0)
-		return 3.66; // for velocity=0
-	else
-		return std::pow( 49.37 + std::pow(1.615 * std::pow(reynolds * prandtl * d/l, 1/3) - 0.7, 3.0) , 1/3);
+	return nusseltNumberTurbulent(reynolds, prandtl, TurbulentNusseltPrandtlTerm(prandtl), geometryFactor);
 }
 
-double PrandtlNumber(const double &kinVis, const double &cp, const double &lambda, const double &rho)
+double TurbulentNusseltGeometryFactor(const double &l, const double &d)
 {
-	return kinVis * cp * rho / lambda;
+	return 1. + std::pow(d / l, 0.6667);
 }
 
-double ReynoldsNumber(const double &v, const double &kinVis, const double &d)
+double TurbulentNusseltPrandtlTerm(const double &prandtl)
 {
-	return  v * d / kinVis;
+	return std::pow(prandtl, 0.6667) - 1.;
+}
+
+double NusseltNumberLaminar(const double &reynolds, const double &prandtl, const double &l, const double &d)
+{
+	if (reynolds <=0)
+		return 3.66; // for velocity=0
+	else
+		return std::pow( 49.37 + std::pow(1.615 * std::pow(reynolds * prandtl * d/l, 1/3) - 0.7, 3.0) , 1/3);
 }
 
 
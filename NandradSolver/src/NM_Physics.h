@@ -39,7 +39,9 @@ const double MolarMassCO2 = 44.01e-03;
 	\param kinVis fluid kinematic viscosity
 	\param l characteristic length
 */
-double ReynoldsNumber(const double &v, const double &kinVis, const double &l);
+inline double ReynoldsNumber(const double &v, const double &kinVis, const double &l) {
+	return  v * l / kinVis;
+}
 
 /*! Calculates Prandtl number of a moving fluid.
 	\param kinVis fluid kinematic viscosity
@@ -47,7 +49,9 @@ double ReynoldsNumber(const double &v, const double &kinVis, const double &l);
 	\param lambda fluid thermal conductivity
 	\param rho fluid mass density
 */
-double PrandtlNumber(const double &kinVis, const double &cp, const double &lambda, const double &rho);
+inline double PrandtlNumber(const double &kinVis, const double &cp, const double &lambda, const double &rho) {
+	return kinVis * cp * rho / lambda;
+}
 
 /*! Calculates nusselt number for laminar fluid flow through a pipe.
 	Nusselt number has fixed minimum to laminar
@@ -70,6 +74,22 @@ double NusseltNumberLaminar(const double &reynolds, const double &prandtl, const
 */
 double NusseltNumberTurbulent(const double &reynolds, const double &prandtl, const double &l, const double &d);
 
+/*! Calculates nusselt number for a turbulent fluid through a pipe, same as function above, but with
+	geometry factor (1 + (d/l)^0.6667) computed beforehand via TurbulentNusseltGeometryFactor().
+*/
+double NusseltNumberTurbulent(const double &reynolds, const double &prandtl, const double &geometryFactor);
+
+/*! Returns geometry factor (1 + (d/l)^0.6667) of the turbulent Nusselt correlation.
+	\param l Characteristic length
+	\param d Pipe outside diameter
+*/
+double TurbulentNusseltGeometryFactor(const double &l, const double &d);
+
+/*! Returns Prandtl number term (Pr^0.6667 - 1) of the turbulent Nusselt correlation.
+	\param prandtl Prandtl number
+*/
+double TurbulentNusseltPrandtlTerm(const double &prandtl);
+
 /*! Calculates nusselt number for a turbulent fluid through a pipe.
 	Nusselt number has fixed minimum to laminar
 	\param reynolds Reynolds number
@@ -80,6 +100,14 @@ double NusseltNumberTurbulent(const double &reynolds, const double &prandtl, con
 */
 double NusseltNumber(const double &reynolds, const double &prandtl, const double &l, const double &d);
 
+/*! Calculates nusselt number for a turbulent fluid through a pipe, same as function above, but with
+	Prandtl number term and geometry factor of the turbulent correlation computed beforehand via
+	TurbulentNusseltPrandtlTerm() and TurbulentNusseltGeometryFactor() (or taken from a FluidPropertyTable).
+	Used when the Nusselt number of a pipe is evaluated many times.
+*/
+double NusseltNumber(const double &reynolds, const double &prandtl, const double &turbulentPrandtlTerm,
+					 const double &l, const double &d, const double &turbulentGeometryFactor);
+
 /*! friction factor according to swamee-jain euqation (approximation of colebrook-white) */
 double FrictionFactorSwamee(const double &reynolds, const double &diameter, const double &roughness);
 
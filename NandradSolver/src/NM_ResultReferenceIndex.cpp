@@ -0,0 +1,119 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+#include "NM_ResultReferenceIndex.h"
+
+#include <cstdint>
+
+namespace NANDRAD_MODEL {
+
+void ResultReferenceIndex::clear() {
+	m_names.clear();
+	m_results.clear();
+	m_keys.clear();
+	m_slots.clear();
+}
+
+
+void ResultReferenceIndex::reserve(unsigned int resultCount) {
+	m_results.reserve(resultCount);
+	m_keys.reserve(resultCount);
+	std::size_t slotCount = 16;
+	while (slotCount < 2*(std::size_t)resultCount)
+		slotCount *= 2;
+	if (slotCount > m_slots.size())
+		rehash(slotCount);
+}
+
+
+bool ResultReferenceIndex::insert(const QuantityDescription & resDesc, AbstractModel * model) {
+	// intern name
+	std::pair<std::unordered_map<std::string, unsigned int>::iterator, bool> nameIt =
+		m_names.insert(std::make_pair(resDesc.m_name, (unsigned int)m_names.size()));
+
+	Key key;
+	key.m_referenceType = resDesc.m_referenceType;
+	key.m_id = resDesc.m_id;
+	key.m_nameIndex = nameIt.first->second;
+
+	// keep table at most half full
+	if (2*(m_keys.size() + 1) > m_slots.size())
+		rehash(m_slots.empty() ? 16 : 2*m_slots.size());
+
+	std::size_t slot = findSlot(key);
+	if (m_slots[slot] != 0) {
+		// replace existing result
+		m_results[m_slots[slot]-1] = std::make_pair(resDesc, model);
+		return false;
+	}
+	m_results.push_back(std::make_pair(resDesc, model));
+	m_keys.push_back(key);
+	m_slots[slot] = (unsigned int)m_keys.size();
+	return true;
+}
+
+
+int ResultReferenceIndex::find(NANDRAD::ModelInputReference::referenceType_t referenceType, unsigned int id,
+							   const std::string & name) const
+{
+	if (m_slots.empty())
+		return -1;
+	std::unordered_map<std::string, unsigned int>::const_iterator nameIt = m_names.find(name);
+	if (nameIt == m_names.end())
+		return -1;
+	Key key;
+	key.m_referenceType = referenceType;
+	key.m_id = id;
+	key.m_nameIndex = nameIt->second;
+	return (int)m_slots[findSlot(key)] - 1;
+}
+
+
+std::size_t ResultReferenceIndex::hash(const Key & key) {
+	// 64-bit multiplicative hashing of the combined key (constants from splitmix64)
+	std::uint64_t h = ((std::uint64_t)(unsigned int)key.m_referenceType << 32) ^ key.m_id;
+	h ^= (std::uint64_t)key.m_nameIndex * 0x9e3779b97f4a7c15ull;
+	h ^= h >> 30;
+	h *= 0xbf58476d1ce4e5b9ull;
+	h ^= h >> 27;
+	h *= 0x94d049bb133111ebull;
+	h ^= h >> 31;
+	return (std::size_t)h;
+}
+
+
+std::size_t ResultReferenceIndex::findSlot(const Key & key) const {
+	const std::size_t mask = m_slots.size() - 1;
+	std::size_t slot = hash(key) & mask;
+	// linear probing, terminates since table is never full
+	while (m_slots[slot] != 0 && !(m_keys[m_slots[slot]-1] == key))
+		slot = (slot + 1) & mask;
+	return slot;
+}
+
+
+void ResultReferenceIndex::rehash(std::size_t slotCount) {
+	m_slots.assign(slotCount, 0);
+	for (unsigned int i=0; i<m_keys.size(); ++i)
+		m_slots[findSlot(m_keys[i])] = i+1;
+}
+
+} // namespace NANDRAD_MODEL
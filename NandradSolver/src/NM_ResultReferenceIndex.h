@@ -0,0 +1,110 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+#ifndef NM_ResultReferenceIndexH
+#define NM_ResultReferenceIndexH
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "NM_QuantityDescription.h"
+
+namespace NANDRAD_MODEL {
+
+class AbstractModel;
+
+/*!	Hash index of all model results, used to resolve input references in NandradModel::initModelDependencies().
+
+	Results are identified by reference type, object id and quantity name (same key as used by
+	QuantityDescription::operator<). Quantity names are interned, i.e. each distinct name is stored once and
+	identified by a consecutive name index. The hash table (open addressing with linear probing) then only
+	stores and compares integer keys, so that a lookup costs a single string hash (of the name) instead of
+	O(log n) string comparisons in a std::map.
+
+	After all results have been inserted, find() may be called concurrently from several threads.
+*/
+class ResultReferenceIndex {
+public:
+	/*! Removes all results. */
+	void clear();
+
+	/*! Reserves memory for the given number of results. */
+	void reserve(unsigned int resultCount);
+
+	/*! Adds a result quantity and the model providing it.
+		\param resDesc Quantity description, reference type and id must be set.
+		\param model Model that provides the result.
+		\return Returns true if the result was added, false if a result with the same key existed already and
+			has been replaced.
+	*/
+	bool insert(const QuantityDescription & resDesc, AbstractModel * model);
+
+	/*! Looks up a result by reference type, object id and quantity name.
+		\return Returns index of the result (see quantity() and model()), or -1 if no such result exists.
+	*/
+	int find(NANDRAD::ModelInputReference::referenceType_t referenceType, unsigned int id, const std::string & name) const;
+
+	/*! Number of results. */
+	unsigned int size() const { return (unsigned int)m_results.size(); }
+	/*! Quantity description of result with index i. */
+	const QuantityDescription & quantity(unsigned int i) const { return m_results[i].first; }
+	/*! Model providing result with index i. */
+	AbstractModel * model(unsigned int i) const { return m_results[i].second; }
+	/*! Interned name index of result with index i. */
+	unsigned int nameIndex(unsigned int i) const { return m_keys[i].m_nameIndex; }
+	/*! Number of distinct quantity names. */
+	unsigned int nameCount() const { return (unsigned int)m_names.size(); }
+
+private:
+	/*! Integer key of a result. */
+	struct Key {
+		int				m_referenceType;
+		unsigned int	m_id;
+		unsigned int	m_nameIndex;
+
+		bool operator==(const Key & other) const {
+			return m_id == other.m_id && m_nameIndex == other.m_nameIndex && m_referenceType == other.m_referenceType;
+		}
+	};
+
+	/*! Computes hash value of a key. */
+	static std::size_t hash(const Key & key);
+	/*! Returns slot index of key, either the slot holding the key or the first empty slot in the probe sequence. */
+	std::size_t findSlot(const Key & key) const;
+	/*! Re-creates hash table with given number of slots (must be a power of 2). */
+	void rehash(std::size_t slotCount);
+
+	/*! Interned quantity names, maps name to name index. */
+	std::unordered_map<std::string, unsigned int>						m_names;
+	/*! All results (quantity description and providing model). */
+	std::vector<std::pair<QuantityDescription, AbstractModel*> >		m_results;
+	/*! Keys of all results, same order as m_results. */
+	std::vector<Key>													m_keys;
+	/*! Hash table, holds index of result + 1 in each slot (0 marks empty slots).
+		Size is a power of 2 and at least twice the number of results.
+	*/
+	std::vector<unsigned int>											m_slots;
+};
+
+} // namespace NANDRAD_MODEL
+
+#endif // NM_ResultReferenceIndexH
@@ -65,11 +65,9 @@ int Schedules::setTime(double t) {
 			t -= IBK::SECONDS_PER_YEAR;
 	}
 
-	// calculate all parameter values
-	double * result = &m_results[0]; // points to first double in vector with calculated spline values
-	for (unsigned int i = 0; i<m_results.size(); ++i) {
-		result[i] = m_valueSpline[i].value(t);
-	}
+	// calculate all parameter values, simulation time changes only slightly between calls so that we use
+	// the cursor-based spline evaluation
+	IBK::LinearSpline::values(m_valueSpline, t, m_valueSplineCursors, &m_results[0]);
 	return 0;
 }
 
@@ -131,6 +131,8 @@ private:
 		in base SI units.
 	*/
 	std::vector<IBK::LinearSpline>					m_valueSpline;
+	/*! Interval cursors for each spline in m_valueSpline, used to speed up spline evaluation in setTime(). */
+	std::vector<unsigned int>						m_valueSplineCursors;
 	/*! Variables, computed/updated during the calculation.	*/
 	std::vector<double>								m_results;
 };
@@ -0,0 +1,228 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+#include "NM_StateDependencyScheduler.h"
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif // _OPENMP
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <IBK_assert.h>
+
+#include "NM_AbstractStateDependency.h"
+
+namespace NANDRAD_MODEL {
+
+/*! Returns wall clock time in seconds. */
+static double wallTime() {
+#if defined(_OPENMP)
+	return omp_get_wtime();
+#else // _OPENMP
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif // _OPENMP
+}
+
+
+void StateDependencyScheduler::clear() {
+	m_tasks.clear();
+	m_rootTasks.clear();
+	m_criticalPathTaskCount = 0;
+	m_numThreads = 0;
+	m_queues.reset();
+	m_pendingPredecessors.reset();
+	m_statistics = Statistics();
+}
+
+
+unsigned int StateDependencyScheduler::addTask(AbstractStateDependency * obj) {
+	m_tasks.push_back(Task());
+	m_tasks.back().m_obj = obj;
+	return (unsigned int)m_tasks.size() - 1;
+}
+
+
+void StateDependencyScheduler::addDependency(unsigned int taskIdx, unsigned int predecessorIdx) {
+	IBK_ASSERT(taskIdx < m_tasks.size());
+	// tasks must be added in evaluation order
+	IBK_ASSERT(predecessorIdx < taskIdx);
+	std::vector<unsigned int> & preds = m_tasks[taskIdx].m_predecessors;
+	if (std::find(preds.begin(), preds.end(), predecessorIdx) != preds.end())
+		return;
+	preds.push_back(predecessorIdx);
+	m_tasks[predecessorIdx].m_successors.push_back(taskIdx);
+}
+
+
+void StateDependencyScheduler::setup(unsigned int numThreads) {
+	IBK_ASSERT(numThreads > 0);
+
+	m_rootTasks.clear();
+	// static critical path: number of model tasks along the longest dependency chain;
+	// since predecessors always have smaller indexes, a single forward sweep suffices
+	std::vector<unsigned int> pathLength(m_tasks.size(), 0);
+	m_criticalPathTaskCount = 0;
+	for (unsigned int i=0; i<m_tasks.size(); ++i) {
+		const Task & t = m_tasks[i];
+		if (t.m_predecessors.empty())
+			m_rootTasks.push_back(i);
+		unsigned int len = 0;
+		for (unsigned int p : t.m_predecessors)
+			len = std::max(len, pathLength[p]);
+		pathLength[i] = len + (t.m_obj != nullptr ? 1 : 0);
+		m_criticalPathTaskCount = std::max(m_criticalPathTaskCount, pathLength[i]);
+	}
+
+	m_numThreads = numThreads;
+	m_queues.reset(new WorkQueue[m_numThreads]);
+	m_pendingPredecessors.reset(new std::atomic<unsigned int>[m_tasks.size()]);
+	m_taskDuration.assign(m_tasks.size(), 0);
+	m_pathTime.assign(m_tasks.size(), 0);
+	m_threadBusyTime.assign(m_numThreads, 0);
+}
+
+
+int StateDependencyScheduler::evaluate() {
+	IBK_ASSERT(m_queues != nullptr);
+
+	// reset dependency counters
+	const unsigned int nTasks = (unsigned int)m_tasks.size();
+	for (unsigned int i=0; i<nTasks; ++i)
+		m_pendingPredecessors[i].store((unsigned int)m_tasks[i].m_predecessors.size(), std::memory_order_relaxed);
+	m_remainingTasks.store(nTasks, std::memory_order_relaxed);
+	m_resultFlags.store(0, std::memory_order_relaxed);
+	std::fill(m_threadBusyTime.begin(), m_threadBusyTime.end(), 0);
+
+	// distribute ready tasks round-robin over all queues
+	for (unsigned int i=0; i<m_rootTasks.size(); ++i)
+		m_queues[i % m_numThreads].m_tasks.push_back(m_rootTasks[i]);
+
+	double tStart = wallTime();
+
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(m_numThreads)
+#endif // _OPENMP
+	{
+#if defined(_OPENMP)
+		unsigned int threadIdx = (unsigned int)omp_get_thread_num();
+#else // _OPENMP
+		unsigned int threadIdx = 0;
+#endif // _OPENMP
+		double busyTime = 0;
+
+		while (m_remainingTasks.load(std::memory_order_acquire) > 0) {
+			unsigned int taskIdx;
+			if (!popTask(threadIdx, taskIdx) && !stealTask(threadIdx, taskIdx)) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			const Task & task = m_tasks[taskIdx];
+#ifdef IBK_STATISTICS
+			double t0 = wallTime();
+#endif // IBK_STATISTICS
+			// skip evaluation of remaining models once an error occurred, the results are discarded anyway
+			if (task.m_obj != nullptr && m_resultFlags.load(std::memory_order_relaxed) == 0) {
+				int res = task.m_obj->update();
+				if (res != 0)
+					m_resultFlags.fetch_or(res);
+			}
+#ifdef IBK_STATISTICS
+			double duration = wallTime() - t0;
+			m_taskDuration[taskIdx] = duration;
+			busyTime += duration;
+#endif // IBK_STATISTICS
+
+			// release successors, the last finished predecessor enqueues the task in its own queue
+			for (unsigned int s : task.m_successors) {
+				if (m_pendingPredecessors[s].fetch_sub(1, std::memory_order_acq_rel) == 1)
+					pushTask(threadIdx, s);
+			}
+			m_remainingTasks.fetch_sub(1, std::memory_order_acq_rel);
+		}
+
+		m_threadBusyTime[threadIdx] = busyTime;
+	} // end parallel region
+
+	double wallTimeElapsed = wallTime() - tStart;
+
+	// *** update statistics ***
+
+	++m_statistics.m_evaluations;
+	m_statistics.m_wallTime += wallTimeElapsed;
+#ifdef IBK_STATISTICS
+	double criticalPath = 0;
+	for (unsigned int i=0; i<nTasks; ++i) {
+		double t = 0;
+		for (unsigned int p : m_tasks[i].m_predecessors)
+			t = std::max(t, m_pathTime[p]);
+		m_pathTime[i] = t + m_taskDuration[i];
+		criticalPath = std::max(criticalPath, m_pathTime[i]);
+	}
+	m_statistics.m_criticalPathTime += criticalPath;
+	for (unsigned int i=0; i<m_numThreads; ++i)
+		m_statistics.m_idleTime += std::max(0.0, wallTimeElapsed - m_threadBusyTime[i]);
+#endif // IBK_STATISTICS
+
+	int resultFlags = m_resultFlags.load();
+	if (resultFlags & 2)
+		return 2;
+	return resultFlags != 0 ? 1 : 0;
+}
+
+
+void StateDependencyScheduler::pushTask(unsigned int threadIdx, unsigned int taskIdx) {
+	WorkQueue & q = m_queues[threadIdx];
+	std::lock_guard<std::mutex> lock(q.m_mutex);
+	q.m_tasks.push_back(taskIdx);
+}
+
+
+bool StateDependencyScheduler::popTask(unsigned int threadIdx, unsigned int & taskIdx) {
+	WorkQueue & q = m_queues[threadIdx];
+	std::lock_guard<std::mutex> lock(q.m_mutex);
+	if (q.m_tasks.empty())
+		return false;
+	taskIdx = q.m_tasks.back();
+	q.m_tasks.pop_back();
+	return true;
+}
+
+
+bool StateDependencyScheduler::stealTask(unsigned int threadIdx, unsigned int & taskIdx) {
+	// we also visit queues of threads that are not part of the current team (in case the team is smaller
+	// than requested), so that no ready task is left behind
+	for (unsigned int i=1; i<m_numThreads; ++i) {
+		WorkQueue & q = m_queues[(threadIdx + i) % m_numThreads];
+		std::lock_guard<std::mutex> lock(q.m_mutex);
+		if (q.m_tasks.empty())
+			continue;
+		taskIdx = q.m_tasks.front();
+		q.m_tasks.pop_front();
+		return true;
+	}
+	return false;
+}
+
+} // namespace NANDRAD_MODEL
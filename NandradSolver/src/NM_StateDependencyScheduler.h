@@ -0,0 +1,167 @@
+/*	NANDRAD Solver Framework and Model Implementation.
+
+	Copyright (c) 2012-today, Institut für Bauklimatik, TU Dresden, Germany
+
+	Primary authors:
+	  Andreas Nicolai  <andreas.nicolai -[at]- tu-dresden.de>
+	  Anne Paepcke     <anne.paepcke -[at]- tu-dresden.de>
+
+	This library is part of SIM-VICUS (https://github.com/ghorwin/SIM-VICUS)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+*/
+
+#ifndef NM_StateDependencySchedulerH
+#define NM_StateDependencySchedulerH
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+namespace NANDRAD_MODEL {
+
+class AbstractStateDependency;
+
+/*! Evaluates state-dependent models (and model groups) in parallel, respecting their mutual dependencies.
+
+	Each model object is a task. A task becomes ready once all tasks it depends on (its predecessors) are
+	finished. Ready tasks are kept in thread-local queues: a thread pushes the successors it releases to its own
+	queue and pops from its back, idle threads steal from the front of other queues. Hence, only models that
+	really wait for results of other models are delayed, instead of synchronizing all threads after each
+	level of the dependency graph.
+
+	Tasks without model object (nullptr) are barrier tasks, used to enforce strict ordering between
+	sections (e.g. head and tail models with fixed evaluation priority).
+
+	Tasks must be added in a valid evaluation order, i.e. predecessors must have smaller task indexes than
+	their successors.
+
+	All threads of the OpenMP thread team take part in the evaluation. Since the team is kept alive
+	by the OpenMP runtime between parallel regions, the scheduler opens one parallel region per evaluate() call
+	instead of one per dependency level.
+
+	The scheduler collects runtime statistics: the wall clock time of each evaluate() call is always recorded.
+	When compiled with IBK_STATISTICS, the duration of each task is measured as well and the critical path
+	(the longest chain of dependent task durations) and the accumulated idle time of all threads are
+	recorded per evaluate() call.
+*/
+class StateDependencyScheduler {
+public:
+	/*! Accumulated runtime statistics, all times in seconds. */
+	struct Statistics {
+		Statistics() :
+			m_evaluations(0), m_wallTime(0), m_criticalPathTime(0), m_idleTime(0)
+		{}
+
+		/*! Number of evaluate() calls. */
+		unsigned int	m_evaluations;
+		/*! Sum of wall clock times of all evaluate() calls. */
+		double			m_wallTime;
+		/*! Sum of critical path lengths (in seconds) of all evaluate() calls (only with IBK_STATISTICS). */
+		double			m_criticalPathTime;
+		/*! Sum of idle times of all threads of all evaluate() calls (only with IBK_STATISTICS). */
+		double			m_idleTime;
+	};
+
+	/*! Removes all tasks and resets statistics. */
+	void clear();
+
+	/*! Adds a new task and returns its index.
+		\param obj Model object to be updated, or nullptr for a barrier task.
+	*/
+	unsigned int addTask(AbstractStateDependency * obj);
+
+	/*! Registers a dependency: task 'taskIdx' may only be evaluated once task 'predecessorIdx' is finished.
+		Duplicate dependencies are ignored.
+	*/
+	void addDependency(unsigned int taskIdx, unsigned int predecessorIdx);
+
+	/*! Finalizes the task graph and allocates thread-local queues.
+		Must be called after all tasks and dependencies have been added.
+	*/
+	void setup(unsigned int numThreads);
+
+	/*! Evaluates all tasks, must be called from outside a parallel region.
+		\return Returns 0 on success, 1 for recoverable errors and 2 for non-recoverable errors (in accordance
+			with AbstractStateDependency::update()).
+	*/
+	int evaluate();
+
+	/*! Number of tasks (including barrier tasks). */
+	unsigned int taskCount() const { return (unsigned int)m_tasks.size(); }
+
+	/*! Length of the longest chain of dependent model tasks (barrier tasks are not counted). */
+	unsigned int criticalPathTaskCount() const { return m_criticalPathTaskCount; }
+
+	/*! Accumulated runtime statistics. */
+	const Statistics & statistics() const { return m_statistics; }
+
+private:
+	/*! A single task in the graph. */
+	struct Task {
+		Task() : m_obj(nullptr) {}
+
+		/*! Model to be updated, nullptr for barrier tasks. */
+		AbstractStateDependency		*m_obj;
+		/*! Indexes of tasks that must be finished before this task can be evaluated. */
+		std::vector<unsigned int>	m_predecessors;
+		/*! Indexes of tasks that wait for this task. */
+		std::vector<unsigned int>	m_successors;
+	};
+
+	/*! Queue with ready tasks, one for each thread. */
+	struct WorkQueue {
+		std::mutex					m_mutex;
+		std::deque<unsigned int>	m_tasks;
+	};
+
+	/*! Appends a task to the queue of the given thread. */
+	void pushTask(unsigned int threadIdx, unsigned int taskIdx);
+	/*! Takes the most recently added task from the queue of the given thread. */
+	bool popTask(unsigned int threadIdx, unsigned int & taskIdx);
+	/*! Takes the oldest task from any other thread's queue. */
+	bool stealTask(unsigned int threadIdx, unsigned int & taskIdx);
+
+	/*! All tasks in evaluation order. */
+	std::vector<Task>							m_tasks;
+	/*! Indexes of tasks without predecessors. */
+	std::vector<unsigned int>					m_rootTasks;
+	/*! Length of longest chain of model tasks. */
+	unsigned int								m_criticalPathTaskCount = 0;
+
+	/*! Number of queues/threads the scheduler was set up for. */
+	unsigned int								m_numThreads = 0;
+	/*! Thread-local queues, size m_numThreads. */
+	std::unique_ptr<WorkQueue[]>				m_queues;
+
+	/*! Number of unfinished predecessors for each task, reset in each evaluate() call. */
+	std::unique_ptr<std::atomic<unsigned int>[]>	m_pendingPredecessors;
+	/*! Number of tasks not yet evaluated in the current evaluate() call. */
+	std::atomic<unsigned int>					m_remainingTasks;
+	/*! Combined error flags of all tasks evaluated in the current evaluate() call. */
+	std::atomic<int>							m_resultFlags;
+
+	/*! Duration of each task in the last evaluate() call. */
+	std::vector<double>							m_taskDuration;
+	/*! Busy time of each thread in the last evaluate() call. */
+	std::vector<double>							m_threadBusyTime;
+	/*! Work vector used for critical path computation. */
+	std::vector<double>							m_pathTime;
+
+	/*! Accumulated runtime statistics. */
+	Statistics									m_statistics;
+};
+
+} // namespace NANDRAD_MODEL
+
+#endif // NM_StateDependencySchedulerH
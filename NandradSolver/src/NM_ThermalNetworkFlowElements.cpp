@@ -1,5 +1,6 @@
 #include "NM_ThermalNetworkFlowElements.h"
 #include "NM_Physics.h"
+#include "NM_FluidPropertyTable.h"
 
 #include "NANDRAD_HydraulicFluid.h"
 #include "NANDRAD_HydraulicNetworkElement.h"
@@ -7,11 +8,41 @@
 #include "NANDRAD_HydraulicNetworkComponent.h"
 
 #include "numeric"
+#include <limits>
+
+#include <IBK_assert.h>
 
 
 
 namespace NANDRAD_MODEL {
 
+/*! Thermal transmittance of a pipe (section) in [W/K], used by all pipe models with heat exchange.
+	\param length Length of pipe (section) in [m]
+	\param innerHeatTransferCoefficient Heat transfer coefficient between fluid and inner pipe surface in [W/m2K]
+	\param innerDiameter Hydraulic (inner) diameter of pipe in [m]
+	\param outerResistance Thermal resistance of outer pipe surface in [mK/W], 0 if there is no outer heat transfer coefficient
+	\param wallResistance Thermal resistance of pipe wall and insulation in [mK/W]
+*/
+static inline double pipeThermalTransmittance(double length, double innerHeatTransferCoefficient, double innerDiameter,
+											  double outerResistance, double wallResistance)
+{
+	// UAValueTotal has W/K, basically the u-value per length pipe (including transfer coefficients) x pipe length.
+	return length / (
+				  1.0/(innerHeatTransferCoefficient * innerDiameter * PI
+				+ outerResistance
+				+ wallResistance )
+		);
+}
+
+
+/*! Thermal resistance of outer pipe surface in [mK/W], 0 for outerHeatTransferCoefficient == 0. */
+static inline double pipeOuterResistance(double outerHeatTransferCoefficient, double outerDiameter) {
+	if (outerHeatTransferCoefficient == 0.)
+		return 0;
+	return 1.0/(outerHeatTransferCoefficient * outerDiameter * PI);
+}
+
+
 // *** TNSimplePipeElement ***
 
 TNSimplePipeElement::TNSimplePipeElement(const NANDRAD::HydraulicNetworkElement & elem,
@@ -45,34 +76,24 @@ TNSimplePipeElement::TNSimplePipeElement(const NANDRAD::HydraulicNetworkElement
 void TNSimplePipeElement::setInflowTemperature(double Tinflow) {
 	m_inflowTemperature = Tinflow;
 
-	// check heat transfer type
-	m_volumeFlow = std::fabs(m_massFlux)/m_fluidDensity; // m3/s !!! unit conversion is done when writing outputs
+	// heat transfer quantities are only computed here, if not already done in TNPipeHeatTransferBatch::update()
+	if (!m_heatTransferInBatch) {
+		m_volumeFlow = std::fabs(m_massFlux)/m_fluidDensity; // m3/s !!! unit conversion is done when writing outputs
 
-	// note: velcoty is caluclated for a single pipe (but mass flux interpreted as flux through all parallel pipes
-	m_velocity = m_volumeFlow/m_fluidCrossSection;
+		// note: velcoty is caluclated for a single pipe (but mass flux interpreted as flux through all parallel pipes
+		m_velocity = m_volumeFlow/m_fluidCrossSection;
 
-	m_viscosity = m_fluidViscosity.value(m_meanTemperature);
-	m_reynolds = ReynoldsNumber(m_velocity, m_viscosity, m_innerDiameter);
-	m_prandtl = PrandtlNumber(m_viscosity, m_fluidHeatCapacity, m_fluidConductivity, m_fluidDensity);
-	m_nusselt = NusseltNumber(m_reynolds, m_prandtl, m_length, m_innerDiameter);
-	// calculate inner heat transfer coefficient
-	double innerHeatTransferCoefficient = m_nusselt * m_fluidConductivity /
-											m_innerDiameter;
+		m_viscosity = m_fluidViscosity.value(m_meanTemperature);
+		m_reynolds = ReynoldsNumber(m_velocity, m_viscosity, m_innerDiameter);
+		m_prandtl = PrandtlNumber(m_viscosity, m_fluidHeatCapacity, m_fluidConductivity, m_fluidDensity);
+		m_nusselt = NusseltNumber(m_reynolds, m_prandtl, m_length, m_innerDiameter);
+		// calculate inner heat transfer coefficient
+		double innerHeatTransferCoefficient = m_nusselt * m_fluidConductivity /
+												m_innerDiameter;
 
-	if(m_outerHeatTransferCoefficient == 0.) {
-		// UAValueTotal has W/K, basically the u-value per length pipe (including transfer coefficients) x pipe length.
-		m_thermalTransmittance = m_length / (
-					  1.0/(innerHeatTransferCoefficient * m_innerDiameter * PI
-					+ 1.0/m_UValuePipeWall )
-			);
-	}
-	else {
-		// UAValueTotal has W/K, basically the u-value per length pipe (including transfer coefficients) x pipe length.
-		m_thermalTransmittance = m_length / (
-					  1.0/(innerHeatTransferCoefficient * m_innerDiameter * PI
-					+ 1.0/(m_outerHeatTransferCoefficient * m_outerDiameter * PI)
-					+ 1.0/m_UValuePipeWall )
-			);
+		m_thermalTransmittance = pipeThermalTransmittance(m_length, innerHeatTransferCoefficient, m_innerDiameter,
+														  pipeOuterResistance(m_outerHeatTransferCoefficient, m_outerDiameter),
+														  1.0/m_UValuePipeWall);
 	}
 
 	const double externalTemperature = *m_externalTemperatureRef;
@@ -201,9 +222,12 @@ void TNDynamicPipeElement::setInitialTemperature(double T0) {
 void TNDynamicPipeElement::setInflowTemperature(double Tinflow) {
 	m_inflowTemperature = Tinflow;
 
-	m_volumeFlow = std::fabs(m_massFlux)/m_fluidDensity; // m3/s !!! unit conversion is done when writing outputs
-	// note: velcoty is caluclated for a single pipe (but mass flux interpreted as flux through all parallel pipes
-	m_velocity = m_volumeFlow/m_fluidCrossSection;
+	// velocity and heat transfer quantities are only computed here, if not already done in TNPipeHeatTransferBatch::update()
+	if (!m_heatTransferInBatch) {
+		m_volumeFlow = std::fabs(m_massFlux)/m_fluidDensity; // m3/s !!! unit conversion is done when writing outputs
+		// note: velcoty is caluclated for a single pipe (but mass flux interpreted as flux through all parallel pipes
+		m_velocity = m_volumeFlow/m_fluidCrossSection;
+	}
 
 	// check heat transfer type
 	if (m_heatExchangeType != (int) NANDRAD::HydraulicNetworkHeatExchange::T_HeatLossConstant &&
@@ -212,29 +236,17 @@ void TNDynamicPipeElement::setInflowTemperature(double Tinflow) {
 
 		m_heatLoss = 0.0;
 
-		// assume constant heat transfer coefficient along pipe, using average temperature
-		m_viscosity = m_fluidViscosity.value(m_meanTemperature);
-		m_reynolds = ReynoldsNumber(m_velocity, m_viscosity, m_innerDiameter);
-		m_prandtl = PrandtlNumber(m_viscosity, m_fluidHeatCapacity, m_fluidConductivity, m_fluidDensity);
-		m_nusselt = NusseltNumber(m_reynolds, m_prandtl, m_length, m_innerDiameter);
-		double innerHeatTransferCoefficient = m_nusselt * m_fluidConductivity / m_innerDiameter;
-
-		// UAValueTotal has W/K, basically the u-value per length pipe (including transfer coefficients) x pipe length.
-		// see documentation above
-		if(m_outerHeatTransferCoefficient == 0.) {
-			// UAValueTotal has W/K, basically the u-value per length pipe (including transfer coefficients) x pipe length.
-			m_thermalTransmittance = m_discLength / (
-						  1.0/(innerHeatTransferCoefficient * m_innerDiameter * PI
-						+ 1.0/m_UValuePipeWall )
-				);
-		}
-		else {
-			// UAValueTotal has W/K, basically the u-value per length pipe (including transfer coefficients) x pipe length.
-			m_thermalTransmittance = m_discLength / (
-						  1.0/(innerHeatTransferCoefficient * m_innerDiameter * PI
-						+ 1.0/(m_outerHeatTransferCoefficient * m_outerDiameter * PI)
-						+ 1.0/m_UValuePipeWall )
-				);
+		if (!m_heatTransferInBatch) {
+			// assume constant heat transfer coefficient along pipe, using average temperature
+			m_viscosity = m_fluidViscosity.value(m_meanTemperature);
+			m_reynolds = ReynoldsNumber(m_velocity, m_viscosity, m_innerDiameter);
+			m_prandtl = PrandtlNumber(m_viscosity, m_fluidHeatCapacity, m_fluidConductivity, m_fluidDensity);
+			m_nusselt = NusseltNumber(m_reynolds, m_prandtl, m_length, m_innerDiameter);
+			double innerHeatTransferCoefficient = m_nusselt * m_fluidConductivity / m_innerDiameter;
+
+			m_thermalTransmittance = pipeThermalTransmittance(m_discLength, innerHeatTransferCoefficient, m_innerDiameter,
+															  pipeOuterResistance(m_outerHeatTransferCoefficient, m_outerDiameter),
+															  1.0/m_UValuePipeWall);
 		}
 
 
@@ -333,6 +345,150 @@ void TNDynamicPipeElement::dependencies(const double *ydot, const double *y,
 }
 
 
+// *** TNPipeHeatTransferBatch ***
+
+void TNPipeHeatTransferBatch::setup(const NANDRAD::HydraulicFluid & fluid, const FluidPropertyTable * fluidProperties) {
+	m_fluidDensity = fluid.m_para[NANDRAD::HydraulicFluid::P_Density].value;
+	m_fluidHeatCapacity = fluid.m_para[NANDRAD::HydraulicFluid::P_HeatCapacity].value;
+	m_fluidConductivity = fluid.m_para[NANDRAD::HydraulicFluid::P_Conductivity].value;
+	m_fluidProperties = fluidProperties;
+}
+
+
+void TNPipeHeatTransferBatch::addPipe(TNSimplePipeElement * pipe) {
+	// simple pipes are stored before all dynamic pipes
+	IBK_ASSERT(m_dynamicPipes.empty());
+	addPipeData(pipe->m_length, pipe->m_length, pipe->m_innerDiameter, pipe->m_outerDiameter, pipe->m_fluidCrossSection,
+				pipe->m_UValuePipeWall, pipe->m_outerHeatTransferCoefficient);
+	m_simplePipes.push_back(pipe);
+	pipe->m_heatTransferInBatch = true;
+}
+
+
+void TNPipeHeatTransferBatch::addPipe(TNDynamicPipeElement * pipe) {
+	// thermal transmittance of dynamic pipes refers to a single discretization volume
+	addPipeData(pipe->m_length, pipe->m_discLength, pipe->m_innerDiameter, pipe->m_outerDiameter, pipe->m_fluidCrossSection,
+				pipe->m_UValuePipeWall, pipe->m_outerHeatTransferCoefficient);
+	m_dynamicPipes.push_back(pipe);
+	pipe->m_heatTransferInBatch = true;
+}
+
+
+void TNPipeHeatTransferBatch::addPipeData(double length, double transmittanceLength, double innerDiameter,
+										  double outerDiameter, double fluidCrossSection, double UValuePipeWall,
+										  double outerHeatTransferCoefficient)
+{
+	m_length.push_back(length);
+	m_transmittanceLength.push_back(transmittanceLength);
+	m_innerDiameter.push_back(innerDiameter);
+	m_fluidCrossSection.push_back(fluidCrossSection);
+	m_turbulentNusseltFactor.push_back(TurbulentNusseltGeometryFactor(length, innerDiameter));
+	m_outerResistance.push_back(pipeOuterResistance(outerHeatTransferCoefficient, outerDiameter));
+	m_wallResistance.push_back(1.0/UValuePipeWall);
+
+	// inputs are initialized with NaN, so that all pipes are computed in the first call to update()
+	unsigned int n = size();
+	m_massFlux.resize(n, std::numeric_limits<double>::quiet_NaN());
+	m_meanTemperature.resize(n, std::numeric_limits<double>::quiet_NaN());
+	m_volumeFlow.resize(n);
+	m_velocity.resize(n);
+	m_viscosity.resize(n);
+	m_reynolds.resize(n);
+	m_prandtl.resize(n);
+	m_turbulentPrandtlTerm.resize(n);
+	m_nusselt.resize(n);
+	m_thermalTransmittance.resize(n);
+}
+
+
+void TNPipeHeatTransferBatch::update() {
+	const unsigned int n = size();
+	const unsigned int nSimple = (unsigned int)m_simplePipes.size();
+
+	// collect current mass fluxes and mean fluid temperatures and select all pipes whose inputs have changed
+	// since the last call; during Jacobian generation only few states are modified in each evaluation, so that
+	// heat transfer needs to be recomputed for a few pipes only
+	m_changedPipes.clear();
+	for (unsigned int k=0; k<nSimple; ++k) {
+		const TNSimplePipeElement * pipe = m_simplePipes[k];
+		if (pipe->m_massFlux != m_massFlux[k] || pipe->m_meanTemperature != m_meanTemperature[k]) {
+			m_massFlux[k] = pipe->m_massFlux;
+			m_meanTemperature[k] = pipe->m_meanTemperature;
+			m_changedPipes.push_back(k);
+		}
+	}
+	for (unsigned int k=nSimple; k<n; ++k) {
+		const TNDynamicPipeElement * pipe = m_dynamicPipes[k-nSimple];
+		if (pipe->m_massFlux != m_massFlux[k] || pipe->m_meanTemperature != m_meanTemperature[k]) {
+			m_massFlux[k] = pipe->m_massFlux;
+			m_meanTemperature[k] = pipe->m_meanTemperature;
+			m_changedPipes.push_back(k);
+		}
+	}
+	if (m_changedPipes.empty())
+		return;
+
+	const unsigned int * changedPipes = &m_changedPipes[0];
+	const unsigned int nChanged = (unsigned int)m_changedPipes.size();
+
+	// note: velocity is calculated for a single pipe (but mass flux interpreted as flux through all parallel pipes)
+	for (unsigned int i=0; i<nChanged; ++i) {
+		const unsigned int k = changedPipes[i];
+		m_volumeFlow[k] = std::fabs(m_massFlux[k])/m_fluidDensity;
+		m_velocity[k] = m_volumeFlow[k]/m_fluidCrossSection[k];
+	}
+
+	// temperature-dependent fluid properties
+	for (unsigned int i=0; i<nChanged; ++i) {
+		const unsigned int k = changedPipes[i];
+		m_fluidProperties->properties(m_meanTemperature[k], m_viscosity[k], m_prandtl[k], m_turbulentPrandtlTerm[k]);
+	}
+
+	for (unsigned int i=0; i<nChanged; ++i) {
+		const unsigned int k = changedPipes[i];
+		m_reynolds[k] = ReynoldsNumber(m_velocity[k], m_viscosity[k], m_innerDiameter[k]);
+	}
+
+	for (unsigned int i=0; i<nChanged; ++i) {
+		const unsigned int k = changedPipes[i];
+		m_nusselt[k] = NusseltNumber(m_reynolds[k], m_prandtl[k], m_turbulentPrandtlTerm[k], m_length[k],
+									 m_innerDiameter[k], m_turbulentNusseltFactor[k]);
+	}
+
+	for (unsigned int i=0; i<nChanged; ++i) {
+		const unsigned int k = changedPipes[i];
+		double innerHeatTransferCoefficient = m_nusselt[k] * m_fluidConductivity / m_innerDiameter[k];
+		m_thermalTransmittance[k] = pipeThermalTransmittance(m_transmittanceLength[k], innerHeatTransferCoefficient,
+															 m_innerDiameter[k], m_outerResistance[k], m_wallResistance[k]);
+	}
+
+	// copy results into pipe elements
+	for (unsigned int i=0; i<nChanged; ++i) {
+		const unsigned int k = changedPipes[i];
+		if (k < nSimple) {
+			TNSimplePipeElement * pipe = m_simplePipes[k];
+			pipe->m_volumeFlow = m_volumeFlow[k];
+			pipe->m_velocity = m_velocity[k];
+			pipe->m_viscosity = m_viscosity[k];
+			pipe->m_reynolds = m_reynolds[k];
+			pipe->m_prandtl = m_prandtl[k];
+			pipe->m_nusselt = m_nusselt[k];
+			pipe->m_thermalTransmittance = m_thermalTransmittance[k];
+		}
+		else {
+			TNDynamicPipeElement * pipe = m_dynamicPipes[k-nSimple];
+			pipe->m_volumeFlow = m_volumeFlow[k];
+			pipe->m_velocity = m_velocity[k];
+			pipe->m_viscosity = m_viscosity[k];
+			pipe->m_reynolds = m_reynolds[k];
+			pipe->m_prandtl = m_prandtl[k];
+			pipe->m_nusselt = m_nusselt[k];
+			pipe->m_thermalTransmittance = m_thermalTransmittance[k];
+		}
+	}
+}
+
+
 // *** DynamicAdiabaticPipeElement ***
 
 TNDynamicAdiabaticPipeElement::TNDynamicAdiabaticPipeElement(const NANDRAD::HydraulicNetworkElement & elem,
@@ -17,6 +17,8 @@ namespace NANDRAD {
 
 namespace NANDRAD_MODEL {
 
+class FluidPropertyTable;
+
 // **** Pipe with single fluid volume but including a steady state temperature distribution***
 
 /*! Instantiated for SimplePipe elements with HeatExchangeType set. */
@@ -56,6 +58,11 @@ public:
 
 private:
 
+	/*! If true, velocity, fluid properties, dimensionless numbers and thermal transmittance are
+		computed by TNPipeHeatTransferBatch::update() and setInflowTemperature() only computes the heat loss.
+	*/
+	bool							m_heatTransferInBatch = false;
+
 	/*! pipe length in [m] */
 	double							m_length = -999;
 
@@ -111,6 +118,7 @@ private:
 	/*! Reference to external temperature in K */
 	const double*					m_externalTemperatureRef = nullptr;
 
+	friend class TNPipeHeatTransferBatch;
 };
 
 
@@ -238,6 +246,11 @@ public:
 
 private:
 
+	/*! If true, velocity, fluid properties, dimensionless numbers and thermal transmittance are
+		computed by TNPipeHeatTransferBatch::update() and setInflowTemperature() only computes the heat losses.
+	*/
+	bool							m_heatTransferInBatch = false;
+
 	/*! Number of discretization volumes */
 	unsigned int					m_nVolumes;
 
@@ -308,6 +321,110 @@ private:
 	/*! Reference to external temperature in [K] */
 	const double*					m_externalTemperatureRef = nullptr;
 
+	friend class TNPipeHeatTransferBatch;
+};
+
+
+// **** Batched heat transfer calculation for pipes ***
+
+/*! Computes fluid velocity, viscosity, Reynolds, Prandtl and Nusselt numbers and thermal transmittance
+	for all TNSimplePipeElement and TNDynamicPipeElement objects of a network.
+
+	Pipe data is stored as structure of arrays, and all quantities are computed stage by stage in loops
+	over all pipes, without virtual function calls. Terms that only depend on pipe geometry (geometry factor
+	of the turbulent Nusselt correlation, thermal resistances of outer surface and pipe wall) are computed
+	once when the pipe is added.
+
+	Since the evaluation of the correlations is expensive, only pipes whose mass flux or mean fluid temperature
+	have changed since the last evaluation are recomputed. This is the case for most pipes during Jacobian
+	generation with difference quotients, where only a few states are modified in each evaluation.
+
+	Results are copied back into the pipe elements, where they are used for computing heat losses and are
+	published as model quantities.
+
+	update() must be called after mass fluxes and internal states of the pipes have been set, and before
+	setInflowTemperature() is called.
+*/
+class TNPipeHeatTransferBatch {
+public:
+	/*! Caches fluid properties and stores pointer to the fluid property table (must be set up already and
+		outlive the batch), must be called before pipes are added.
+	*/
+	void setup(const NANDRAD::HydraulicFluid & fluid, const FluidPropertyTable * fluidProperties);
+
+	/*! Adds a pipe element to the batch, its heat transfer calculation is then done in update(). */
+	void addPipe(TNSimplePipeElement * pipe);
+	/*! Adds a pipe element to the batch, its heat transfer calculation is then done in update(). */
+	void addPipe(TNDynamicPipeElement * pipe);
+
+	/*! Computes heat transfer quantities of all pipes from current mass fluxes and mean fluid temperatures.
+		Only pipes whose mass flux or mean fluid temperature has changed since the last call are recomputed.
+	*/
+	void update();
+
+	/*! Number of pipes in batch. */
+	unsigned int size() const { return (unsigned int)m_innerDiameter.size(); }
+
+private:
+	/*! Appends geometry data of a pipe to the data arrays. */
+	void addPipeData(double length, double transmittanceLength, double innerDiameter, double outerDiameter,
+					 double fluidCrossSection, double UValuePipeWall, double outerHeatTransferCoefficient);
+
+	/*! Simple pipe elements, data is stored at index 0...m_simplePipes.size()-1 in the data arrays. */
+	std::vector<TNSimplePipeElement*>	m_simplePipes;
+	/*! Dynamic pipe elements, data is stored behind simple pipe data in the data arrays. */
+	std::vector<TNDynamicPipeElement*>	m_dynamicPipes;
+
+	/*! Fluid density in [kg/m3]. */
+	double								m_fluidDensity = -999;
+	/*! Fluid heat capacity in [J/kgK]. */
+	double								m_fluidHeatCapacity = -999;
+	/*! Fluid conductivity in [W/mK]. */
+	double								m_fluidConductivity = -999;
+	/*! Tabulated temperature-dependent fluid properties. */
+	const FluidPropertyTable			*m_fluidProperties = nullptr;
+
+	// constant pipe data
+
+	/*! Pipe length in [m]. */
+	std::vector<double>					m_length;
+	/*! Length that thermal transmittance refers to (pipe length or length of discretization volume) in [m]. */
+	std::vector<double>					m_transmittanceLength;
+	/*! Hydraulic (inner) diameter of pipe in [m]. */
+	std::vector<double>					m_innerDiameter;
+	/*! Effective flow cross-section of all parallel pipes in [m2]. */
+	std::vector<double>					m_fluidCrossSection;
+	/*! Geometry factor of turbulent Nusselt correlation in [---]. */
+	std::vector<double>					m_turbulentNusseltFactor;
+	/*! Thermal resistance of outer surface (0 if no outer heat transfer coefficient is given) in [mK/W]. */
+	std::vector<double>					m_outerResistance;
+	/*! Thermal resistance of pipe wall in [mK/W]. */
+	std::vector<double>					m_wallResistance;
+
+	// current values, updated in update()
+
+	/*! Mass flux in [kg/s] used in last update() call. */
+	std::vector<double>					m_massFlux;
+	/*! Mean fluid temperature in [K] used in last update() call. */
+	std::vector<double>					m_meanTemperature;
+	/*! Indexes of pipes whose inputs have changed in the last call to update(). */
+	std::vector<unsigned int>			m_changedPipes;
+	/*! Fluid volume flow in [m3/s]. */
+	std::vector<double>					m_volumeFlow;
+	/*! Fluid velocity in [m/s]. */
+	std::vector<double>					m_velocity;
+	/*! Fluid kinematic viscosity in [m2/s]. */
+	std::vector<double>					m_viscosity;
+	/*! Reynolds number in [---]. */
+	std::vector<double>					m_reynolds;
+	/*! Prandtl number in [---]. */
+	std::vector<double>					m_prandtl;
+	/*! Prandtl number term of turbulent Nusselt correlation in [---]. */
+	std::vector<double>					m_turbulentPrandtlTerm;
+	/*! Nusselt number in [---]. */
+	std::vector<double>					m_nusselt;
+	/*! Thermal transmittance in [W/K]. */
+	std::vector<double>					m_thermalTransmittance;
 };
 
 
@@ -46,6 +46,24 @@ void ThermalNetworkModelImpl::setup(const Network &nw,
 	m_nodalTemperatures.resize(nw.m_nodes.size());
 	// get fluid heat capacity
 	m_fluid = &fluid;
+
+	// tabulate temperature-dependent fluid properties
+	m_fluidProperties.setup(fluid);
+
+	// collect all pipes with heat exchange for the batched heat transfer calculation,
+	// simple pipes first, then dynamic pipes
+	m_pipeHeatTransferBatch = TNPipeHeatTransferBatch();
+	m_pipeHeatTransferBatch.setup(fluid, &m_fluidProperties);
+	for (ThermalNetworkAbstractFlowElement * fe : m_flowElements) {
+		TNSimplePipeElement * pipe = dynamic_cast<TNSimplePipeElement *>(fe);
+		if (pipe != nullptr)
+			m_pipeHeatTransferBatch.addPipe(pipe);
+	}
+	for (ThermalNetworkAbstractFlowElement * fe : m_flowElements) {
+		TNDynamicPipeElement * pipe = dynamic_cast<TNDynamicPipeElement *>(fe);
+		if (pipe != nullptr)
+			m_pipeHeatTransferBatch.addPipe(pipe);
+	}
 }
 
 
@@ -60,16 +78,19 @@ int ThermalNetworkModelImpl::update() {
 		flowElem->setMassFlux(massFlux);
 	}
 
+	// compute heat transfer of all pipes (needs mass fluxes and mean temperatures)
+	m_pipeHeatTransferBatch.update();
+
 	// calculate enthalpy fluxes for all nodes
 	for(unsigned int i = 0; i < m_network->m_nodes.size(); ++i) {
 		// set enthalpy flux to 0
 		double enthalpyFluxInlet = 0;
 
 		// vector of elements that push fluid into the node
-		std::vector<unsigned int> inletIdxs =
+		const std::vector<unsigned int> & inletIdxs =
 				m_network->m_nodes[i].m_elementIndexesInlet;
 		// vector of elements where the node fluid goes into
-		std::vector<unsigned int> outletIdxs =
+		const std::vector<unsigned int> & outletIdxs =
 				m_network->m_nodes[i].m_elementIndexesOutlet;
 
 		// Note: the actual mass flux direction determines what will be inlet/outlet.
@@ -135,9 +156,9 @@ void ThermalNetworkModelImpl::dependencies(std::vector<std::pair<const double *,
 		// result quantities
 		const double* tempPtr = &m_nodalTemperatures[i];
 
-		std::vector<unsigned int> inletIdxs =
+		const std::vector<unsigned int> & inletIdxs =
 				m_network->m_nodes[i].m_elementIndexesInlet;
-		std::vector<unsigned int> outletIdxs =
+		const std::vector<unsigned int> & outletIdxs =
 				m_network->m_nodes[i].m_elementIndexesOutlet;
 
 		for(unsigned int idx : inletIdxs) {
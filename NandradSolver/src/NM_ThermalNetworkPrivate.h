@@ -23,6 +23,8 @@
 #define NM_ThermalNetworkPrivateH
 
 #include "NM_ThermalNetworkAbstractFlowElementWithHeatLoss.h"
+#include "NM_ThermalNetworkFlowElements.h"
+#include "NM_FluidPropertyTable.h"
 
 #include <vector>
 
@@ -75,6 +77,12 @@ public:
 	*/
 	const double									*m_fluidMassFluxes;
 
+	/*! Tabulated temperature-dependent fluid properties, shared by all flow elements (set up in setup()). */
+	FluidPropertyTable								m_fluidProperties;
+
+	/*! Heat transfer calculation for all pipe elements with heat exchange (set up in setup()). */
+	TNPipeHeatTransferBatch							m_pipeHeatTransferBatch;
+
 private:
 
 	/*! Constant access to fluid. */
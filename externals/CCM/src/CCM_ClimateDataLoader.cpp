@@ -39,6 +39,7 @@
 #include <fstream>
 #include <algorithm>
 
+#include <IBK_algorithm.h>
 #include <IBK_assert.h>
 #include <IBK_Constants.h>
 #include <IBK_Exception.h>
@@ -139,10 +140,13 @@ ClimateDataLoader::ClimateDataLoader() :
 	m_latitudeInDegree(0),
 	m_elevation(0),
 	m_timeZone(0),
-	m_startYear(2007)
+	m_startYear(2007),
+	m_dataTimePointCursor(0)
 {
-	for (unsigned int i=0; i<NumClimateComponents; ++i)
+	for (unsigned int i=0; i<NumClimateComponents; ++i) {
 		m_currentData[i] = 0;
+		m_overrideDataCursors[i] = 0;
+	}
 	m_currentData[Temperature] = 5; // to avoid 0 K as default temperature for FMU export
 	m_currentData[RelativeHumidity] = 10;
 	m_checkBits.fill(ALL_DATA_MISSING);
@@ -1865,8 +1869,9 @@ void ClimateDataLoader::setTime(int year, double secondsOfYear) {
 								  .arg(IBK::Time::format_time_difference(m_dataTimePoints.back()))
 								  .arg(year).arg(m_startYear), FUNC_ID);
 
-		// lookup t in m_dataTimePoints
-		std::vector<double>::const_iterator it = std::lower_bound(m_dataTimePoints.begin(), m_dataTimePoints.end(), t);
+		// lookup t in m_dataTimePoints, start search at the time point found in the last call
+		std::vector<double>::const_iterator it = m_dataTimePoints.begin() +
+			IBK::lower_bound_index(m_dataTimePoints, t, m_dataTimePointCursor);
 		// it == m_dataTimePoints.begin() : t <= m_dataTimePoints[0]
 		// it == m_dataTimePoints.end() : t > m_dataTimePoints.back()
 		// it == m_dataTimePoints.begin()+1 : m_dataTimePoints[0] < t <= m_dataTimePoints[1]
@@ -1941,7 +1946,7 @@ void ClimateDataLoader::setTime(int year, double secondsOfYear) {
 		else {
 			IBK_ASSERT_XX(m_overrideData[c].size() > std::max(hourIndex1, hourIndex2),
 						  IBK::FormatString("#CC=%1, hourIndex1=%2, hourIndex2=%3").arg(c).arg(hourIndex1).arg(hourIndex2));
-			m_currentData[c] = m_overrideData[c].value(t);
+			m_currentData[c] = m_overrideData[c].value(t, m_overrideDataCursors[c]);
 		}
 	}
 }
@@ -301,6 +301,11 @@ public:
 	*/
 	IBK::LinearSpline		m_overrideData[NumClimateComponents];
 
+	/*! Cursor for the search in m_dataTimePoints, updated in setTime(). */
+	unsigned int			m_dataTimePointCursor;
+	/*! Interval cursors for the override splines, updated in setTime(). */
+	unsigned int			m_overrideDataCursors[NumClimateComponents];
+
 
 	// Calculated/interpolated values
 
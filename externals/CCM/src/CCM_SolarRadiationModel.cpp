@@ -58,7 +58,10 @@ inline bool nearly_equal(double a, double b, double EPS = 1e-5) {
 SolarRadiationModel::SolarRadiationModel() :
 	m_albedo(0.2),
 	m_climateConversionModel(ASHRAE_ClearSky),
-	m_diffuseRadiationPerezEnabled(false)
+	m_diffuseRadiationPerezEnabled(false),
+	m_sinElevation(0),
+	m_cosElevation(1),
+	m_radiationTableStep(0)
 {
 }
 
@@ -71,8 +74,6 @@ void SolarRadiationModel::setTime(int year, double secondsOfYear) {
 	// ... and orbital eccentricity of earth ...
 	m_apparentSolarTime = apparentSolarTimeFromLocalMeanTime(m_localMeanTime);
 
-	// update sun position
-	m_sunPositionModel.setTime(m_apparentSolarTime);
 	// update climate data loader
 	m_climateDataLoader.setTime(year, secondsOfYear);
 
@@ -91,12 +92,110 @@ void SolarRadiationModel::setTime(int year, double secondsOfYear) {
 	//// update climate data loader
 	//m_climateDataLoader.setTime(year, correctedTime);
 
+	// update sun position and incidence angles, either exactly or from precomputed table
+	if (m_radiationTableStep > 0) {
+		interpolateSurfaceGeometry(secondsOfYear);
+	}
+	else {
+		m_sunPositionModel.setTime(m_apparentSolarTime);
+		// surface geometry is not needed when the sun is below the horizon
+		if (m_sunPositionModel.m_elevation > 0)
+			updateSurfaceGeometry();
+	}
+
 	// compute radiation load and incidence angle for all surfaces
+	updateRadiationLoads();
+}
+
 
+void SolarRadiationModel::updateSurfaceGeometry() {
 	// retrieve sun elevation angle and azimuth angle in [rad]
 	double elevationAngle = m_sunPositionModel.m_elevation;
 	double azimuthAngle   = m_sunPositionModel.m_azimuth;
 
+	// calculate radiation fraction
+	m_sinElevation = std::sin(elevationAngle);
+	m_cosElevation = std::cos(elevationAngle);
+
+	for (unsigned int i = 0; i < m_surface.size(); ++i) {
+		// retrieve orientation and inclination angle [rad]
+		double orientationAngle = m_surface[i].first;
+		double inclinationAngle = m_surface[i].second;
+
+		// *** compute incidence angle
+
+		// caluclate fractions of horizontal and vertical solar radiation at all surfaces
+		double sinInclination = std::sin(inclinationAngle);
+
+		// calculate projection of surface normal to horizontal vertical radiation vector
+		// use the identity normal angle on plane = 90° + (azimuth - orientation)
+		// -> sin(normalAngle) = sin (90° + (azimuth - orientation)) = cos(azimuth - orientation)
+		// normal angle in height = 90° - inclination
+		// -> sin(normalAngle) = sin( 90° - inclination ) =   sin (inclination + 90°) = cos(inclination)
+		// -> cos(normalAngle) = cos( 90° - inclination ) = - cos (inclination + 90°) = sin(inclination)
+		double surfaceNormalInHorizontalRadDirection = m_cosInclination[i];
+		double surfaceNormalInVerticalRadDirection   = sinInclination * std::cos(azimuthAngle - orientationAngle);
+
+		// calulate incidence angle from scalar product: <radVector, surfaceNormal>
+		// with <radVector, surfaceNormal> denoting the scalar product.
+		// We use the formula <a, b> = || a || * || b || * cos(<)(a,b))
+		// with the enclosed angle <)(a,b)
+		double cosIncidence = surfaceNormalInHorizontalRadDirection * m_sinElevation +
+							 surfaceNormalInVerticalRadDirection * m_cosElevation;
+
+		// ensure, that rounding errors may not give cosIncidence > 1
+		if (cosIncidence > 1)
+			cosIncidence = 1;
+
+		m_surfaceNormalInVerticalRadDirection[i] = surfaceNormalInVerticalRadDirection;
+		m_cosIncidence[i] = cosIncidence;
+		// incidence angle < 0 --> no direct radiation, we assume the worst and set incidence angle to PI_HALF = 90°
+		// incidenceAngle will be always between 0° and 180° (symmetry of cosinus function)
+		m_incidenceAngle[i] = cosIncidence >= 0 ? std::acos(cosIncidence) : PI_HALF;
+	}
+}
+
+
+void SolarRadiationModel::interpolateSurfaceGeometry(double secondsOfYear) {
+	double t = std::fmod(secondsOfYear, (double)SECONDS_PER_YEAR);
+	if (t < 0)
+		t += SECONDS_PER_YEAR;
+	unsigned int stride = 5 + 3*(unsigned int)m_surface.size();
+	unsigned int nRows = (unsigned int)(m_radiationTable.size()/stride);
+	// mind: last row of the table corresponds to a time point >= SECONDS_PER_YEAR, clipping
+	//       only guards against rounding errors
+	unsigned int idx = std::min((unsigned int)(t/m_radiationTableStep), nRows-2);
+	double alpha = t/m_radiationTableStep - idx; // 0 = use values of row idx, 1 = use values of row idx+1
+	const double * row1 = &m_radiationTable[idx*stride];
+	const double * row2 = row1 + stride;
+
+	m_sunPositionModel.m_elevation = row1[0] + alpha*(row2[0] - row1[0]);
+	// azimuth angle jumps from 2*PI to 0 when the sun crosses north
+	double deltaAzimuth = row2[1] - row1[1];
+	if (deltaAzimuth > PI)
+		deltaAzimuth -= 2*PI;
+	else if (deltaAzimuth < -PI)
+		deltaAzimuth += 2*PI;
+	m_sunPositionModel.m_azimuth = row1[1] + alpha*deltaAzimuth;
+	if (m_sunPositionModel.m_azimuth < 0)
+		m_sunPositionModel.m_azimuth += 2*PI;
+	else if (m_sunPositionModel.m_azimuth >= 2*PI)
+		m_sunPositionModel.m_azimuth -= 2*PI;
+	m_sunPositionModel.m_declination = row1[2] + alpha*(row2[2] - row1[2]);
+	m_sinElevation = row1[3] + alpha*(row2[3] - row1[3]);
+	m_cosElevation = row1[4] + alpha*(row2[4] - row1[4]);
+
+	for (unsigned int i = 0, j = 5; i < m_surface.size(); ++i, j += 3) {
+		m_surfaceNormalInVerticalRadDirection[i] = row1[j] + alpha*(row2[j] - row1[j]);
+		m_cosIncidence[i] = row1[j+1] + alpha*(row2[j+1] - row1[j+1]);
+		m_incidenceAngle[i] = row1[j+2] + alpha*(row2[j+2] - row1[j+2]);
+	}
+}
+
+
+void SolarRadiationModel::updateRadiationLoads() {
+	double elevationAngle = m_sunPositionModel.m_elevation;
+
 	bool sunBeyondHorizont	= elevationAngle <= 0;
 
 	// for negative elevation angle set all radiation vector to 0
@@ -130,8 +229,7 @@ void SolarRadiationModel::setTime(int year, double secondsOfYear) {
 			}
 
 			// calculate diffuse radiation on upper and lower hemisphere
-			double cosInclination2 = std::cos(0.5 * inclinationAngle);
-			double viewFactorToSky = cosInclination2 * cosInclination2;
+			double viewFactorToSky = m_viewFactorToSky[i];
 			double viewFactorToGround = 1-viewFactorToSky;
 
 			double diffuseRadOfUpperHemisphere = viewFactorToSky * diffuseRadHorizontal;
@@ -152,18 +250,13 @@ void SolarRadiationModel::setTime(int year, double secondsOfYear) {
 	// get direct solar radiation (normal direction) and apply smooth clipping rule
 	double directRadNormal	  = smoothElevationClipping * m_climateDataLoader.m_currentData[ClimateDataLoader::DirectRadiationNormal];
 
-	// calculate radiation fraction
-	double radiationFractionHorizontal = std::sin(elevationAngle);
-	double radiationFractionVertical   = std::cos(elevationAngle);
 	// calculate horizontal and vertical solar radiation in [W/m2]
-	double directRadHorizontal  = radiationFractionHorizontal * directRadNormal;
-	double directRadVertical	= radiationFractionVertical * directRadNormal;
+	double directRadHorizontal  = m_sinElevation * directRadNormal;
+	double directRadVertical	= m_cosElevation * directRadNormal;
 	// retrieve horizontal diffuse radiation [W/m2]
 	double diffuseRadHorizontal = m_climateDataLoader.m_currentData[ClimateDataLoader::DiffuseRadiationHorizontal];
 
 	for (unsigned int i = 0; i < m_surface.size(); ++i) {
-		// retrieve orientation and inclination angle [rad]
-		double orientationAngle = m_surface[i].first;
 		double inclinationAngle = m_surface[i].second;
 
 		bool flatRoof			= nearly_equal(inclinationAngle, 0);
@@ -177,57 +270,27 @@ void SolarRadiationModel::setTime(int year, double secondsOfYear) {
 			continue;
 		}
 
-		// *** compute incidence angle
-
-		// caluclate fractions of horizontal and vertical solar radiation at all surfaces
-		double cosInclination = std::cos(inclinationAngle);
-		double sinInclination = std::sin(inclinationAngle);
-
-		// calculate projection of surface normal to horizontal vertical radiation vector
-		// use the identity normal angle on plane = 90° + (azimuth - orientation)
-		// -> sin(normalAngle) = sin (90° + (azimuth - orientation)) = cos(azimuth - orientation)
-		// normal angle in height = 90° - inclination
-		// -> sin(normalAngle) = sin( 90° - inclination ) =   sin (inclination + 90°) = cos(inclination)
-		// -> cos(normalAngle) = cos( 90° - inclination ) = - cos (inclination + 90°) = sin(inclination)
-		double surfaceNormalInHorizontalRadDirection = cosInclination;
-		double surfaceNormalInVerticalRadDirection   = sinInclination * std::cos(azimuthAngle - orientationAngle);
-
-		// calulate incidence angle from scalar product: <radVector, surfaceNormal>
-		// with <radVector, surfaceNormal> denoting the scalar product.
-		// We use the formula <a, b> = || a || * || b || * cos(<)(a,b))
-		// with the enclosed angle <)(a,b)
-		double cosIncidence = surfaceNormalInHorizontalRadDirection * radiationFractionHorizontal +
-							 surfaceNormalInVerticalRadDirection * radiationFractionVertical;
-
-		// ensure, that rounding errors may not give cosIncidence > 1
-		if (cosIncidence > 1)
-			cosIncidence = 1;
-
 		// incidence angle < 0 --> no direct radiation
-		// we assume the worst - and set direct radiation and incidence angle to PI_HALF = 90°
+		// we assume the worst - and set direct radiation to 0 (incidence angle is already PI_HALF = 90°)
 		double directRadOnSurface = 0;
-		double incidenceAngle = PI_HALF;
-		if (cosIncidence >= 0) {
+		if (m_cosIncidence[i] >= 0) {
 
 			// in the special case azimuthAngle == orientationAngle this formula gives
 			// directRadOnSurface = directRadNormal * (cosInclination * sinElevation + sinInclination * cosElevation)
 			//                    = directRadNormal * (sin(normalAngle) * sinElevation + cos(normalAngle) * cosElevation)
 			//					  = directRadNormal * cos(normalAngle - elevationAngle)
-			directRadOnSurface = surfaceNormalInHorizontalRadDirection * directRadHorizontal +
-									surfaceNormalInVerticalRadDirection * directRadVertical;
-			// incidenceAngle will be always between 0° and 180° (symmetry of cosinus function)
-			incidenceAngle  = std::acos(cosIncidence); // in Rad
+			directRadOnSurface = m_cosInclination[i] * directRadHorizontal +
+									m_surfaceNormalInVerticalRadDirection[i] * directRadVertical;
 		}
 
 		// calculate diffuse radiation on upper and lower hemisphere
-		double cosInclination2 = std::cos(0.5 * inclinationAngle);
-		double viewFactorToSky = cosInclination2 * cosInclination2;
+		double viewFactorToSky = m_viewFactorToSky[i];
 		double viewFactorToGround = 1-viewFactorToSky; // = sinInclination2*sinInclination2 with sinInclination2 = std::sin(0.5 * inclinationAngle);
 
 		// diffuse rad on upper hemisphere either with Perez or standard
 		double diffuseRadOfUpperHemisphere;
 		if (m_diffuseRadiationPerezEnabled) {
-			diffuseRadOfUpperHemisphere = diffuseRadiationPerez(inclinationAngle, incidenceAngle, diffuseRadHorizontal, directRadNormal);
+			diffuseRadOfUpperHemisphere = diffuseRadiationPerez(inclinationAngle, m_incidenceAngle[i], diffuseRadHorizontal, directRadNormal);
 		}
 		else {
 			diffuseRadOfUpperHemisphere = viewFactorToSky * diffuseRadHorizontal;
@@ -241,11 +304,80 @@ void SolarRadiationModel::setTime(int year, double secondsOfYear) {
 		// store values
 		m_qRadDir[i] = directRadOnSurface;
 		m_qRadDif[i] = diffuseRadOnSurface;
-		m_incidenceAngle[i] = incidenceAngle;
 	}
 }
 
 
+void SolarRadiationModel::computeRadiationTable(double tableStep) {
+	FUNCID(SolarRadiationModel::computeRadiationTable);
+
+	if (!m_climateDataLoader.m_dataTimePoints.empty())
+		throw IBK::Exception("Precomputed radiation table requires cyclic (annual) climate data.", FUNC_ID);
+	if (!(tableStep > 0 && tableStep <= 3600))
+		throw IBK::Exception(IBK::FormatString("Invalid step size %1 s for radiation table, expected a value "
+											   "in range ]0,3600] s.").arg(tableStep), FUNC_ID);
+
+	// discard existing table
+	m_radiationTableStep = 0;
+	m_radiationTable.clear();
+
+	// last row corresponds to a time point >= SECONDS_PER_YEAR, so that each time point of the year
+	// lies between two rows
+	unsigned int nRows = (unsigned int)std::ceil(SECONDS_PER_YEAR/tableStep) + 1;
+	unsigned int stride = 5 + 3*(unsigned int)m_surface.size();
+	std::vector<double> table((std::size_t)nRows*stride);
+
+#if defined(_OPENMP)
+#pragma omp parallel
+#endif
+	{
+		// updating the sun position modifies the model, hence each thread uses its own copy
+		SolarRadiationModel model(*this);
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+		for (int r=0; r<(int)nRows; ++r) {
+			double t = r*tableStep;
+			if (t >= SECONDS_PER_YEAR)
+				t -= SECONDS_PER_YEAR;
+			model.m_sunPositionModel.setTime(apparentSolarTimeFromLocalMeanTime(model.localMeanTimeFromLocalStandardTime(t)));
+			model.updateSurfaceGeometry();
+			double * row = &table[(std::size_t)r*stride];
+			row[0] = model.m_sunPositionModel.m_elevation;
+			row[1] = model.m_sunPositionModel.m_azimuth;
+			row[2] = model.m_sunPositionModel.m_declination;
+			row[3] = model.m_sinElevation;
+			row[4] = model.m_cosElevation;
+			for (unsigned int i = 0, j = 5; i < model.m_surface.size(); ++i, j += 3) {
+				row[j]   = model.m_surfaceNormalInVerticalRadDirection[i];
+				row[j+1] = model.m_cosIncidence[i];
+				row[j+2] = model.m_incidenceAngle[i];
+			}
+		}
+	}
+
+	m_radiationTable.swap(table);
+	m_radiationTableStep = tableStep;
+}
+
+
+void SolarRadiationModel::copyRadiationTable(const SolarRadiationModel & other) {
+	FUNCID(SolarRadiationModel::copyRadiationTable);
+
+	if (other.m_surface.size() != m_surface.size())
+		throw IBK::Exception("Cannot copy radiation table, mismatching number of surfaces.", FUNC_ID);
+	for (unsigned int i=0; i<m_surface.size(); ++i) {
+		if (!nearly_equal(m_surface[i].first, other.m_surface[i].first) ||
+			!nearly_equal(m_surface[i].second, other.m_surface[i].second))
+		{
+			throw IBK::Exception(IBK::FormatString("Cannot copy radiation table, mismatching surface #%1.").arg(i), FUNC_ID);
+		}
+	}
+	m_radiationTable = other.m_radiationTable;
+	m_radiationTableStep = other.m_radiationTableStep;
+}
+
+
 unsigned int SolarRadiationModel::addSurface(double orientation, double inclination) {
 	// search for existing surfaces with same orientation and inclination
 	//	\todo Compute scalar product between all normal vectors of already registered surfaces and the normal vector
@@ -260,8 +392,18 @@ unsigned int SolarRadiationModel::addSurface(double orientation, double inclinat
 			return i;
 		}
 	}
+	// table does not contain the new surface
+	m_radiationTableStep = 0;
+	m_radiationTable.clear();
 	// add new surface definition
 	m_surface.push_back( std::make_pair(orientation, inclination));
+	// cache inclination dependent quantities
+	m_cosInclination.push_back(std::cos(inclination));
+	double cosInclination2 = std::cos(0.5 * inclination);
+	m_viewFactorToSky.push_back(cosInclination2 * cosInclination2);
+	// add entries for sun position dependent geometry
+	m_surfaceNormalInVerticalRadDirection.push_back(0.0);
+	m_cosIncidence.push_back(0.0);
 	// add entry for incindent angle
 	m_incidenceAngle.push_back(0.0);
 	// add entry for direct and diffuse solar radiation
@@ -57,6 +57,12 @@ namespace CCM {
 	members m_sunPositionModel and m_climateDataLoader are also updated. The time correction
 	(local time to apparent solar time) for the sun position model is done automatically within
 	the setTime() function.
+
+	When computeRadiationTable() was called, setTime() no longer evaluates the sun position and the incidence
+	angles of the surfaces, but interpolates these values linearly in a table with all geometric quantities
+	precomputed on an equidistant annual time grid. Radiation loads are then computed from the interpolated
+	geometry and the current climate data, so that the sudden increase of direct radiation at sunrise is
+	resolved without smearing it across a table interval.
 */
 class SolarRadiationModel {
 public:
@@ -80,12 +86,32 @@ public:
 	*/
 	void setTime(int year, double secondsOfYear);
 
+	/*! Precomputes sun position and incidence angles of all surfaces on an equidistant time grid over one year.
+		Afterwards, setTime() interpolates these values from the table. When compiled with OpenMP, the table is
+		computed in parallel.
+		Call this function after all surfaces have been added and the climate data loader and sun position
+		model have been initialized.
+		\param tableStep Step size of the time grid in [s], must be in the range 0 < tableStep <= 3600.
+		\warning Throws an IBK::Exception for non-cyclic climate data.
+	*/
+	void computeRadiationTable(double tableStep);
+
+	/*! Copies the radiation table from another radiation model with the same surfaces (same order, orientation
+		and inclination). Used to share a precomputed table between several instances without recomputing it.
+		\warning Throws an IBK::Exception if the surfaces do not match.
+	*/
+	void copyRadiationTable(const SolarRadiationModel & other);
+
+	/*! Returns the step size of the radiation table in [s], 0 if no table has been computed. */
+	double radiationTableStep() const { return m_radiationTableStep; }
+
 	/*! Adds a new surface to compute radiation loads on.
 		\param orientation Orientation of surface (direction of normal vector of surface) in [rad], defined clockwise, 0 points north.
 		\param inclination Inclination of surface in [rad], flat roof has 0 rad (normal vector points upwards),
 						  wall has PI/2  (normal vector parallel to ground), surface facing downwards has inclination angle of PI.
 		\return Function returns an index of the surface that was just added, or the index of
 				an existing surface with same orientation and inclination.
+		\note Adding a new surface discards a previously computed radiation table.
 	*/
 	unsigned int addSurface(double orientation, double inclination);
 
@@ -184,11 +210,40 @@ private:
 	*/
 	double localMeanTimeFromLocalStandardTime( double secondsOfYear);
 
+	/*! Computes sine/cosine of sun elevation angle and the incidence angles of all surfaces from the current
+		state of the sun position model.
+	*/
+	void updateSurfaceGeometry();
+
+	/*! Sets sun position and the quantities computed in updateSurfaceGeometry() by linear interpolation in the
+		radiation table.
+	*/
+	void interpolateSurfaceGeometry(double secondsOfYear);
+
+	/*! Computes direct and diffuse radiation loads on all surfaces from the current climate data and
+		surface geometry.
+	*/
+	void updateRadiationLoads();
 
 	/*! Vector of surfaces to compute radiation loads on, first value in pair is the orientation,
 		second value in pair is the inclination (both in [rad]).
 	*/
 	std::vector< std::pair<double, double> >	m_surface;
+	/*! Cosine of inclination angle for each surface. */
+	std::vector<double>							m_cosInclination;
+	/*! View factor to sky for each surface. */
+	std::vector<double>							m_viewFactorToSky;
+
+	/*! Sine of sun elevation angle, updated in setTime(). */
+	double										m_sinElevation;
+	/*! Cosine of sun elevation angle, updated in setTime(). */
+	double										m_cosElevation;
+	/*! Projection of the surface normal onto the horizontal component of the sun direction vector,
+		for each surface, updated in setTime().
+	*/
+	std::vector<double>							m_surfaceNormalInVerticalRadDirection;
+	/*! Cosine of incidence angle (not clipped to positive values) for each surface, updated in setTime(). */
+	std::vector<double>							m_cosIncidence;
 
 	/*! Cached values for direct solar radiation in [W/m2] normal to each surface,
 		retrieve via member function radiationLoad()
@@ -209,6 +264,14 @@ private:
 	/*! Apparent solar time [s], updated in setTime() */
 	double										m_apparentSolarTime;
 
+	/*! Step size of radiation table in [s], 0 if no table is used. */
+	double										m_radiationTableStep;
+	/*! Radiation table computed in computeRadiationTable(). Each row holds elevation, azimuth, declination and
+		sine and cosine of elevation of the sun, followed by m_surfaceNormalInVerticalRadDirection, m_cosIncidence and
+		m_incidenceAngle for each surface. Row i corresponds to time point i*m_radiationTableStep (cyclic, wrapped into the year).
+	*/
+	std::vector<double>							m_radiationTable;
+
 
 };
 
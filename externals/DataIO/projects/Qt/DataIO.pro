@@ -23,6 +23,7 @@ INCLUDEPATH += \
 DEPENDPATH = $${INCLUDEPATH}
 
 SOURCES += ../../src/DATAIO_DataIO.cpp \
+	../../src/DATAIO_DataIOMappedReader.cpp \
 	../../src/DATAIO_Utils.cpp \
 	../../src/DATAIO_GeoFile.cpp \
 	../../src/DATAIO_Constants.cpp \
@@ -31,6 +32,7 @@ SOURCES += ../../src/DATAIO_DataIO.cpp \
 
 HEADERS += \
 	../../src/DATAIO_DataIO.h \
+	../../src/DATAIO_DataIOMappedReader.h \
 	../../src/DATAIO_Utils.h \
 	../../src/DATAIO_GeoFile.h \
 	../../src/DATAIO_Constants.h \
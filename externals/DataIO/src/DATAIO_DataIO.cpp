@@ -32,6 +32,7 @@
 
 #include "DATAIO_DataIO.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <numeric>
 #include <cmath>
@@ -47,6 +48,7 @@
 #include <IBK_Exception.h>
 #include <IBK_StopWatch.h>
 #include <IBK_FileReader.h>
+#include <IBK_NumberTableParser.h>
 #include <IBK_Time.h>
 #include <IBK_Version.h>
 #include <IBK_UnitList.h>
@@ -66,55 +68,6 @@
 
 namespace DATAIO {
 
-/*! Data processor used in FileReader for handling lines from data files.
-	It calls DataIO::addValueLine() in order to extract data and time points.
-	Additionally the line will be added to m_valueStrings vector for caching (inside addValueLine()).
-*/
-class FileReaderDataProcessorAddData : public IBK::AbstractFileReaderDataProcessor {
-public:
-	/*! Standard constructor. Takes a reference of an external line vector.
-		\param dataio Pointer to DataIO object to be filled.
-	*/
-	FileReaderDataProcessorAddData(DataIO* dataio);
-
-	/*! Adds a line to the line vector. Error is only possible in case of unsufficent memory.
-		\param line Line for processing.
-	*/
-	virtual void processLine( const std::string& line );
-
-	/*! Returns the number of time indexes (number of data vectors).
-		This function can be used for function in FileReader with maxlines parameter.
-		\return Returns number of lines/time indexes read so far.
-	*/
-	virtual int lineCount() const;
-
-private:
-	DataIO* m_dataio;	///< DataIO object.
-};
-
-FileReaderDataProcessorAddData::FileReaderDataProcessorAddData(DataIO* dataio) :
-	m_dataio(dataio)
-{
-}
-
-
-void FileReaderDataProcessorAddData::processLine(const std::string& line) {
-	FUNCID(FileReaderDataProcessorAddData::processLine);
-	try {
-		m_dataio->addValueLine(line);
-	}
-	catch (IBK::Exception & ex) {
-		throw IBK::Exception(ex, IBK::FormatString("Error extracting data from line '%1'.").arg(line), FUNC_ID);
-	}
-}
-
-
-int FileReaderDataProcessorAddData::lineCount() const {
-	return (int)m_dataio->m_timepoints.size();
-}
-// ----------------------------------------------------------------------------
-
-
 DataIO::DataIO() :
 	m_ofstream(nullptr),
 	m_geometryData(nullptr)
@@ -168,7 +121,6 @@ void DataIO::clear() {
 
 	m_timepoints.clear();
 	m_values.clear();
-	m_valueStrings.clear();
 	m_valueVector.clear();
 
 	delete m_ofstream;
@@ -296,21 +248,8 @@ const double * DataIO::data(unsigned int time_idx) const {
 	IBK_ASSERT(time_idx < m_timepoints.size());
 	IBK_ASSERT(m_timepoints.size() == m_values.size());
 	if (m_values[time_idx].empty()) {
-		if (!m_isBinary) {
-			// first access attempt, need to convert
-			IBK_ASSERT(time_idx < m_valueStrings.size());
-			m_values[time_idx].reserve(m_nValues);
-			IBK::string2valueVector(m_valueStrings[time_idx], m_values[time_idx]);
-			if (m_values[time_idx].size() != m_nValues) {
-				throw IBK::Exception(IBK::FormatString("Not enough values for time index %1 in output file, "
-					"only got %2 values, but needed %3.")
-					.arg(time_idx)
-					.arg((unsigned int)m_values[time_idx].size())
-					.arg(m_nValues), FUNC_ID);
-			}
-			std::string().swap(m_valueStrings[time_idx]); // replace with empty string so that memory is freed.
-		}
-		else {
+		// ASCII files are parsed completely in read(), so only data for binary files is read on demand
+		if (m_isBinary) {
 #ifndef READ_FULL_FILE
 			// open output file
 #if defined(_WIN32)
@@ -360,16 +299,6 @@ void DataIO::deleteData(unsigned int idxFrom, unsigned int idxTo) {
 		///		  later vectors will be swapped (pointer-change) bit-by-bit with earlier vectors.
 		m_values.erase(values_it1);
 
-		// for ASCII format we need to erase m_valueStrings as well
-		if (!m_valueStrings.empty()) {
-			// ASCII format sanity checks
-			IBK_ASSERT(idxTo < m_valueStrings.size());
-			IBK_ASSERT(idxFrom < m_valueStrings.size());
-
-			std::vector< std::string >::iterator values_it1 = m_valueStrings.begin() + idxFrom;
-			m_valueStrings.erase(values_it1);
-		}
-
 		std::vector<double>::iterator timepoints_it1 = m_timepoints.begin() + idxFrom;
 		m_timepoints.erase(timepoints_it1);
 	}
@@ -381,16 +310,6 @@ void DataIO::deleteData(unsigned int idxFrom, unsigned int idxTo) {
 		std::vector< std::vector<double> >::iterator values_it2 = m_values.begin() + idxTo+1;
 		m_values.erase(values_it1,values_it2);
 
-		if (!m_valueStrings.empty()) {
-			// ASCII format sanity checks
-			IBK_ASSERT(idxTo < m_valueStrings.size());
-			IBK_ASSERT(idxFrom < m_valueStrings.size());
-
-			std::vector< std::string >::iterator values_it1 = m_valueStrings.begin() + idxFrom;
-			std::vector< std::string >::iterator values_it2 = m_valueStrings.begin() + idxTo+1;
-			m_valueStrings.erase(values_it1,values_it2);
-		}
-
 		std::vector<double>::iterator timepoints_it1 = m_timepoints.begin() + idxFrom;
 		std::vector<double>::iterator timepoints_it2 = m_timepoints.begin() + idxTo+1;
 		m_timepoints.erase(timepoints_it1,timepoints_it2);
@@ -416,7 +335,6 @@ void DataIO::setData(const std::vector<double> & timePoints,
 	else {
 		m_nValues = 0;
 	}
-	m_valueStrings.clear();
 	m_valueVector.clear();
 	m_timepoints = timePoints;
 	m_values = values;
@@ -441,7 +359,6 @@ void DataIO::swapData(std::vector<double> & timePoints,
 	else {
 		m_nValues = 0;
 	}
-	m_valueStrings.clear();
 	m_valueVector.clear();
 	m_timepoints.swap(timePoints);
 	m_values.swap(values);
@@ -1017,7 +934,7 @@ void DataIO::openAndReadHeader(const IBK::Path & fname, std::ifstream & in, IBK:
 	try {
 
 		in.seekg(0, std::ios_base::end);
-		m_fileSize = (unsigned int)in.tellg();
+		m_fileSize = (int64_t)in.tellg();
 		in.seekg(0, std::ios_base::beg);
 		m_dataSectionOffset = 0;
 
@@ -1350,23 +1267,23 @@ void DataIO::readBinaryData(std::istream& in, IBK::NotificationHandler * notify)
 		// cache time unit
 		m_cachedTimeUnit.set(m_timeUnit); // this may throw an exception, if m_timeUnit is invalid
 
+		// all records have the same size, so the number of complete records follows from the file size;
+		// an incomplete trailing record (file is concurrently written) is skipped
+		int64_t recordSize = (1 + (int64_t)m_nValues)*(int64_t)sizeof(double);
+		unsigned int nRecords = (unsigned int)((m_fileSize - m_dataSectionOffset)/recordSize);
+
 		IBK::UnitVector tpVec;
-		// check stream flags in addition to isBinary flag
-		while (in) {
-			unsigned int pos = (unsigned int)in.tellg();
-			if (notify)
-				notify->notify(double(pos)/m_fileSize);
+		tpVec.m_data.resize(nRecords);
+		m_values.resize(nRecords);
+		for (unsigned int i=0; i<nRecords; ++i) {
+			if (notify && i % 1000 == 0)
+				notify->notify(double(m_dataSectionOffset + i*recordSize)/m_fileSize);
 			// read timepoint
-			double tmp;
-			in.read(reinterpret_cast<char *>(&tmp), sizeof(double));
-			/// \todo handle incomplete reads (when file is concurrently written)
-			if (in.eof()) break; // nothing more to read, abort
-			// convert output time into correct output unit
-			tpVec.m_data.push_back(tmp);
-			// add empty vector
-			m_values.push_back(std::vector<double>());
+			in.read(reinterpret_cast<char *>(&tpVec.m_data[i]), sizeof(double));
 			// seek to next record
 			in.seekg(sizeof(double) * m_nValues, std::ios_base::cur);
+			if (!in)
+				throw IBK::Exception(IBK::FormatString("Error reading time point #%1.").arg(i), FUNC_ID);
 		}
 		// convert time points into seconds
 		tpVec.m_unit = m_cachedTimeUnit;
@@ -1590,16 +1507,50 @@ void DataIO::readASCIIData(const IBK::Path & fname, IBK::NotificationHandler * n
 		IBK::StopWatch w;
 #endif
 
-		FileReaderDataProcessorAddData dataProcessor(this);
-		long long pos = IBK::FileReader::readAll(fname, &dataProcessor, std::vector<std::string>(), m_dataSectionOffset, notify);
+		// read complete file in one go
+#if defined(_WIN32) && !defined(__MINGW32__)
+		std::ifstream in(fname.wstr().c_str(), std::ios_base::binary);
+#else
+		std::ifstream in(fname.str().c_str(), std::ios_base::binary);
+#endif // _WIN32
+		if (!in)
+			throw IBK::Exception( IBK::FormatString("Cannot open file '%1'").arg(fname), FUNC_ID);
+		in.seekg(0, std::ios_base::end);
+		std::streamoff fileSize = in.tellg();
+		in.seekg(0, std::ios_base::beg);
+		std::string content((std::size_t)fileSize, '\0');
+		if (fileSize > 0)
+			in.read(&content[0], (std::streamsize)fileSize);
+		if (!in)
+			throw IBK::Exception("Error reading file.", FUNC_ID);
+		if (m_dataSectionOffset > content.size())
+			throw IBK::Exception("Invalid data section offset.", FUNC_ID);
+
+		// parse data section, each line holds time point and values
+		IBK::NumberTableParser parser;
+		parser.m_separationCharacter = ' ';
+		parser.m_nColumns = m_nValues + 1;
+		unsigned int firstLineNumber = 1 + (unsigned int)std::count(content.begin(), content.begin() + m_dataSectionOffset, '\n');
+		std::vector<std::vector<double> > rows;
+		parser.parse(content.data() + m_dataSectionOffset, content.data() + content.size(), firstLineNumber, rows, notify);
+
+		// split time points and values
+		IBK::UnitVector tpVec;
+		tpVec.m_data.resize(rows.size());
+		m_values.resize(rows.size());
+		for (unsigned int i=0; i<rows.size(); ++i) {
+			tpVec.m_data[i] = rows[i][0];
+			rows[i].erase(rows[i].begin());
+			m_values[i].swap(rows[i]);
+		}
+		// convert time points into seconds
+		tpVec.m_unit = m_cachedTimeUnit;
+		tpVec.convert( IBK::Unit(IBK_UNIT_ID_SECONDS) ); // may throw an exception if m_timeUnit is not a time unit
+		m_timepoints.swap(tpVec.m_data);
 
 #ifdef SPEED_RATING_MESSAGES
 		std::cout << "Time for reading and extracting data: " << w.diff_str() << std::endl;
 #endif
-
-		if (pos == -1) {
-			throw IBK::Exception("Error reading file with FileReader.", FUNC_ID);
-		}
 	}
 	catch (IBK::Exception & ex) {
 		throw IBK::Exception(ex, "Error reading ASCII data.", FUNC_ID);
@@ -1608,42 +1559,6 @@ void DataIO::readASCIIData(const IBK::Path & fname, IBK::NotificationHandler * n
 // ----------------------------------------------------------------------------
 
 
-void DataIO::addValueLine(const std::string & line) {
-	FUNCID(DataIO::addValueLine);
-	// skip empty lines
-
-	if (line.find_first_not_of(" \t") == std::string::npos)
-		return;
-	// if we get here, we are reading the value section already
-	// we need to extract the first number
-	bool number = false;
-	unsigned int j=0;
-	for (; j<line.size(); ++j) {
-		if (line[j]==' ' || line[j] == '\t') {
-			if (number)
-				break;
-		}
-		else {
-			number = true;
-		}
-	}
-	std::stringstream tp_strm(line.substr(0,j));
-	double tp;
-	if (!(tp_strm >> tp))
-		throw IBK::Exception( IBK::FormatString("Error parsing time point from line '%1', using substr '%2'.").arg(line).arg(line.substr(0,j)), FUNC_ID);
-	// convert output time into correct output unit
-	IBK::UnitList::instance().convert( m_cachedTimeUnit, IBK::Unit(IBK_UNIT_ID_SECONDS), tp);
-
-	m_timepoints.push_back(tp);
-
-	m_valueStrings.push_back(std::string(line.c_str() + j));
-	m_values.push_back(std::vector<double>());
-
-	// Note: the parsing of the string is delayed until access
-}
-// ----------------------------------------------------------------------------
-
-
 void DataIO::checkDataConsistency() const {
 	FUNCID(DataIO::checkDataConsistency);
 	// check data
@@ -66,8 +66,8 @@ class GeoFile;
 	a spatial location. The mapping is done through the data in the corresponding geometry file, see DATAIO::GeoFile.
 
 	Reading and writing of complete DataIO containers is done through member functions read() and write(). These functions
-	read and write data in binary mode and are very fast. When the original file is present in ASCII encoding, the data is
-	read as set of lines containing the actual data. When writing large data sets incrementally
+	read and write data in binary mode and are very fast. When the original file is present in ASCII encoding, the
+	data section is parsed completely during read() (concurrently, when compiled with OpenMP). When writing large data sets incrementally
 	(when the simulation progresses), the output file stream is first opened
 	using writeHeader() and afterwards data is appended with appendData().
 
@@ -168,11 +168,9 @@ public:
 		Otherwise:
 		- for binary files, if data is requested the first time, the file is opened, and the requested chunk of data is read
 		into internal storage memory and a pointer to this memory is returned.
-		- for ASCII files, the previously read string with the numbers for this time index is parsed into internal storage memory,
-		and a pointer to this memory is returned.
+		- for ASCII files, all values have been parsed already in read().
 
-		Throws an IBK::Exception when data cannot be retrieved, for example when time_idx is invalid or file cannot be accessed or
-		conversion of string to values fails.
+		Throws an IBK::Exception when data cannot be retrieved, for example when time_idx is invalid or file cannot be accessed.
 
 		\param time_idx		The index of the time point, must be less than m_timepoints.size()
 		\return				Returns a pointer to a memory array holding nValues() numbers. The pointer remains valid as
@@ -192,8 +190,7 @@ public:
 	void deleteData(unsigned int idxFrom, unsigned int idxTo);
 
 	/*! Sets new data in the data container.
-		This function will replace the internally stored timePoints and values vectors and
-		also clear the m_valueStrings vector with cached string data (ASCII files only).
+		This function will replace the internally stored timePoints and values vectors.
 		The variable m_nValues (accessible with nValues()) will be reset based on the number of values in the values[0] vector.
 		The function will throw an IBK::Exception if size of timePoints and values vectors mismatch, or if the
 		vectors inside the values vector have different length.
@@ -388,8 +385,8 @@ public:
 	/*! Returns a read-only vector with values.
 		The vector has the same size as m_timepoints.
 
-		\warning The elements of the vector (which are vectors of values themselves) may
-			be empty. Use data() to access values still need to be parsed. Accessing all values with
+		\warning For binary files, the elements of the vector (which are vectors of values themselves) may
+			be empty. Use data() to access values still need to be read. Accessing all values with
 			this function may be done savely, when data() had been called for all time indexes already.
 	*/
 	const std::vector< std::vector<double> > & values() const { return m_values; }
@@ -567,7 +564,9 @@ private:
 
 		Starts parsing the data section from m_dataSectionOffset (which must have been
 		computed in readBinaryHeader()). This function can be used to refresh the data
-		when the file was extended.
+		when the file was extended. Only complete records are read.
+		\note For random access to large files, use DataIOMappedReader, which does not
+			traverse the data section.
 
 		\param in Input file stream (as binary file stream).
 		\param notify Pointer to notification handler (pass NULL to disable notification calls).
@@ -585,24 +584,15 @@ private:
 	*/
 	void readASCIIHeader(const IBK::Path &fname, IBK::NotificationHandler * notify);
 
-	/*! Reads the complete file, which must be in ASCII format.
+	/*! Reads the complete data section of the file, which must be in ASCII format.
 
-		The file is read from the begin, but the header data is ignored and only data from
-		the data section is kept.
+		The data section (starting at m_dataSectionOffset) is read in one go and parsed with IBK::NumberTableParser
+		into m_timepoints and m_values. Each line must hold the time point followed by nValues() values.
 		\param fname The file path to the input file.
 		\param notify Pointer to notification handler (pass NULL to disable notification calls).
 	*/
 	void readASCIIData(const IBK::Path &fname, IBK::NotificationHandler * notify);
 
-	/*! Utility function for read algorithm.
-
-		The function extracts the time point from the line and appends it to m_timepoints. The remaining string is appended
-		to m_valueStrings. An empty vector is appended to the m_values vector to keep the size of m_values and m_valueStrings
-		consistent. The parsing of the string into values is delayed until accessing of values with data().
-		\param line The line to parse in format '<time point> <value1> <value2> ...'.
-	*/
-	void addValueLine(const std::string & line);
-
 	/*! Checks if m_timepoints vector and m_values vector have the same length, also checks that m_nValues and size
 		of vectors in m_values matches.
 		Throws an Exception if any of the conditions fails.
@@ -644,7 +634,7 @@ private:
 
 	/*! Vector with values.
 		The vector has the same size as m_timepoints. The elements of the vector (which are vectors of values themselves) may
-		be empty and are read only, when the values have been parsed already.
+		be empty for binary files and are read only on first access in data().
 		\note This vector is mutable so that we can use lazy-evaluation in a const DataIO object.
 	*/
 	mutable std::vector< std::vector<double> > 	m_values;
@@ -660,16 +650,8 @@ private:
 	*/
 	mutable std::vector<double>			m_valueVector;
 
-	/*! Vector with strings read from ASCII output files.
-		Initially, ASCII files are read as binary files as well, and stored inside the m_valueStrings vector.
-		Upon a call to data(), a string is parsed and converted into values, stored in the m_values vector and the string
-		is cleared. This way the time consuming string parsing is delayed and only executed on demand.
-		\note This vector is mutable so that we can use lazy-evaluation in a const DataIO object.
-	*/
-	mutable std::vector< std::string > 	m_valueStrings;
-
-	/*! Used during reading to report the progress. */
-	unsigned int						m_fileSize;
+	/*! File size in bytes, used during reading to report the progress and to determine the number of records. */
+	int64_t								m_fileSize;
 
 	/*! Holds the data format represented by the DataIO container.
 		Initially this is set to NUM_DF, but updated in determineDataFormat().
@@ -698,7 +680,7 @@ private:
 
 	// *** friend classes ***
 
-	friend class FileReaderDataProcessorAddData; ///< Necessary for using addValueLine() in data processor.
+	friend class DataIOMappedReader; ///< Necessary for accessing m_dataSectionOffset.
 
 };
 
@@ -0,0 +1,282 @@
+/*	DataIO library
+	Copyright (c) 2001-2016, Institut fuer Bauklimatik, TU Dresden, Germany
+
+	Written by A. Nicolai, St. Vogelsang
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without modification,
+	are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	   list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	   this list of conditions and the following disclaimer in the documentation
+	   and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	   may be used to endorse or promote products derived from this software without
+	   specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+	ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+	(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+	ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+	SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "DATAIO_DataIOMappedReader.h"
+
+#include <IBK_Exception.h>
+#include <IBK_FormatString.h>
+#include <IBK_UnitList.h>
+#include <IBK_assert.h>
+
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif // defined(_WIN32)
+
+namespace DATAIO {
+
+void DataIOMappedReader::View::copyTo(double * target) const {
+	if (m_stride == sizeof(double))
+		std::memcpy(target, m_data, m_size*sizeof(double));
+	else {
+		for (unsigned int i=0; i<m_size; ++i)
+			std::memcpy(target + i, m_data + i*m_stride, sizeof(double));
+	}
+}
+// ----------------------------------------------------------------------------
+
+
+DataIOMappedReader::DataIOMappedReader() :
+	m_dataSectionOffset(0),
+	m_timeUnitFactor(1),
+	m_mappedData(nullptr),
+	m_mappedSize(0),
+#if defined(_WIN32)
+	m_fileHandle(INVALID_HANDLE_VALUE),
+	m_mappingHandle(nullptr),
+#else
+	m_fileDescriptor(-1),
+#endif // defined(_WIN32)
+	m_nTimePoints(0),
+	m_lastTimePoint(0)
+{
+}
+// ----------------------------------------------------------------------------
+
+
+DataIOMappedReader::~DataIOMappedReader() {
+	unmapFile();
+}
+// ----------------------------------------------------------------------------
+
+
+void DataIOMappedReader::open(const IBK::Path & fname) {
+	FUNCID(DataIOMappedReader::open);
+
+	close();
+	// read header only, this also checks file format and version
+	m_header.read(fname, true);
+	if (!m_header.m_isBinary)
+		throw IBK::Exception(IBK::FormatString("File '%1' is not a binary DataIO file.").arg(fname), FUNC_ID);
+	m_dataSectionOffset = m_header.m_dataSectionOffset;
+
+	// determine conversion factor for time points
+	try {
+		m_timeUnitFactor = 1;
+		IBK::UnitList::instance().convert(IBK::Unit(m_header.m_timeUnit), IBK::Unit(IBK_UNIT_ID_SECONDS), m_timeUnitFactor);
+	}
+	catch (IBK::Exception & ex) {
+		throw IBK::Exception(ex, IBK::FormatString("Invalid time unit '%1' in file '%2'.")
+							 .arg(m_header.m_timeUnit).arg(fname), FUNC_ID);
+	}
+
+	mapFile();
+}
+// ----------------------------------------------------------------------------
+
+
+void DataIOMappedReader::close() {
+	unmapFile();
+	m_timePoints.clear();
+}
+// ----------------------------------------------------------------------------
+
+
+unsigned int DataIOMappedReader::refresh() {
+	FUNCID(DataIOMappedReader::refresh);
+	if (!isOpen())
+		throw IBK::Exception("No file opened.", FUNC_ID);
+	unsigned int nTimePointsOld = m_nTimePoints;
+	// the current mapping must not be accessed anymore, if the file has been truncated meanwhile
+	// reading from it fails (SIGBUS); mapFile() keeps copies of the data needed to detect a rewritten file
+	std::string headerData;
+	headerData.swap(m_headerData);
+	double lastTimePoint = m_lastTimePoint;
+
+	// re-map the whole file, the already built time index remains valid as long as records are only appended
+	unmapFile();
+	bool appended = false;
+	try {
+		mapFile();
+		appended = m_nTimePoints >= nTimePointsOld && m_headerData == headerData &&
+				   (nTimePointsOld == 0 ||
+					std::memcmp(m_mappedData + m_dataSectionOffset + (nTimePointsOld-1)*recordSize(),
+								&lastTimePoint, sizeof(double)) == 0);
+	}
+	catch (IBK::Exception &) {
+		// file is now shorter than the previous header section, re-read below
+	}
+	if (!appended) {
+		// file has been rewritten (e.g. restarted simulation), possibly with a different header:
+		// read header again and rebuild time index
+		IBK::Path fname = m_header.m_filename;
+		try {
+			open(fname);
+		}
+		catch (IBK::Exception & ex) {
+			throw IBK::Exception(ex, IBK::FormatString("Error re-reading rewritten file '%1'.").arg(fname), FUNC_ID);
+		}
+		return m_nTimePoints;
+	}
+	return m_nTimePoints - nTimePointsOld;
+}
+// ----------------------------------------------------------------------------
+
+
+const std::vector<double> & DataIOMappedReader::timePoints() const {
+	// extend time index by all records not yet processed
+	if (m_timePoints.size() < m_nTimePoints) {
+		std::size_t recSize = recordSize();
+		const char * rec = m_mappedData + m_dataSectionOffset + m_timePoints.size()*recSize;
+		std::size_t i = m_timePoints.size();
+		m_timePoints.resize(m_nTimePoints);
+		for (; i<m_nTimePoints; ++i, rec += recSize) {
+			double t;
+			std::memcpy(&t, rec, sizeof(double));
+			m_timePoints[i] = t*m_timeUnitFactor;
+		}
+	}
+	return m_timePoints;
+}
+// ----------------------------------------------------------------------------
+
+
+DataIOMappedReader::Row DataIOMappedReader::row(unsigned int timeIdx) const {
+	IBK_ASSERT(timeIdx < m_nTimePoints);
+	return Row(m_mappedData + m_dataSectionOffset + timeIdx*recordSize() + sizeof(double),
+			   nValues(), sizeof(double));
+}
+// ----------------------------------------------------------------------------
+
+
+DataIOMappedReader::Column DataIOMappedReader::column(unsigned int valueIdx) const {
+	IBK_ASSERT(valueIdx < nValues());
+	return Column(m_mappedData + m_dataSectionOffset + (1 + valueIdx)*sizeof(double),
+				  m_nTimePoints, recordSize());
+}
+// ----------------------------------------------------------------------------
+
+
+void DataIOMappedReader::mapFile() {
+	FUNCID(DataIOMappedReader::mapFile);
+
+	const IBK::Path & fname = m_header.m_filename;
+	std::size_t fileSize = 0;
+
+#if defined(_WIN32)
+	HANDLE fileHandle = CreateFileW(fname.wstr().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+									nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		throw IBK::Exception(IBK::FormatString("Cannot open file '%1'.").arg(fname), FUNC_ID);
+	m_fileHandle = fileHandle;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(fileHandle, &size)) {
+		unmapFile();
+		throw IBK::Exception(IBK::FormatString("Cannot determine size of file '%1'.").arg(fname), FUNC_ID);
+	}
+	fileSize = (std::size_t)size.QuadPart;
+	HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr) {
+		unmapFile();
+		throw IBK::Exception(IBK::FormatString("Cannot map file '%1' into memory.").arg(fname), FUNC_ID);
+	}
+	m_mappingHandle = mappingHandle;
+	const void * data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr) {
+		unmapFile();
+		throw IBK::Exception(IBK::FormatString("Cannot map file '%1' into memory.").arg(fname), FUNC_ID);
+	}
+#else
+	m_fileDescriptor = ::open(fname.c_str(), O_RDONLY);
+	if (m_fileDescriptor == -1)
+		throw IBK::Exception(IBK::FormatString("Cannot open file '%1'.").arg(fname), FUNC_ID);
+	struct stat fileStat;
+	if (fstat(m_fileDescriptor, &fileStat) != 0) {
+		unmapFile();
+		throw IBK::Exception(IBK::FormatString("Cannot determine size of file '%1'.").arg(fname), FUNC_ID);
+	}
+	fileSize = (std::size_t)fileStat.st_size;
+	void * data = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, m_fileDescriptor, 0);
+	if (data == MAP_FAILED) {
+		unmapFile();
+		throw IBK::Exception(IBK::FormatString("Cannot map file '%1' into memory.").arg(fname), FUNC_ID);
+	}
+	// values are typically processed in file order
+	madvise(data, fileSize, MADV_SEQUENTIAL);
+#endif // defined(_WIN32)
+
+	m_mappedData = static_cast<const char *>(data);
+	m_mappedSize = fileSize;
+
+	// number of complete records, an incomplete trailing record (file being written) is ignored
+	if (m_mappedSize < m_dataSectionOffset) {
+		unmapFile();
+		throw IBK::Exception(IBK::FormatString("File '%1' is truncated.").arg(fname), FUNC_ID);
+	}
+	m_nTimePoints = (unsigned int)((m_mappedSize - m_dataSectionOffset)/recordSize());
+
+	// copies of header section and last time point, needed in refresh()
+	m_headerData.assign(m_mappedData, m_dataSectionOffset);
+	if (m_nTimePoints > 0)
+		std::memcpy(&m_lastTimePoint, m_mappedData + m_dataSectionOffset + (m_nTimePoints-1)*recordSize(), sizeof(double));
+}
+// ----------------------------------------------------------------------------
+
+
+void DataIOMappedReader::unmapFile() {
+#if defined(_WIN32)
+	if (m_mappedData != nullptr)
+		UnmapViewOfFile(m_mappedData);
+	if (m_mappingHandle != nullptr)
+		CloseHandle(m_mappingHandle);
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(m_fileHandle);
+	m_mappingHandle = nullptr;
+	m_fileHandle = INVALID_HANDLE_VALUE;
+#else
+	if (m_mappedData != nullptr)
+		munmap(const_cast<char *>(m_mappedData), m_mappedSize);
+	if (m_fileDescriptor != -1)
+		::close(m_fileDescriptor);
+	m_fileDescriptor = -1;
+#endif // defined(_WIN32)
+	m_mappedData = nullptr;
+	m_mappedSize = 0;
+	m_nTimePoints = 0;
+}
+// ----------------------------------------------------------------------------
+
+} // namespace DATAIO
@@ -0,0 +1,216 @@
+/*	DataIO library
+	Copyright (c) 2001-2016, Institut fuer Bauklimatik, TU Dresden, Germany
+
+	Written by A. Nicolai, St. Vogelsang
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without modification,
+	are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	   list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	   this list of conditions and the following disclaimer in the documentation
+	   and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	   may be used to endorse or promote products derived from this software without
+	   specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+	ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+	(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+	ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+	SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DATAIO_DataIOMappedReaderH
+#define DATAIO_DataIOMappedReaderH
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <IBK_Path.h>
+
+#include "DATAIO_DataIO.h"
+
+namespace DATAIO {
+
+/*! \brief Read-only random access to binary DataIO files through a memory-mapped file.
+
+	The class is meant for post-processing of (very) large binary output files. Unlike DataIO::read(),
+	opening a file only reads the header and maps the file into memory, the data section is never
+	traversed. Since each record of the data section has the same size (time point followed by nValues() values),
+	the number of time points follows from the file size and all values can be accessed directly.
+
+	Time points are converted to seconds on first access (lazy time index) and only for the records not yet indexed,
+	values are accessed without copying through Row and Column views.
+
+	Files that are still being written by a solver can be monitored with refresh(), which maps the grown file
+	and makes the new records available. A trailing incomplete record (the solver is still writing it) is ignored.
+	If the file has been rewritten from the beginning (e.g. restarted simulation), refresh() re-reads the header.
+	Mind: when the file is truncated, data of the previous mapping must not be accessed until refresh() was called.
+
+	\code
+	DATAIO::DataIOMappedReader reader;
+	reader.open(IBK::Path("results/states/Temperatures.d6b"));
+	// header data is available through header()
+	std::cout << reader.header().m_quantity << std::endl;
+	// column view of values of a single element
+	DATAIO::DataIOMappedReader::Column col = reader.column(12);
+	for (unsigned int i=0; i<col.size(); ++i)
+		std::cout << reader.timePoint(i) << "\t" << col[i] << std::endl;
+	// later, after the solver has appended new outputs
+	unsigned int newTimePoints = reader.refresh();
+	\endcode
+
+	\note Only binary files (DELPHIN 5 and DELPHIN 6 format) are supported. Views and pointers returned by the
+		  reader become invalid after refresh() and close().
+*/
+class DataIOMappedReader {
+public:
+	/*! Read-only view of values with constant stride in the mapped data section.
+		Values are read with memcpy, because the data section of a DataIO file does not start
+		at an 8-byte-aligned offset.
+	*/
+	class View {
+	public:
+		View() : m_data(nullptr), m_size(0), m_stride(0) {}
+		View(const char * data, unsigned int size, std::size_t stride) : m_data(data), m_size(size), m_stride(stride) {}
+
+		/*! Number of values in view. */
+		unsigned int size() const { return m_size; }
+		/*! Returns value at index i. */
+		double operator[](unsigned int i) const {
+			double val;
+			std::memcpy(&val, m_data + i*m_stride, sizeof(double));
+			return val;
+		}
+		/*! Copies all values of the view into the target memory array (must hold size() values). */
+		void copyTo(double * target) const;
+
+	private:
+		/*! Pointer to first value in mapped memory. */
+		const char *		m_data;
+		/*! Number of values. */
+		unsigned int		m_size;
+		/*! Distance in bytes between two values. */
+		std::size_t			m_stride;
+	};
+
+	/*! All values of a single time point. */
+	typedef View Row;
+	/*! Values of a single output (element/side/reference) for all time points. */
+	typedef View Column;
+
+	/*! Default constructor. */
+	DataIOMappedReader();
+	/*! Destructor, releases the mapping. */
+	~DataIOMappedReader();
+
+	/*! Reads the header of a binary DataIO file and maps the file into memory.
+		A previously opened file is closed. Throws an IBK::Exception in case of error.
+		\param fname File path to DataIO container file.
+	*/
+	void open(const IBK::Path & fname);
+
+	/*! Releases the mapping and clears the time index. */
+	void close();
+
+	/*! Re-maps the file so that records appended since open() or the last refresh() become available.
+		If the file has been rewritten in the meantime (header data changed, fewer records, or the time point
+		of the last known record changed), the header is read again and the time index is rebuilt. In this
+		case all records of the file count as new. Throws an IBK::Exception if the file cannot be read, the
+		reader is closed in this case.
+		\return Returns the number of new time points (0 if the file did not grow by at least one complete record).
+	*/
+	unsigned int refresh();
+
+	/*! Returns true if a file is mapped. */
+	bool isOpen() const { return m_mappedData != nullptr; }
+
+	/*! Header data of the file (no data is held in the returned DataIO container). */
+	const DataIO & header() const { return m_header; }
+
+	/*! Number of values stored for each time point. */
+	unsigned int nValues() const { return m_header.nValues(); }
+
+	/*! Number of (complete) records/time points in the mapped file. */
+	unsigned int nTimePoints() const { return m_nTimePoints; }
+
+	/*! Returns time point with index timeIdx in [s]. */
+	double timePoint(unsigned int timeIdx) const { return timePoints()[timeIdx]; }
+
+	/*! Returns all time points in [s].
+		The time index is built on first access and extended incrementally after refresh().
+	*/
+	const std::vector<double> & timePoints() const;
+
+	/*! Returns a view on all values of time point with index timeIdx. */
+	Row row(unsigned int timeIdx) const;
+
+	/*! Returns a view on values with index valueIdx for all time points. */
+	Column column(unsigned int valueIdx) const;
+
+private:
+	/*! Copy constructor is disabled (object holds file mapping resource). */
+	DataIOMappedReader(const DataIOMappedReader &);
+	/*! Assignment operator is disabled (object holds file mapping resource). */
+	const DataIOMappedReader& operator=(const DataIOMappedReader &);
+
+	/*! Maps the file m_header.m_filename into memory and updates m_nTimePoints. */
+	void mapFile();
+	/*! Releases file mapping. */
+	void unmapFile();
+	/*! Size of a record (time point and values) in bytes. */
+	std::size_t recordSize() const { return (1 + (std::size_t)m_header.nValues())*sizeof(double); }
+
+	/*! DataIO container holding the header data. */
+	DataIO								m_header;
+	/*! Offset of data section in file. */
+	std::size_t							m_dataSectionOffset;
+	/*! Factor to convert time points in file to seconds. */
+	double								m_timeUnitFactor;
+
+	/*! Pointer to begin of mapped file, nullptr if no file is mapped. */
+	const char							*m_mappedData;
+	/*! Size of mapped file in bytes. */
+	std::size_t							m_mappedSize;
+#if defined(_WIN32)
+	/*! File handle (HANDLE). */
+	void								*m_fileHandle;
+	/*! File mapping handle (HANDLE). */
+	void								*m_mappingHandle;
+#else
+	/*! File descriptor. */
+	int									m_fileDescriptor;
+#endif // defined(_WIN32)
+
+	/*! Number of complete records in mapped file. */
+	unsigned int						m_nTimePoints;
+
+	/*! Copy of the header section of the mapped file, used in refresh() to detect a rewritten file. */
+	std::string							m_headerData;
+	/*! Time point (raw value in file) of the last complete record, used in refresh() to detect a rewritten file. */
+	double								m_lastTimePoint;
+
+	/*! Time points in [s], populated on demand in timePoints().
+		\note This vector is mutable so that we can use lazy-evaluation in a const object.
+	*/
+	mutable std::vector<double>			m_timePoints;
+};
+
+} // namespace DATAIO
+
+/*! \file DATAIO_DataIOMappedReader.h
+	\brief Contains the declaration of the class DataIOMappedReader.
+*/
+
+#endif // DATAIO_DataIOMappedReaderH
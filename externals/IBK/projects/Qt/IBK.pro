@@ -53,6 +53,7 @@ SOURCES += \
 	../../src/IBK_MessageHandler.cpp \
 	../../src/IBK_Path.cpp \
 	../../src/IBK_CSVReader.cpp \
+	../../src/IBK_NumberTableParser.cpp \
 	../../src/IBK_physics.cpp \
 	../../src/IBK_Version.cpp \
 	../../src/IBK_system.cpp \
@@ -114,6 +115,7 @@ HEADERS += \
 	../../src/IBK_MessageHandler.h \
 	../../src/IBK_ScalarFunction.h \
 	../../src/IBK_CSVReader.h \
+	../../src/IBK_NumberTableParser.h \
 	../../src/IBK_openMP.h \
 	../../src/IBK_Version.h \
 	../../src/IBK_system.h \
@@ -50,11 +50,20 @@
 #include "IBK_messages.h"
 #include "IBK_StringUtils.h"
 #include "IBK_FormatString.h"
+#include "IBK_InputOutput.h"
+#include "IBK_NumberTableParser.h"
+#include "IBK_Version.h"
 
 using namespace std;
 
 namespace IBK {
 
+const unsigned int CSVReader::BINARY_TABLE_MAGIC_NUMBER_FIRST = 0x46544249;	// 'IBTF'
+const unsigned int CSVReader::BINARY_TABLE_MAGIC_NUMBER_SECOND = 0x4C424154;	// 'TABL'
+const unsigned int CSVReader::BINARY_TABLE_VERSION_MAJOR = 1;
+const unsigned int CSVReader::BINARY_TABLE_VERSION_MINOR = 0;
+
+
 bool CSVReader::haveTabSeparationChar(const IBK::Path & filename) {
 	FUNCID(CSVReader::haveTabSeparationChar);
 	// first detect file format
@@ -97,6 +106,18 @@ bool CSVReader::haveTabSeparationChar(const IBK::Path & filename) {
 
 void CSVReader::read(const IBK::Path & filename, bool headerOnly, bool extractUnits) {
 	FUNCID(CSVReader::read);
+	// binary table files
+	if (IBK::tolower_string(filename.extension()) == "btf") {
+		try {
+			readBinary(filename, headerOnly);
+		}
+		catch (IBK::Exception & ex) {
+			throw IBK::Exception( ex, IBK::FormatString("Error reading file '%1'.").arg(filename), FUNC_ID);
+		}
+		if (extractUnits)
+			extractUnitsFromCaptions();
+		return;
+	}
 	try {
 #if defined(_WIN32)
 	#if defined(_MSC_VER)
@@ -122,59 +143,125 @@ void CSVReader::read(const IBK::Path & filename, bool headerOnly, bool extractUn
 		m_nColumns = (unsigned int)m_captions.size();
 		m_nRows = 0;
 		m_units.clear();
-		if (extractUnits) {
-			for (unsigned int i=0; i<m_captions.size(); ++i) {
-				const std::string & c = m_captions[i];
-				std::size_t pos = c.find("[");
-				std::size_t pos2 = c.find("]");
-				if (pos != std::string::npos && pos != std::string::npos && pos < pos2) {
-					m_units.push_back(c.substr(pos+1, pos2-pos-1));
-					m_captions[i] = c.substr(0, pos);
-					IBK::trim(m_captions[i], " \t\r\"");
-				}
-				else
-					m_units.push_back(""); // no unit
-			}
-		}
+		if (extractUnits)
+			extractUnitsFromCaptions();
 		if (headerOnly)
 			return;
-		while (std::getline(in, line)) {
-			++m_nRows; // also count empty rows, to get correct line numbers in error messages
-			// skip empty rows
-			if (line.empty() || line.find_first_not_of("\n\r\t ") == std::string::npos)
-				continue;
-			std::vector<std::string> tokens;
-			if (m_separationCharacter == ',') {
-				IBK::explode(line, tokens, sepChars, IBK::EF_UseQuotes);
-				for (unsigned int i=0; i<tokens.size(); ++i) {
-					IBK::trim(tokens[i], " \t\r\"");
-				}
-			}
-			else
-				IBK::explode(line, tokens, sepChars, IBK::EF_NoFlags);
-			// error: wrong column size
-			if(tokens.size() != m_nColumns) {
-				throw IBK::Exception(IBK::FormatString("Wrong number of columns in line #%1!")
-										.arg(m_nRows+1), FUNC_ID);
-			}
-			std::vector<double> values(m_nColumns);
-			for (unsigned int i=0; i<m_nColumns; ++i) {
-				try {
-					values[i] = IBK::string2val<double>(tokens[i]);
-				}
-				catch (IBK::Exception & ex) {
-					throw IBK::Exception( ex, IBK::FormatString("Error reading value in column %1 in line #%2.")
-										  .arg(i).arg(m_nRows+1), FUNC_ID);
-				}
-			}
-			m_values.push_back(values);
-		}
+		// read remaining file content in one go and parse all data rows
+		std::streamoff dataSectionOffset = in.tellg();
+		in.seekg(0, std::ios_base::end);
+		std::streamoff fileSize = in.tellg();
+		m_values.clear();
+		if (dataSectionOffset == -1 || fileSize <= dataSectionOffset)
+			return; // no data rows
+		std::string content((std::size_t)(fileSize - dataSectionOffset), '\0');
+		in.seekg(dataSectionOffset, std::ios_base::beg);
+		in.read(&content[0], (std::streamsize)content.size());
+		content.resize((std::size_t)in.gcount()); // text mode may reduce number of characters read
+
+		NumberTableParser parser;
+		parser.m_separationCharacter = m_separationCharacter;
+		parser.m_stripQuotes = (m_separationCharacter == ',');
+		parser.m_nColumns = m_nColumns;
+		// data rows start in line 2, after the caption line
+		parser.parse(content.data(), content.data() + content.size(), 2, m_values);
 	}
 	catch (IBK::Exception & ex) {
 		throw IBK::Exception( ex, IBK::FormatString("Error reading file '%1'.").arg(filename), FUNC_ID);
 	}
 	// store final number of rows
-	m_nRows = m_values.size();
+	m_nRows = (unsigned int)m_values.size();
+}
+// ----------------------------------------------------------------------------
+
+
+void CSVReader::writeBinaryHeader(std::ostream & out, const std::vector<std::string> & captions) {
+	IBK::Version::write(out, BINARY_TABLE_MAGIC_NUMBER_FIRST, BINARY_TABLE_MAGIC_NUMBER_SECOND,
+						0, 0, true, BINARY_TABLE_VERSION_MAJOR, BINARY_TABLE_VERSION_MINOR);
+	IBK::write_uint32_binary(out, (uint32_t)captions.size());
+	for (const std::string & c : captions)
+		IBK::write_string_binary(out, c);
+}
+// ----------------------------------------------------------------------------
+
+
+void CSVReader::readBinary(const IBK::Path & filename, bool headerOnly) {
+	FUNCID(CSVReader::readBinary);
+#if defined(_WIN32)
+	#if defined(_MSC_VER)
+		std::ifstream in(filename.wstr().c_str(), std::ios_base::binary);
+	#else
+		std::string filenameAnsi = IBK::WstringToANSI(filename.wstr(), false);
+		std::ifstream in(filenameAnsi.c_str(), std::ios_base::binary);
+	#endif
+#else // _WIN32
+		std::ifstream in(filename.c_str(), std::ios_base::binary);
+#endif
+	if (!in)
+		throw IBK::Exception( IBK::FormatString("File doesn't exist or cannot open/access file."), FUNC_ID);
+
+	// determine file size
+	in.seekg(0, std::ios_base::end);
+	std::streamoff fileSize = in.tellg();
+	in.seekg(0, std::ios_base::beg);
+
+	// read and check magic header
+	bool isBinary;
+	unsigned int majorVersion, minorVersion;
+	IBK::Version::read(in, BINARY_TABLE_MAGIC_NUMBER_FIRST, BINARY_TABLE_MAGIC_NUMBER_SECOND, 0, 0,
+					   isBinary, majorVersion, minorVersion);
+	if (!isBinary || majorVersion > BINARY_TABLE_VERSION_MAJOR)
+		throw IBK::Exception( IBK::FormatString("Unsupported binary table format version %1.%2.")
+							  .arg(majorVersion).arg(minorVersion), FUNC_ID);
+
+	// read captions
+	uint32_t nColumns;
+	IBK::read_uint32_binary(in, nColumns);
+	if (!in || nColumns == 0 || nColumns > 10000000)
+		throw IBK::Exception( IBK::FormatString("Invalid number of columns in binary table header."), FUNC_ID);
+	m_captions.resize(nColumns);
+	for (unsigned int i=0; i<nColumns; ++i)
+		IBK::read_string_binary(in, m_captions[i], 100000);
+	m_nColumns = nColumns;
+	m_nRows = 0;
+	m_units.clear();
+	m_values.clear();
+	if (headerOnly)
+		return;
+
+	// compute number of complete rows in data section
+	std::streamoff dataSectionOffset = in.tellg();
+	std::size_t rowSize = sizeof(double)*m_nColumns;
+	std::size_t nRows = (std::size_t)(fileSize - dataSectionOffset)/rowSize;
+
+	// read data section in one go and distribute into rows
+	std::vector<double> data(nRows*m_nColumns);
+	if (nRows > 0)
+		in.read(reinterpret_cast<char *>(&data[0]), (std::streamsize)(nRows*rowSize));
+	if (!in)
+		throw IBK::Exception( IBK::FormatString("Error reading data section of binary table."), FUNC_ID);
+	m_values.resize(nRows);
+	for (std::size_t j=0; j<nRows; ++j)
+		m_values[j].assign(data.begin() + (std::ptrdiff_t)(j*m_nColumns), data.begin() + (std::ptrdiff_t)((j+1)*m_nColumns));
+	m_nRows = (unsigned int)nRows;
+}
+// ----------------------------------------------------------------------------
+
+
+void CSVReader::extractUnitsFromCaptions() {
+	m_units.clear();
+	for (unsigned int i=0; i<m_captions.size(); ++i) {
+		const std::string & c = m_captions[i];
+		std::size_t pos = c.find("[");
+		std::size_t pos2 = c.find("]");
+		if (pos != std::string::npos && pos != std::string::npos && pos < pos2) {
+			m_units.push_back(c.substr(pos+1, pos2-pos-1));
+			m_captions[i] = c.substr(0, pos);
+			IBK::trim(m_captions[i], " \t\r\"");
+		}
+		else
+			m_units.push_back(""); // no unit
+	}
 }
 // ----------------------------------------------------------------------------
 
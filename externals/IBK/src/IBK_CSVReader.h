@@ -47,17 +47,48 @@
 namespace IBK {
 
 /*! A class for simplified reading of tab/csv separated double values in a column format.
+
+	The reader also supports the binary table format (btf), i.e. the binary counterpart of tsv files
+	with the same column captions. Files with extension 'btf' are read as binary table files. The format is:
+
+	\code
+	4 x uint32          - magic header (see IBK::Version::write() and BINARY_TABLE_MAGIC_NUMBER_*), version 1.0
+	uint32              - number of columns nCols (including the time column)
+	nCols x string      - column captions "<quantity> [<unit>]" as written by IBK::write_string_binary()
+	rows x nCols double - data rows, first value in each row is the time point
+	\endcode
+
+	Since rows have fixed size, the number of rows is computed from the file size. An incomplete last row (for
+	files that are currently being written) is ignored.
+
 	\todo Speed up reading through use of IBK::FileReader
 */
 class CSVReader {
 public:
+	/*! First magic number of binary table format files. */
+	static const unsigned int BINARY_TABLE_MAGIC_NUMBER_FIRST;
+	/*! Second magic number of binary table format files. */
+	static const unsigned int BINARY_TABLE_MAGIC_NUMBER_SECOND;
+	/*! Major version number of binary table format. */
+	static const unsigned int BINARY_TABLE_VERSION_MAJOR;
+	/*! Minor version number of binary table format. */
+	static const unsigned int BINARY_TABLE_VERSION_MINOR;
+
 	CSVReader() : m_separationCharacter('\t'), m_nColumns(0), m_nRows(0) {}
 
 	/*! Reads table from a file.
+		If the file has the extension 'btf', the file is read as binary table file.
 		\param filename Input file name.
 	*/
 	void read(const IBK::Path & filename, bool headerOnly = false, bool extractUnits = false);
 
+	/*! Writes the header of a binary table file (magic header, number of columns and captions).
+		Data rows can be appended afterwards as arrays of captions.size() doubles.
+		\param out Output stream, opened in binary mode.
+		\param captions Column captions, including unit in brackets.
+	*/
+	static void writeBinaryHeader(std::ostream & out, const std::vector<std::string> & captions);
+
 	/*! Convenience function to extract data of a given column (colIndex starts with index 0). */
 	std::vector<double> colData(unsigned int colIndex) const;
 
@@ -79,6 +110,13 @@ public:
 	unsigned int						m_nColumns;
 	/*! Number of tabulator rows. */
 	unsigned int						m_nRows;
+
+private:
+	/*! Reads table from a binary table file (see class documentation for format). */
+	void readBinary(const IBK::Path & filename, bool headerOnly);
+
+	/*! Splits captions of format "<caption> [<unit>]" and stores units in m_units. */
+	void extractUnitsFromCaptions();
 };
 
 } // namespace IBK
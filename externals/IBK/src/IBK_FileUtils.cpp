@@ -245,7 +245,7 @@ std::ofstream * create_ofstream(const IBK::Path& file, std::ios_base::openmode m
 #endif // _WIN32
 }
 
-std::ifstream * open_ifstream(const IBK::Path& file, std::ios_base::openmode mode) {
+std::ifstream * create_ifstream(const IBK::Path& file, std::ios_base::openmode mode) {
 #if defined(_WIN32)
 
 #if defined(_MSC_VER)
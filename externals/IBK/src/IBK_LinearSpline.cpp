@@ -276,14 +276,41 @@ double LinearSpline::value(double x) const {
 
 	// we use lower bound to find the correct interval
 	std::vector<double>::const_iterator it = std::lower_bound(m_x.begin(), m_x.end(), x);
-	if (it == m_x.begin()) {
+	return valueInInterval(x, static_cast<unsigned int>(std::distance(m_x.begin(), it)));
+}
+
+
+double LinearSpline::value(double x, unsigned int & cursor) const {
+	IBK_ASSERT_X( m_valid, "Linear spline not properly initialized. Call makeSpline() first!" );
+
+	// equidistant splines do not need a search, single-point splines and extrapolation to the right
+	// are handled without search as well
+	if (m_xStep != 0 || m_x.size() == 1 || x > m_x.back())
+		return value(x);
+
+	return valueInInterval(x, IBK::lower_bound_index(m_x, x, cursor));
+}
+
+
+void LinearSpline::values(const std::vector<LinearSpline> & splines, double x, std::vector<unsigned int> & cursors,
+						  double * values)
+{
+	if (cursors.size() != splines.size())
+		cursors.assign(splines.size(), 0);
+	for (unsigned int i=0; i<splines.size(); ++i)
+		values[i] = splines[i].value(x, cursors[i]);
+}
+
+
+double LinearSpline::valueInInterval(double x, unsigned int upperIdx) const {
+	if (upperIdx == 0) {
 		switch (m_extrapolationMethod) {
 			case EM_Constant	: return m_y.front();
 			case EM_Linear		: return m_y.front() + m_slope.front()*(x-m_x.front());
 		}
 	}
 	// get the index of the lower limit of the current interval
-	unsigned int i = static_cast<unsigned int>(std::distance(m_x.begin(), it) - 1);
+	unsigned int i = upperIdx - 1;
 #ifdef USE_SLOPE
 	return m_y[i] + m_slope[i]*(x - m_x[i]);
 #else
@@ -160,6 +160,28 @@ public:
 	*/
 	double value(double x) const;
 
+	/*! Returns an interpolated value y at a given point x, same as value(x).
+		The search for the interval is started at the interval found in the previous call, which is stored in
+		'cursor'. When the spline is evaluated for slowly changing x values (for example time-marching
+		callers that evaluate a time series for the current simulation time), the interval is found in
+		amortized constant time instead of with a binary search.
+		\param x Value to evaluate the spline at.
+		\param cursor Cursor to be used for the interval search, updated in the call. Use a separate cursor
+			variable for each spline and for each sequence of calls (i.e. per thread), initialized with 0.
+	*/
+	double value(double x, unsigned int & cursor) const;
+
+	/*! Evaluates a set of splines at the same point x using cursor-based interval search (see
+		value(double, unsigned int &)).
+		\param splines Vector with valid splines.
+		\param x Value to evaluate the splines at.
+		\param cursors Vector with a cursor for each spline, resized and initialized if the size does not
+			match the number of splines.
+		\param values Pointer to memory array that receives the values, must hold splines.size() values.
+	*/
+	static void values(const std::vector<LinearSpline> & splines, double x, std::vector<unsigned int> & cursors,
+					   double * values);
+
 	/*! Returns a non-interpolated value y at a given point x.
 		For $x_i <= x < x_{i+1}$ the values $y_i$ is returned.
 	*/
@@ -298,6 +320,12 @@ public:
 
 protected:
 
+	/*! Returns an interpolated or extrapolated value for a non-equidistant spline.
+		\param x Value to evaluate the spline at, x <= m_x.back().
+		\param upperIdx Index of first x-value that is not less than x.
+	*/
+	double valueInInterval(double x, unsigned int upperIdx) const;
+
 	/*! Eliminates consecutive x and y values.
 		This function creates new vectors from the input vectors that won't contain
 		the same x-values.
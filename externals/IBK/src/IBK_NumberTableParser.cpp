@@ -0,0 +1,239 @@
+/*	Copyright (c) 2001-2017, Institut für Bauklimatik, TU Dresden, Germany
+
+	Written by A. Nicolai, H. Fechner, St. Vogelsang, A. Paepcke, J. Grunewald
+	All rights reserved.
+
+	This file is part of the IBK Library.
+
+	Redistribution and use in source and binary forms, with or without modification,
+	are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	   list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	   this list of conditions and the following disclaimer in the documentation
+	   and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	   may be used to endorse or promote products derived from this software without
+	   specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+	ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+	(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+	ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+	SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+	This library contains derivative work based on other open-source libraries.
+	See OTHER_LICENCES and source code headers for details.
+
+*/
+
+#include "IBK_NumberTableParser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+#include "IBK_Exception.h"
+#include "IBK_FormatString.h"
+#include "IBK_NotificationHandler.h"
+#include "IBK_StringUtils.h"
+#include "IBK_openMP.h"
+
+namespace IBK {
+
+/*! Converts the characters in range [begin, end) into a double value. */
+static double parseValue(const char * begin, const char * end) {
+#ifndef IBK_USE_STOD
+	// fast_double_parser requires a zero-terminated string, numbers are short so we copy into a local buffer
+	char buf[64];
+	std::size_t len = (std::size_t)(end - begin);
+	if (len < sizeof(buf)) {
+		std::memcpy(buf, begin, len);
+		buf[len] = 0;
+		double val;
+		if (fast_double_parser::decimal_separator_dot::parse_number(buf, &val))
+			return val;
+	}
+#endif // IBK_USE_STOD
+	// special values (1.#QNAN), very long numbers and error handling
+	return IBK::string2val<double>(std::string(begin, end));
+}
+
+
+/*! Result of parsing a chunk of the buffer. */
+struct NumberTableParserChunk {
+	NumberTableParserChunk() : m_lineCount(0), m_errorLine(0), m_error(false) {}
+
+	/*! Values of all non-empty lines. */
+	std::vector<std::vector<double> >	m_rows;
+	/*! Number of lines in chunk (including empty lines). */
+	unsigned int						m_lineCount;
+	/*! Index of line (within chunk) in which the error occurred. */
+	unsigned int						m_errorLine;
+	/*! True if an error occurred. */
+	bool								m_error;
+	/*! Exception raised while parsing the chunk, exceptions must not leave the parallel region. */
+	IBK::Exception						m_exception;
+};
+
+
+void NumberTableParser::parse(const char * begin, const char * end, unsigned int firstLineNumber,
+							  std::vector<std::vector<double> > & rows, IBK::NotificationHandler * notify) const
+{
+	FUNCID(NumberTableParser::parse);
+
+	if (begin >= end)
+		return;
+
+	// determine number of chunks, each thread gets several chunks for better load balancing
+	// and progress is notified once per chunk
+	std::size_t maxChunks = 64;
+#if defined(_OPENMP)
+	maxChunks = std::max(maxChunks, (std::size_t)(4*omp_get_max_threads()));
+#endif // _OPENMP
+	std::size_t nChunks = 1;
+	std::size_t size = (std::size_t)(end - begin);
+	if (m_minChunkSize > 0 && size >= 2*m_minChunkSize)
+		nChunks = std::min(size/m_minChunkSize, maxChunks);
+
+	// split buffer at line boundaries
+	std::vector<const char *> chunkBegin(nChunks+1, end);
+	chunkBegin[0] = begin;
+	for (std::size_t c=1; c<nChunks; ++c) {
+		const char * p = begin + (end - begin)*(std::ptrdiff_t)c/(std::ptrdiff_t)nChunks;
+		if (p < chunkBegin[c-1])
+			p = chunkBegin[c-1];
+		p = static_cast<const char *>(std::memchr(p, '\n', (std::size_t)(end - p)));
+		chunkBegin[c] = (p == nullptr) ? end : p + 1;
+	}
+
+	std::vector<NumberTableParserChunk> chunks(nChunks);
+	std::atomic<unsigned int> chunksCompleted(0);
+
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic,1)
+#endif // _OPENMP
+	for (int c=0; c<(int)nChunks; ++c) {
+		NumberTableParserChunk & chunk = chunks[(std::size_t)c];
+		const char * p = chunkBegin[(std::size_t)c];
+		const char * chunkEnd = chunkBegin[(std::size_t)c+1];
+		std::vector<double> values;
+		try {
+			while (p < chunkEnd) {
+				const char * lineEnd = static_cast<const char *>(std::memchr(p, '\n', (std::size_t)(chunkEnd - p)));
+				if (lineEnd == nullptr)
+					lineEnd = chunkEnd;
+				if (parseLine(p, lineEnd, values))
+					chunk.m_rows.push_back(values);
+				++chunk.m_lineCount;
+				p = lineEnd + 1;
+			}
+		}
+		catch (IBK::Exception & ex) {
+			chunk.m_error = true;
+			chunk.m_errorLine = chunk.m_lineCount;
+			chunk.m_exception = ex;
+		}
+
+		// notification handlers need not be thread-safe, hence only the calling thread notifies
+		// and reports all chunks completed so far
+		unsigned int completed = ++chunksCompleted;
+#if defined(_OPENMP)
+		if (omp_get_thread_num() != 0)
+			continue;
+#endif // _OPENMP
+		if (notify != nullptr)
+			notify->notify(double(completed)/nChunks);
+	}
+
+	// collect rows in order and report first error
+	std::size_t nRows = rows.size();
+	unsigned int lineNumber = firstLineNumber;
+	for (std::size_t c=0; c<nChunks; ++c) {
+		if (chunks[c].m_error)
+			throw IBK::Exception(chunks[c].m_exception, IBK::FormatString("Error in line #%1.")
+								 .arg(lineNumber + chunks[c].m_errorLine), FUNC_ID);
+		lineNumber += chunks[c].m_lineCount;
+		nRows += chunks[c].m_rows.size();
+	}
+	rows.reserve(nRows);
+	for (std::size_t c=0; c<nChunks; ++c)
+		rows.insert(rows.end(), std::make_move_iterator(chunks[c].m_rows.begin()),
+					std::make_move_iterator(chunks[c].m_rows.end()));
+}
+
+
+bool NumberTableParser::parseLine(const char * begin, const char * end, std::vector<double> & values) const {
+	FUNCID(NumberTableParser::parseLine);
+
+	values.clear();
+	const char * p = begin;
+	if (m_separationCharacter == ' ') {
+		// white-space separated values
+		for (;;) {
+			while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+				++p;
+			if (p == end)
+				break;
+			const char * tokenBegin = p;
+			while (p < end && *p != ' ' && *p != '\t' && *p != '\r')
+				++p;
+			values.push_back(parseValue(tokenBegin, p));
+		}
+	}
+	else {
+		// skip empty lines
+		const char * q = p;
+		while (q < end && (*q == ' ' || *q == '\t' || *q == '\r'))
+			++q;
+		if (q == end)
+			return false;
+
+		for (;;) {
+			// find end of token
+			const char * tokenEnd = p;
+			bool inQuotes = false;
+			while (tokenEnd < end && (inQuotes || *tokenEnd != m_separationCharacter)) {
+				if (m_stripQuotes && *tokenEnd == '"')
+					inQuotes = !inQuotes;
+				++tokenEnd;
+			}
+			// empty tokens (consecutive separators, separator at end of line) are skipped, same as in IBK::explode()
+			if (tokenEnd != p) {
+				// trim white-space and quotes
+				const char * tokenBegin = p;
+				while (tokenBegin < tokenEnd && (*tokenBegin == ' ' || *tokenBegin == '\t' || *tokenBegin == '\r' ||
+												 (m_stripQuotes && *tokenBegin == '"')))
+					++tokenBegin;
+				const char * tokenLast = tokenEnd;
+				while (tokenLast > tokenBegin && (tokenLast[-1] == ' ' || tokenLast[-1] == '\t' || tokenLast[-1] == '\r' ||
+												  (m_stripQuotes && tokenLast[-1] == '"')))
+					--tokenLast;
+				values.push_back(parseValue(tokenBegin, tokenLast));
+			}
+			if (tokenEnd == end)
+				break;
+			p = tokenEnd + 1;
+		}
+	}
+
+	if (values.empty())
+		return false;
+	if (m_nColumns != 0 && values.size() != m_nColumns)
+		throw IBK::Exception(IBK::FormatString("Wrong number of columns (%1 instead of %2).")
+							 .arg((unsigned int)values.size()).arg(m_nColumns), FUNC_ID);
+	return true;
+}
+
+} // namespace IBK
@@ -0,0 +1,111 @@
+/*	Copyright (c) 2001-2017, Institut für Bauklimatik, TU Dresden, Germany
+
+	Written by A. Nicolai, H. Fechner, St. Vogelsang, A. Paepcke, J. Grunewald
+	All rights reserved.
+
+	This file is part of the IBK Library.
+
+	Redistribution and use in source and binary forms, with or without modification,
+	are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	   list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	   this list of conditions and the following disclaimer in the documentation
+	   and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	   may be used to endorse or promote products derived from this software without
+	   specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+	ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+	(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+	ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+	(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+	SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+	This library contains derivative work based on other open-source libraries.
+	See OTHER_LICENCES and source code headers for details.
+
+*/
+
+#ifndef IBK_NumberTableParserH
+#define IBK_NumberTableParserH
+
+#include <vector>
+#include <cstddef>
+
+namespace IBK {
+
+class NotificationHandler;
+
+/*! Parser for text buffers with rows of numbers (tsv, csv or white-space separated data sections
+	such as in d6o files).
+
+	The buffer is split at line boundaries into chunks, which are parsed concurrently when compiled with
+	OpenMP. Numbers are converted with fast_double_parser (falls back to IBK::string2val<double>() for
+	special values and error reporting). The resulting rows are stored in the order of the buffer.
+
+	Empty lines (or lines with only white-space characters) are skipped, but counted in line numbers
+	reported in error messages.
+
+	\code
+	IBK::NumberTableParser parser;
+	parser.m_separationCharacter = ',';
+	parser.m_nColumns = 3;
+	std::vector<std::vector<double> > rows;
+	// first line in buffer is line #2 of file (after caption line)
+	parser.parse(buffer.data(), buffer.data() + buffer.size(), 2, rows);
+	\endcode
+*/
+class NumberTableParser {
+public:
+	NumberTableParser() : m_separationCharacter('\t'), m_stripQuotes(false), m_nColumns(0), m_minChunkSize(256*1024) {}
+
+	/*! Parses all lines in memory range [begin, end) and appends the values of each non-empty line to rows.
+		Throws an IBK::Exception in case of invalid numbers or wrong number of columns, the error message
+		contains the line number.
+		\param begin Begin of text buffer.
+		\param end End of text buffer (pointer past last character).
+		\param firstLineNumber Line number of the first line in the buffer (used in error messages).
+		\param rows Vector that the parsed rows are appended to.
+		\param notify Optional notification handler, called with the fraction of parsed chunks after each chunk.
+			When parsing concurrently, only the calling thread notifies (after each of its own chunks).
+	*/
+	void parse(const char * begin, const char * end, unsigned int firstLineNumber,
+			   std::vector<std::vector<double> > & rows, IBK::NotificationHandler * notify = nullptr) const;
+
+	/*! Separation character between columns.
+		Use ' ' for white-space separated values (any sequence of blanks and tabulators separates two values).
+		For all other separation characters, each separator character starts a new column. Empty columns
+		(consecutive separators, separators at begin or end of line) are skipped, as in IBK::explode().
+	*/
+	char			m_separationCharacter;
+	/*! If true, values may be enclosed in double quotes (Excel-style csv). */
+	bool			m_stripQuotes;
+	/*! Number of values expected in each line, 0 to accept any number of values. */
+	unsigned int	m_nColumns;
+	/*! Minimum number of characters per chunk processed by a single thread. */
+	std::size_t		m_minChunkSize;
+
+private:
+	/*! Parses a single line in range [begin, end) and stores values in vector values.
+		\return Returns false for empty lines.
+	*/
+	bool parseLine(const char * begin, const char * end, std::vector<double> & values) const;
+};
+
+} // namespace IBK
+
+/*! \file IBK_NumberTableParser.h
+	\brief Contains the class NumberTableParser, a fast parser for text tables with numbers.
+*/
+
+#endif // IBK_NumberTableParserH
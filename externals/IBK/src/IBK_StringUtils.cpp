@@ -48,6 +48,7 @@
 #include <locale>
 #include <cctype>
 #include <cmath>
+#include <cstring>
 
 #ifdef _WIN32
 #ifdef NOMINMAX
@@ -71,84 +72,84 @@
 
 namespace IBK {
 
-void string2valueVector(const std::string & origStr, std::vector<double> & vec) {
-	FUNCID(IBK::string2valueVector);
-	// algorithm is simple - search for white-space delimiters and replace the first white-space after each non-white space
-	// substr with \0 and remember its position, then parse all the substrings
+/*! Returns true, if character separates numbers in a number list. */
+static inline bool isNumberSeparator(char ch, bool commaSeparated) {
+	return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || (commaSeparated && ch == ',');
+}
 
-	vec.clear();
-	size_t strsize = origStr.size();
-	if (strsize == 0)
-		return; // empty string - no data in vector
 
-	std::string str(origStr);
-	size_t pos = 0;
-	size_t numberStart = 0;
-
-	bool inNumber = false;
-
-	// process entire string, search until we toggle from "whitespace" to "number" and remember starting position of number
-	// then continue until we toggle from "number" to "whitespace" and try to convert the string in-between
-	while (pos < strsize) {
-		char ch = str[pos];
-		// do we have a whitespace char?
-		if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
-			// toggle to "whitespace mode"?
-			if (inNumber) {
-				inNumber = false;
-				// change character to \0
-				str[pos] = 0;
+/*! Parses a zero-terminated string with a single number, returns false if string is not a valid number. */
+static inline bool parseNumber(const char * str, std::size_t len, double & val) {
 #ifdef IBK_USE_STOD
-				// try to parse from begin of number to this position
-				size_t charCount;
-				try {
-					double val = std::stod(str.data()+numberStart, &charCount);
-					if (charCount != pos - numberStart)
-						throw std::exception();
-					vec.push_back(val);
-				} catch (...) {
-					throw IBK::Exception(IBK::FormatString("'%1' at character pos #2 is not a valid number.").arg(str.data()+numberStart).arg(numberStart), FUNC_ID);
-				}
+	try {
+		std::size_t charCount;
+		val = std::stod(str, &charCount);
+		return charCount == len;
+	} catch (...) {
+		return false;
+	}
 #else
-				// try to parse from begin of number to this position
-				double val;
-				bool isok = fast_double_parser::decimal_separator_dot::parse_number(str.data()+numberStart, &val);
-				if (!isok)
-					throw IBK::Exception(IBK::FormatString("'%1' at character pos #2 is not a valid number.").arg(str.data()+numberStart).arg(numberStart), FUNC_ID);
-				vec.push_back(val);
+	(void)len;
+	return fast_double_parser::decimal_separator_dot::parse_number(str, &val);
 #endif // IBK_USE_STOD
-			}
+}
+
+
+/*! Parses all numbers in the character range [str, strEnd), implementation of both string2valueVector() variants.
+	Zero characters within the range are not separators, so that std::string arguments are parsed over their
+	full length, even with embedded zero characters.
+*/
+static void parseValueVector(const char * str, const char * strEnd, std::vector<double> & vec, bool commaSeparated) {
+	FUNCID(IBK::string2valueVector);
+	// algorithm: skip separators, search end of the following number and parse the number from a
+	// zero-terminated copy in a local buffer (numbers are short) - no copy of the entire string needed
+
+	vec.clear();
+	const char * pos = str;
+	for (;;) {
+		while (pos != strEnd && isNumberSeparator(*pos, commaSeparated))
+			++pos;
+		if (pos == strEnd)
+			break;
+
+		const char * numberStart = pos;
+		while (pos != strEnd && !isNumberSeparator(*pos, commaSeparated))
+			++pos;
+		std::size_t len = (std::size_t)(pos - numberStart);
+
+		double val;
+		bool isok;
+		char buf[64];
+		if (len < sizeof(buf)) {
+			std::memcpy(buf, numberStart, len);
+			buf[len] = 0;
+			isok = parseNumber(buf, len, val);
 		}
 		else {
-			// toggle to "number" mode?
-			if (!inNumber) {
-				numberStart = pos;
-				inNumber = true;
-			}
+			// very long numbers (many digits)
+			std::string numberStr(numberStart, len);
+			isok = parseNumber(numberStr.c_str(), len, val);
 		}
-		++pos;
-	}
-	// if we are still in number mode at end of string, then try to parse the last number
-	if (inNumber) {
-#ifdef IBK_USE_STOD
-		size_t charCount;
-		try {
-			double val = std::stod(str.data()+numberStart, &charCount);
-			if (charCount != pos - numberStart)
-				throw;
-			vec.push_back(val);
-		} catch (...) {
-			throw IBK::Exception(IBK::FormatString("'%1' at character pos #2 is not a valid number.").arg(str.data()+numberStart).arg(numberStart), FUNC_ID);
-		}
-#else
-		double val;
-		bool isok = fast_double_parser::decimal_separator_dot::parse_number(str.data()+numberStart, &val);
 		if (!isok)
-			throw IBK::Exception(IBK::FormatString("'%1' at character pos #2 is not a valid number.").arg(str.data()+numberStart).arg(numberStart), FUNC_ID);
+			throw IBK::Exception(IBK::FormatString("'%1' at character pos #%2 is not a valid number.")
+								 .arg(std::string(numberStart, len)).arg((unsigned int)(numberStart - str)), FUNC_ID);
 		vec.push_back(val);
-#endif // IBK_USE_STOD
 	}
 }
+
+
+void string2valueVector(const std::string & str, std::vector<double> & vec) {
+	parseValueVector(str.data(), str.data() + str.size(), vec, false);
+}
+
+
+void string2valueVector(const char * str, std::vector<double> & vec, bool commaSeparated) {
+	if (str == nullptr) {
+		vec.clear();
+		return;
+	}
+	parseValueVector(str, str + std::strlen(str), vec, commaSeparated);
+}
 // ---------------------------------------------------------------------------
 
 
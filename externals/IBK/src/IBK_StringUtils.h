@@ -284,10 +284,25 @@ inline double string2valDef<double>(const std::string& str, const double & def)
 	improve performance, you may want to call reserve() on the vector if
 	you know the approximate/exact number of numbers in the string.
 
+	The entire string is parsed (str.size() characters), also if it contains zero characters.
+
 	This function throws an IBK::Exception in case of invalid numbers in string.
 */
 void string2valueVector(const std::string & str, std::vector<double> & vec);
 
+/*! Converts a zero-terminated string with white-space separated values into a vector.
+	Same as string2valueVector() above, but the numbers are parsed directly from the character buffer
+	without copying the string, which is meant for large number lists, for example texts of XML elements
+	(TiXmlElement::GetText()) with vertex coordinates or spline values.
+	A nullptr string is treated like an empty string.
+	\param str Zero-terminated string.
+	\param vec Vector with parsed numbers (emptied upon start).
+	\param commaSeparated If true, commas are treated as separators as well (like white-spaces).
+
+	This function throws an IBK::Exception in case of invalid numbers in string.
+*/
+void string2valueVector(const char * str, std::vector<double> & vec, bool commaSeparated = false);
+
 
 /*! Tries to read a vector of numbers of type T out of a string.
 	If the number of read values is less then 2, a runtime error is thrown.
@@ -43,6 +43,7 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <vector>
 
 #include "IBK_configuration.h"
 #include "IBK_messages.h"
@@ -234,6 +235,47 @@ inIt advance_iterator(inIt it, std::size_t distance) {
 }
 
 
+/*! Returns the index of the first element in the sorted vector vec that is not less than value
+	(same result as std::lower_bound), but starts the search at index 'cursor' and updates the cursor
+	to the found index.
+	If the searched values of consecutive calls are close to each other (e.g. time points of a simulation
+	that moves almost monotonically forward), only few elements around the cursor are compared and the search
+	takes amortized constant time. If the result is not found within a few steps, a binary search in the
+	remaining part of the vector is used.
+	\param vec Vector sorted in increasing order.
+	\param value Value to search for.
+	\param cursor Result of the previous search (any value is allowed, e.g. 0 for the first search).
+	\return Index of the first element >= value, or vec.size() if all elements are less than value.
+*/
+template <typename T>
+unsigned int lower_bound_index(const std::vector<T> & vec, const T & value, unsigned int & cursor) {
+	// number of elements to inspect before switching to binary search
+	const unsigned int LINEAR_SEARCH_STEPS = 8;
+	unsigned int n = (unsigned int)vec.size();
+	if (n == 0)
+		return cursor = 0;
+	unsigned int j = std::min(cursor, n-1);
+	if (!(vec[j] < value)) {
+		// search backwards, vec[j] >= value
+		for (unsigned int k=0; k<LINEAR_SEARCH_STEPS; ++k, --j) {
+			if (j == 0 || vec[j-1] < value)
+				return cursor = j;
+		}
+		j = (unsigned int)(std::lower_bound(vec.begin(), vec.begin() + j, value) - vec.begin());
+	}
+	else {
+		// search forwards, all elements up to j are less than value
+		++j;
+		for (unsigned int k=0; k<LINEAR_SEARCH_STEPS; ++k, ++j) {
+			if (j == n || !(vec[j] < value))
+				return cursor = j;
+		}
+		j = (unsigned int)(std::lower_bound(vec.begin() + j, vec.end(), value) - vec.begin());
+	}
+	return cursor = j;
+}
+
+
 
 // The algorithms below have all special requirements on the container elements, mostly
 // in form of necessary member functions.
@@ -88,14 +88,22 @@ inline void IBK_Message(const IBK::FormatString& msg, msg_type_t t = MSG_PROGRES
 */
 class MessageIndentor {
 public:
-	/*! Constructor increases indentation. */
-	MessageIndentor() {
-		++(MessageHandlerRegistry::instance().messageHandler()->m_indentation);
+	/*! Constructor increases indentation.
+		\param enabled If false, the indentor does nothing (for code paths with suppressed messages).
+	*/
+	explicit MessageIndentor(bool enabled = true) : m_enabled(enabled) {
+		if (m_enabled)
+			++(MessageHandlerRegistry::instance().messageHandler()->m_indentation);
 	}
 	/*! Destructor decreases indentation. */
 	~MessageIndentor() {
-		--(MessageHandlerRegistry::instance().messageHandler()->m_indentation);
+		if (m_enabled)
+			--(MessageHandlerRegistry::instance().messageHandler()->m_indentation);
 	}
+
+private:
+	/*! If false, indentation is not modified. */
+	bool m_enabled;
 };
 
 /*! Convenience macro that creates a message indentor object and adds a void cast to remove compiler warning. */
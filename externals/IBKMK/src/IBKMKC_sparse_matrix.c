@@ -694,6 +694,62 @@ void ibkmk_spmat_csr_backsolve(unsigned int n, IBKMK_CONST unsigned int * ia, IB
 }
 
 
+void ibkmk_spmat_csr_backsolve_levels(	unsigned int n,
+										IBKMK_CONST unsigned int * ia,
+										IBKMK_CONST unsigned int * ja,
+										IBKMK_CONST double * A,
+										unsigned int nLevelsL,
+										IBKMK_CONST unsigned int * levelOffsetsL,
+										IBKMK_CONST unsigned int * levelRowsL,
+										unsigned int nLevelsU,
+										IBKMK_CONST unsigned int * levelOffsetsU,
+										IBKMK_CONST unsigned int * levelRowsU,
+										double * b)
+{
+	unsigned int level, i, k, kIdx;
+	int r; /* omp loop variables must be int's for Visual Studio */
+	double t;
+	(void)n;
+
+#pragma omp parallel private(level, i, k, kIdx, t)
+	{
+		/* L loop (forward elimination), rows of a level only depend on rows of previous levels */
+		for (level=0; level<nLevelsL; ++level) {
+#pragma omp for schedule(static)
+			for (r=(int)levelOffsetsL[level]; r<(int)levelOffsetsL[level+1]; ++r) {
+				i = levelRowsL[r];
+				t = b[i];
+				/* subtract sum_k l_ik*b_k for all k < i, stop at diagonal element */
+				for (kIdx = ia[i]; ; ++kIdx) {
+					k = ja[kIdx];
+					if (k == i)
+						break;
+					t -= A[kIdx]*b[k];
+				}
+				b[i] = t/A[kIdx];
+			} /* implicit barrier */
+		}
+
+		/* U loop (backward elimination), with special case u_i,i = 1 */
+		for (level=0; level<nLevelsU; ++level) {
+#pragma omp for schedule(static)
+			for (r=(int)levelOffsetsU[level]; r<(int)levelOffsetsU[level+1]; ++r) {
+				i = levelRowsU[r];
+				t = b[i];
+				/* process all indices in row i backwards, stop at the diagonal element */
+				for (kIdx = ia[i+1]-1; ; --kIdx) {
+					k = ja[kIdx];
+					if (k <= i)
+						break;
+					t -= A[kIdx]*b[k];
+				}
+				b[i] = t;
+			} /* implicit barrier */
+		}
+	} /* end parallel region */
+}
+
+
 void ibkmk_spmat_csr_multiply(	unsigned int n,
 								IBKMK_CONST double * A,
 								IBKMK_CONST unsigned int * ia,
@@ -701,9 +757,12 @@ void ibkmk_spmat_csr_multiply(	unsigned int n,
 								IBKMK_CONST double * b,
 								double * r)
 {
-	unsigned int i,k;
+	int i; /* omp loop variables must be int's for Visual Studio */
+	unsigned int k;
 	double t;
-	for (i=0; i<n; ++i) {
+	/* rows are independent, small matrices are processed serially to avoid threading overhead */
+#pragma omp parallel for schedule(static) private(k,t) if(ia[n] >= IBKMK_SPMAT_CSR_PARALLEL_MIN_NNZ)
+	for (i=0; i<(int)n; ++i) {
 		t = 0;
 		for (k=ia[i]; k<ia[i+1]; ++k) {
 			t += A[k]*b[ja[k]];
@@ -41,6 +41,11 @@
 
 #include "IBKMK_common_defines.h"
 
+/*! Minimum number of non-zero elements for which ibkmk_spmat_csr_multiply() distributes rows over several
+	threads. For smaller matrices, the threading overhead exceeds the gain.
+*/
+#define IBKMK_SPMAT_CSR_PARALLEL_MIN_NNZ 20000
+
 #ifdef __cplusplus  /* wrapper to enable C++ usage */
 
 namespace IBKMK {
@@ -152,7 +157,36 @@ void ibkmk_spmat_csr_backsolve(	unsigned int n,
 								IBKMK_CONST double * A,
 								double * b);
 
+/*! Sparse matrix incomplete backsolve iLU x = b with level scheduling.
+	Same as ibkmk_spmat_csr_backsolve(), but rows are processed level by level. All rows within a level
+	only depend on rows of previous levels and are processed concurrently (when compiled with OpenMP).
+	\param n Matrix dimension.
+	\param ia Row index vector, size n+1.
+	\param ja Column index vector, size nnz.
+	\param A Matrix data (already ILU-factorized), size nnz.
+	\param nLevelsL Number of levels in forward elimination (L).
+	\param levelOffsetsL Index of first row of each level in levelRowsL, size nLevelsL+1.
+	\param levelRowsL Row indexes sorted by level of forward elimination, size n.
+	\param nLevelsU Number of levels in backward elimination (U).
+	\param levelOffsetsU Index of first row of each level in levelRowsU, size nLevelsU+1.
+	\param levelRowsU Row indexes sorted by level of backward elimination, size n.
+	\param b Right-hand side vector, size n.
+*/
+void ibkmk_spmat_csr_backsolve_levels(	unsigned int n,
+										IBKMK_CONST unsigned int * ia,
+										IBKMK_CONST unsigned int * ja,
+										IBKMK_CONST double * A,
+										unsigned int nLevelsL,
+										IBKMK_CONST unsigned int * levelOffsetsL,
+										IBKMK_CONST unsigned int * levelRowsL,
+										unsigned int nLevelsU,
+										IBKMK_CONST unsigned int * levelOffsetsU,
+										IBKMK_CONST unsigned int * levelRowsU,
+										double * b);
+
 /*! Generic sparse matrix - vector multiply r = A*b.
+	Rows are processed concurrently (when compiled with OpenMP) if the matrix has at least
+	IBKMK_SPMAT_CSR_PARALLEL_MIN_NNZ non-zero elements.
 	\param n Matrix dimension.
 	\param nnz Number of non-zero elements.
 	\param A Matrix data, size nnz, see description of block-sparse-matrix Compresses Sparse Row format.
@@ -42,6 +42,8 @@
 #include <algorithm>
 #include <functional>
 
+#include <IBK_openMP.h>
+
 #include "IBKMK_SparseMatrixCSR.h"
 #include "IBKMKC_sparse_matrix.h"
 
@@ -140,6 +142,7 @@ void SparseMatrixCSR::resize(unsigned int n, unsigned int nnz, const unsigned in
 		std::memcpy((void*)&m_jaT[0], (const void*)jaT, sizeof(unsigned int)*m_nnz);
 		m_patternMode = PM_Asymmetric;
 	}
+	updateLevelSchedule();
 }
 
 
@@ -177,6 +180,7 @@ void SparseMatrixCSR::resizeFromEID(unsigned int n, unsigned int elementsPerRow,
 	m_nnz = (unsigned int)m_ja.size();
 	// resize data vector
 	m_data.resize(m_nnz);
+	updateLevelSchedule();
 }
 
 void SparseMatrixCSR::parseFromEID(unsigned int n, unsigned int elementsPerRow, const unsigned int * indices, const double *data) {
@@ -276,6 +280,17 @@ void SparseMatrixCSR::ilu() {
 
 
 void SparseMatrixCSR::backsolveILU(double * b) const {
+#if defined(_OPENMP)
+	// level scheduling only pays off if several threads are available and we are not already
+	// called from within a parallel region (e.g. block-wise preconditioners)
+	if (m_levelScheduling && omp_get_max_threads() > 1 && !omp_in_parallel()) {
+		ibkmk_spmat_csr_backsolve_levels(m_n, &m_ia[0], &m_ja[0], &m_data[0],
+										 (unsigned int)m_levelOffsetsL.size()-1, &m_levelOffsetsL[0], &m_levelRowsL[0],
+										 (unsigned int)m_levelOffsetsU.size()-1, &m_levelOffsetsU[0], &m_levelRowsU[0],
+										 b);
+		return;
+	}
+#endif // _OPENMP
 	ibkmk_spmat_csr_backsolve(m_n, &m_ia[0], &m_ja[0], &m_data[0], b);
 }
 
@@ -427,6 +442,74 @@ void SparseMatrixCSR::recreate(void* & dataPtr) {
 		std::memcpy(&m_jaT[0], dataPtr, jaTSize);
 		dataPtr = (char*)dataPtr + jaTSize;
 	}
+	updateLevelSchedule();
+}
+
+
+void SparseMatrixCSR::updateLevelSchedule() {
+	// minimum average number of rows per level for which level-wise parallel processing is used;
+	// each level ends with a thread barrier, which costs about as much as processing 1000 sparse rows
+	const unsigned int MIN_ROWS_PER_LEVEL = 1000;
+
+	// empty matrix (e.g. recreated from serialized data of an empty matrix), nothing to schedule
+	if (m_n == 0) {
+		m_levelOffsetsL.clear();
+		m_levelRowsL.clear();
+		m_levelOffsetsU.clear();
+		m_levelRowsU.clear();
+		m_levelScheduling = false;
+		return;
+	}
+
+	std::vector<unsigned int> levels(m_n);
+
+	// forward elimination: row i depends on all rows k < i in row i
+	unsigned int nLevelsL = 0;
+	for (unsigned int i=0; i<m_n; ++i) {
+		unsigned int level = 0;
+		for (unsigned int kIdx=m_ia[i]; kIdx<m_ia[i+1]; ++kIdx) {
+			unsigned int k = m_ja[kIdx];
+			if (k >= i)
+				break; // column indexes are sorted
+			level = std::max(level, levels[k] + 1);
+		}
+		levels[i] = level;
+		nLevelsL = std::max(nLevelsL, level + 1);
+	}
+	groupRowsByLevel(levels, nLevelsL, m_levelOffsetsL, m_levelRowsL);
+
+	// backward elimination: row i depends on all rows k > i in row i
+	unsigned int nLevelsU = 0;
+	for (unsigned int i=m_n; i-- > 0; ) {
+		unsigned int level = 0;
+		for (unsigned int kIdx=m_ia[i+1]; kIdx-- > m_ia[i]; ) {
+			unsigned int k = m_ja[kIdx];
+			if (k <= i)
+				break;
+			level = std::max(level, levels[k] + 1);
+		}
+		levels[i] = level;
+		nLevelsU = std::max(nLevelsU, level + 1);
+	}
+	groupRowsByLevel(levels, nLevelsU, m_levelOffsetsU, m_levelRowsU);
+
+	m_levelScheduling = (m_n >= MIN_ROWS_PER_LEVEL*nLevelsL && m_n >= MIN_ROWS_PER_LEVEL*nLevelsU);
+}
+
+
+void SparseMatrixCSR::groupRowsByLevel(const std::vector<unsigned int> & levels, unsigned int nLevels,
+	std::vector<unsigned int> & levelOffsets, std::vector<unsigned int> & levelRows)
+{
+	// counting sort, rows within a level remain in increasing order
+	levelOffsets.assign(nLevels+1, 0);
+	for (unsigned int i=0; i<levels.size(); ++i)
+		++levelOffsets[levels[i]+1];
+	for (unsigned int l=0; l<nLevels; ++l)
+		levelOffsets[l+1] += levelOffsets[l];
+	levelRows.resize(levels.size());
+	std::vector<unsigned int> pos(levelOffsets.begin(), levelOffsets.end()-1);
+	for (unsigned int i=0; i<levels.size(); ++i)
+		levelRows[pos[levels[i]]++] = i;
 }
 
 
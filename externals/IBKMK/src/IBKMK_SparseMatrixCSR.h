@@ -94,7 +94,7 @@ public:
 		Before using the matrix, call resize().
 		\sa resize
 	*/
-	SparseMatrixCSR() : m_nnz(0), m_patternMode(NUM_PatternMode) {}
+	SparseMatrixCSR() : m_nnz(0), m_patternMode(NUM_PatternMode), m_levelScheduling(false) {}
 
 	/*! Constructor, creates a matrix with initial size and index vectors.
 		\sa resize
@@ -154,6 +154,9 @@ public:
 	/*! Solves <math>LUx = b as x = U^{-1} L^{-1} b</math> using backward elimination.
 		The matrix is expected to hold incomplete LU data as generated by ilu() with
 		<math>u_{i,i} = 1</math>.
+		When compiled with OpenMP and the matrix pattern offers enough independent rows per
+		level (see m_levelScheduling), forward and backward elimination are processed level-wise
+		in parallel. Results are identical to the serial version.
 	*/
 	virtual void backsolveILU(double * b) const;
 
@@ -276,6 +279,28 @@ protected:
 	/*! j-Indices of the tranposed matrix. Important for the ILU of non-symmetric matrices.*/
 	std::vector<unsigned int>			m_jaT;
 	PatternMode							m_patternMode;
+
+	/*! Index of first row of each level in m_levelRowsL, size = number of levels + 1.
+		Rows in the same level of the forward elimination only depend on rows of previous levels.
+	*/
+	std::vector<unsigned int>			m_levelOffsetsL;
+	/*! Row indexes ordered by level of forward elimination. */
+	std::vector<unsigned int>			m_levelRowsL;
+	/*! Index of first row of each level in m_levelRowsU, size = number of levels + 1. */
+	std::vector<unsigned int>			m_levelOffsetsU;
+	/*! Row indexes ordered by level of backward elimination. */
+	std::vector<unsigned int>			m_levelRowsU;
+	/*! If true, the level schedule has enough rows per level to be used in backsolveILU(). */
+	bool								m_levelScheduling;
+
+private:
+	/*! Computes the level schedule of forward and backward elimination from the matrix pattern.
+		Called whenever the pattern is changed.
+	*/
+	void updateLevelSchedule();
+	/*! Groups row indexes 0..levels.size()-1 by their level (counting sort). */
+	static void groupRowsByLevel(const std::vector<unsigned int> & levels, unsigned int nLevels,
+								 std::vector<unsigned int> & levelOffsets, std::vector<unsigned int> & levelRows);
 }; // SparseMatrixCSR
 
 /*! \file IBKMK_SparseMatrixCSR.h
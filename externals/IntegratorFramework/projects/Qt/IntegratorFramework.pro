@@ -48,6 +48,7 @@ HEADERS += \
 	../../src/SOLFRA_LESKLU.h \
 	../../src/SOLFRA_ModelInterface.h \
 	../../src/SOLFRA_OutputScheduler.h \
+	../../src/SOLFRA_PrecondBlockJacobi.h \
 	../../src/SOLFRA_PrecondILU.h \
 	../../src/SOLFRA_PrecondILUT.h \
 	../../src/SOLFRA_PrecondInterface.h \
@@ -68,6 +69,7 @@ SOURCES += \
 	../../src/SOLFRA_LESInterfaceIterative.cpp \
 	../../src/SOLFRA_LESKLU.cpp \
 	../../src/SOLFRA_OutputScheduler.cpp \
+	../../src/SOLFRA_PrecondBlockJacobi.cpp \
 	../../src/SOLFRA_PrecondILU.cpp \
 	../../src/SOLFRA_PrecondILUT.cpp \
 	../../src/SOLFRA_PrecondInterface.cpp \
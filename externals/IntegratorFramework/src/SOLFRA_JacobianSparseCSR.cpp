@@ -2,9 +2,14 @@
 
 #include "SOLFRA_ModelInterface.h"
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif // _OPENMP
+
 #include <fstream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 #include <cvode/cvode.h>
 #include <sundials/sundials_timer.h>
@@ -41,33 +46,82 @@ void JacobianSparseCSR::init(ModelInterface * model) {
 	m_yMod.resize(m_n);
 	m_ydotMod.resize(m_n);
 	m_ydiff.resize(m_n);
-	m_colors.clear();
+	// colors may have been set already via setColors(), in this case re-use them
+	if (m_colors.empty()) {
+		IBK::IBK_Message("SparseMatrix: generating color arrays\n",  IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+		generateColors(m_n, ia(), ja(), iaT(), jaT(), m_colors);
+	}
+	else {
+		IBK::IBK_Message("SparseMatrix: using given color arrays\n",  IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+	}
+
+	IBK::IBK_Message(IBK::FormatString("  %1 colors\n").arg((unsigned int) m_colors.size()),
+		IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+
+	// collect model replicas for concurrent evaluation of colors
+	m_replicas.clear();
+	m_yModReplicas.clear();
+	m_ydotModReplicas.clear();
+#if defined(_OPENMP)
+	// only use as many replicas as we have threads (the model itself is used by the first thread)
+	unsigned int nReplicas = std::min<unsigned int>(m_model->nReplicas(), (unsigned int)omp_get_max_threads() - 1);
+	// no need for replicas if we only have a single color
+	if (m_colors.size() < 2)
+		nReplicas = 0;
+	for (unsigned int i=0; i<nReplicas; ++i) {
+		ModelInterface * replica = m_model->replica(i);
+		if (replica == nullptr)
+			throw IBK::Exception(IBK::FormatString("Model returned invalid replica #%1.").arg(i), FUNC_ID);
+		m_replicas.push_back(replica);
+	}
+	m_yModReplicas.resize(m_replicas.size(), std::vector<double>(m_n));
+	m_ydotModReplicas.resize(m_replicas.size(), std::vector<double>(m_n));
+	if (!m_replicas.empty())
+		IBK::IBK_Message(IBK::FormatString("  Evaluating colors concurrently with %1 model replicas\n").arg((unsigned int)m_replicas.size()),
+			IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
+#endif // _OPENMP
+}
 
-	IBK::IBK_Message("SparseMatrix: generating color arrays\n",  IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 
-	// generate coloring information
+void JacobianSparseCSR::setColors(const std::vector<std::vector<unsigned int> > & colors) {
+	FUNCID(JacobianSparseCSR::setColors);
+	// check that each column is assigned exactly one color
+	std::vector<unsigned int> columnColored(m_n, 0);
+	for (const std::vector<unsigned int> & color : colors) {
+		for (unsigned int col : color) {
+			if (col >= m_n || columnColored[col] != 0)
+				throw IBK::Exception("Invalid color array (column index out of range or column assigned several colors).", FUNC_ID);
+			columnColored[col] = 1;
+		}
+	}
+	if (std::find(columnColored.begin(), columnColored.end(), 0) != columnColored.end())
+		throw IBK::Exception("Invalid color array (not all columns have been assigned a color).", FUNC_ID);
+	m_colors = colors;
+}
+
+
+void JacobianSparseCSR::generateColors(unsigned int n, const unsigned int * iaIdx, const unsigned int * jaIdx,
+									   const unsigned int * iaIdxT, const unsigned int * jaIdxT,
+									   std::vector<std::vector<unsigned int> > & colors)
+{
+	colors.clear();
 
 	// vector to hold colors associated with individual columns
-	std::vector<unsigned int> colarray(m_n, 0);
+	std::vector<unsigned int> colarray(n, 0);
 
 	// array to flag used colors
-	std::vector<unsigned int> scols(m_n+1); // must have size = m_n+1 since valid color numbers start with 1
-
-	const unsigned int * iaIdx  = ia();
-	const unsigned int * jaIdx  = ja();
-	const unsigned int * iaIdxT = iaT();
-	const unsigned int * jaIdxT = jaT();
+	std::vector<unsigned int> scols(n+1, 0); // must have size = n+1 since valid color numbers start with 1
+	// colors flagged in scols while processing the current column, used to reset scols afterwards
+	// (avoids clearing the complete scols array for each column, which is O(n^2) for large systems)
+	std::vector<unsigned int> markedColors;
 
 	// loop over all columns
-	for (unsigned int i=0; i<m_n; ++i) {
+	for (unsigned int i=0; i<n; ++i) {
 
 //#define DEBUG_OUTPUT_COLORING
 #ifdef DEBUG_OUTPUT_COLORING
 		std::cout << "column i=" << i << std::endl;
 #endif // DEBUG_OUTPUT_COLORING
-		// clear vector with neighboring colors
-		std::fill(scols.begin(), scols.end(), 0);
-
 		// loop over all rows, that have have entries in this column
 		// Note: this currently only works for symmetric matricies
 		unsigned int j;
@@ -83,7 +137,10 @@ void JacobianSparseCSR::init(ModelInterface * model) {
 				// k now holds column number in row j
 				if (k >= i && kind != 0) break; // stop if this column is > our current column i
 				// retrieve color of column and mark color as used
-				scols[ colarray[k] ] = 1;
+				if (scols[ colarray[k] ] == 0) {
+					scols[ colarray[k] ] = 1;
+					markedColors.push_back(colarray[k]);
+				}
 #ifdef DEBUG_OUTPUT_COLORING
 				if (colarray[k] != 0)
 					std::cout << "  marked color = " << colarray[k] << " while processing cell (row,col) " << j << "," << k << std::endl;
@@ -92,23 +149,24 @@ void JacobianSparseCSR::init(ModelInterface * model) {
 		}
 		// search lowest unused color
 		unsigned int colIdx = 1;
-		for (; colIdx < m_n; ++colIdx)
+		for (; colIdx < n; ++colIdx)
 			if (scols[colIdx] == 0)
 				break;
-		//IBK_ASSERT(colIdx != m_n); /// \todo check this, might fail when dense matrix is being used!!!
+		//IBK_ASSERT(colIdx != n); /// \todo check this, might fail when dense matrix is being used!!!
 		// set this color number in our colarray
 		colarray[i] = colIdx;
+		// clear flags of neighboring colors
+		for (unsigned int c : markedColors)
+			scols[c] = 0;
+		markedColors.clear();
 #ifdef DEBUG_OUTPUT_COLORING
 		std::cout << "  column gets color = " << colIdx << std::endl;
 #endif // DEBUG_OUTPUT_COLORING
 		// store color index in colors array
-		if (m_colors.size() < colIdx)
-			m_colors.resize(colIdx);
-		m_colors[colIdx-1].push_back(i); // associate column number with color
+		if (colors.size() < colIdx)
+			colors.resize(colIdx);
+		colors[colIdx-1].push_back(i); // associate column number with color
 	}
-
-	IBK::IBK_Message(IBK::FormatString("  %1 colors\n").arg((unsigned int) m_colors.size()),
-		IBK::MSG_PROGRESS, FUNC_ID, IBK::VL_STANDARD);
 }
 
 
@@ -121,60 +179,29 @@ int JacobianSparseCSR::setup(double t, const double * y, const double * ydot, co
 	// store current solution guess
 	std::memcpy(&m_yMod[0], y, m_n*sizeof(double));
 
-	const unsigned int * iaIdxT = iaT();
-	const unsigned int * jaIdxT = jaT();
-	double * dataArray = data();
-
-	// process all colors individually and modify y in groups
-	for (unsigned int i=0; i<m_colors.size(); ++i) {  // i == color index
-
-		// modify m_yMod[] in all columns marked by color i
-		for (unsigned int jind=0; jind<m_colors[i].size(); ++jind) {
-			unsigned int j = m_colors[i][jind];
-			// modify all y value in row j
-			m_ydiff[j] = std::fabs(y[j])*m_relToleranceDQ + m_absToleranceDQ;
-			m_yMod[j] += m_ydiff[j];
-		}
-
+#if defined(_OPENMP)
+	if (!m_replicas.empty()) {
+		// request replicas again, so that the model brings them to its current time-dependent state
+		for (unsigned int i=0; i<m_replicas.size(); ++i)
+			m_replicas[i] = m_model->replica(i);
 		SUNDIALS_TIMED_FUNCTION(SUNDIALS_TIMER_FEVAL_JACOBIAN_GENERATION,
-			// calculate modified right hand side
-			m_model->setY(&m_yMod[0]);
-			// calculate modified right hand side of the model, and store f(t,y) in m_FMod
-			m_model->ydot(&m_ydotMod[0]);
+			evaluateColorsConcurrently(t, y, ydot);
 		);
 		// update statistics
-		++m_nRhsEvals;
-
-		// compute Jacobian elements in groups
-		// df/dy = (f(y+eps) - f(y) )/eps
-		for (unsigned int jind=0; jind<m_colors[i].size(); ++jind) {
-			unsigned int j = m_colors[i][jind];
-			// we compute now all Jacobian elements in the column j
-
-			// we need to compute at max m_elementsPerRow DQ approximations
-			// loop over all column indices in current row -> since matrix
-			// is symmetrical (by structure), these column indices are also
-			// the row indices i of the elements i,j to compute
-			for (unsigned int k = iaIdxT[j]; k < iaIdxT[j + 1]; ++k) {
-				unsigned int rowIdx = jaIdxT[k];
-				// compute finite-differences column j in row i
-				double val = ( m_ydotMod[rowIdx] - ydot[rowIdx] )/m_ydiff[j];
-				// now set the computed derivative in the data storage
-				unsigned int colStorageIndex = storageIndex(rowIdx,j);
-				dataArray[colStorageIndex] = val;
-			} // for k
-
-		} // for jind
-
-		// restore original y vector at modified locations
-		for (unsigned int jind=0; jind<m_colors[i].size(); ++jind) {
-			unsigned int j = m_colors[i][jind];
-			m_yMod[j] = y[j];
-			// special case: dense pattern
-			m_ydiff[j] = 0;
-		} // for jind
-
-	} // for i
+		m_nRhsEvals += (unsigned int)m_colors.size();
+	}
+	else
+#endif // _OPENMP
+	{
+		// process all colors individually and modify y in groups
+		for (unsigned int i=0; i<m_colors.size(); ++i) {  // i == color index
+			SUNDIALS_TIMED_FUNCTION(SUNDIALS_TIMER_FEVAL_JACOBIAN_GENERATION,
+				evaluateColor(i, y, ydot, m_model, &m_yMod[0], &m_ydotMod[0]);
+			);
+			// update statistics
+			++m_nRhsEvals;
+		}
+	}
 
 	// m_jacobian now holds df/dy
 
@@ -217,6 +244,114 @@ int JacobianSparseCSR::setup(double t, const double * y, const double * ydot, co
 }
 
 
+void JacobianSparseCSR::evaluateColorsConcurrently(double t, const double * y, const double * ydot) {
+	FUNCID(JacobianSparseCSR::evaluateColorsConcurrently);
+
+#if defined(_OPENMP)
+	// thread-specific error messages, exceptions must not leave the parallel region
+	std::vector<std::string> threadErrors(m_replicas.size() + 1);
+
+#pragma omp parallel num_threads((int)m_replicas.size() + 1)
+	{
+		// thread 0 uses the model itself, all other threads use one replica each
+		unsigned int threadNum = (unsigned int)omp_get_thread_num();
+		ModelInterface * model = m_model;
+		double * yMod = &m_yMod[0];
+		double * ydotMod = &m_ydotMod[0];
+		try {
+			if (threadNum > 0) {
+				model = m_replicas[threadNum-1];
+				yMod = &m_yModReplicas[threadNum-1][0];
+				ydotMod = &m_ydotModReplicas[threadNum-1][0];
+				std::memcpy(yMod, y, m_n*sizeof(double));
+				// bring replica to the current time point
+				model->setTime(t);
+			}
+		}
+		catch (IBK::Exception & ex) {
+			threadErrors[threadNum] = ex.msgStack();
+		}
+
+		// colors have different numbers of columns, hence use dynamic scheduling
+#pragma omp for schedule(dynamic)
+		for (int i=0; i<(int)m_colors.size(); ++i) {
+			if (!threadErrors[threadNum].empty())
+				continue;
+			try {
+				evaluateColor((unsigned int)i, y, ydot, model, yMod, ydotMod);
+			}
+			catch (IBK::Exception & ex) {
+				threadErrors[threadNum] = ex.msgStack();
+			}
+		}
+	} // end parallel region
+
+	for (unsigned int i=0; i<threadErrors.size(); ++i)
+		if (!threadErrors[i].empty())
+			throw IBK::Exception(threadErrors[i], FUNC_ID);
+#else // _OPENMP
+	(void)t; (void)y; (void)ydot;
+	throw IBK::Exception("Concurrent evaluation of colors requires OpenMP.", FUNC_ID);
+#endif // _OPENMP
+}
+
+
+void JacobianSparseCSR::evaluateColor(unsigned int colorIdx, const double * y, const double * ydot,
+									  ModelInterface * model, double * yMod, double * ydotMod)
+{
+	const unsigned int * iaIdxT = iaT();
+	const unsigned int * jaIdxT = jaT();
+	double * dataArray = data();
+
+	// Note: columns of different colors are disjoint, hence concurrent evaluation of colors
+	//       writes to different elements of m_ydiff and the Jacobian data storage
+
+	const std::vector<unsigned int> & colorColumns = m_colors[colorIdx];
+
+	// modify yMod[] in all columns marked by color colorIdx
+	for (unsigned int jind=0; jind<colorColumns.size(); ++jind) {
+		unsigned int j = colorColumns[jind];
+		// modify all y value in row j
+		m_ydiff[j] = std::fabs(y[j])*m_relToleranceDQ + m_absToleranceDQ;
+		yMod[j] += m_ydiff[j];
+	}
+
+	// calculate modified right hand side
+	model->setY(yMod);
+	// calculate modified right hand side of the model, and store f(t,y) in ydotMod
+	model->ydot(ydotMod);
+
+	// compute Jacobian elements in groups
+	// df/dy = (f(y+eps) - f(y) )/eps
+	for (unsigned int jind=0; jind<colorColumns.size(); ++jind) {
+		unsigned int j = colorColumns[jind];
+		// we compute now all Jacobian elements in the column j
+
+		// we need to compute at max m_elementsPerRow DQ approximations
+		// loop over all column indices in current row -> since matrix
+		// is symmetrical (by structure), these column indices are also
+		// the row indices i of the elements i,j to compute
+		for (unsigned int k = iaIdxT[j]; k < iaIdxT[j + 1]; ++k) {
+			unsigned int rowIdx = jaIdxT[k];
+			// compute finite-differences column j in row i
+			double val = ( ydotMod[rowIdx] - ydot[rowIdx] )/m_ydiff[j];
+			// now set the computed derivative in the data storage
+			unsigned int colStorageIndex = storageIndex(rowIdx,j);
+			dataArray[colStorageIndex] = val;
+		} // for k
+
+	} // for jind
+
+	// restore original y vector at modified locations
+	for (unsigned int jind=0; jind<colorColumns.size(); ++jind) {
+		unsigned int j = colorColumns[jind];
+		yMod[j] = y[j];
+		// special case: dense pattern
+		m_ydiff[j] = 0;
+	} // for jind
+}
+
+
 IBKMK::SparseMatrix * JacobianSparseCSR::createAndReleaseJacobianCopy() const {
 	IBKMK::SparseMatrixCSR * jacCopy = new IBKMK::SparseMatrixCSR(m_n, m_nnz, constIa(), constJa());
 	return jacCopy;
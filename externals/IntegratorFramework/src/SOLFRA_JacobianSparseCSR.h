@@ -29,9 +29,32 @@ public:
 	JacobianSparseCSR(unsigned int n, unsigned int nnz, const unsigned int *ia, const unsigned int * ja,
 					  const unsigned int *iaT = nullptr, const unsigned int *jaT = nullptr);
 
-	/*! Initializes sparse matrix. */
+	/*! Initializes sparse matrix.
+		Generates the column coloring, unless colors have been set already via setColors().
+	*/
 	virtual void init(ModelInterface * model) override;
 
+	/*! Sets precomputed column colors (for example read from a cache file), so that init() can skip
+		the color generation. Must be called before init().
+		Throws an IBK::Exception if colors do not assign exactly one color to each column.
+	*/
+	void setColors(const std::vector<std::vector<unsigned int> > & colors);
+
+	/*! Returns column colors (available after init() or setColors()). */
+	const std::vector<std::vector<unsigned int> > & colors() const { return m_colors; }
+
+	/*! Generates column colors for the sparse matrix pattern given in CSR format (and transposed CSR format).
+		Columns with the same color do not share any row and can be evaluated together in the
+		difference-quotient approximation.
+		\param n Matrix dimension.
+		\param iaIdx, jaIdx CSR index vectors.
+		\param iaIdxT, jaIdxT Transposed CSR index vectors.
+		\param colors Vector of colors, each holding the column indexes of the respective color.
+	*/
+	static void generateColors(unsigned int n, const unsigned int * iaIdx, const unsigned int * jaIdx,
+							   const unsigned int * iaIdxT, const unsigned int * jaIdxT,
+							   std::vector<std::vector<unsigned int> > & colors);
+
 	/*! In this function, the preconditioner matrix is composed an LU-factorised.
 		This function is called from the linear equation solver during iterations.
 		\param y The current prediction of the solution.
@@ -86,9 +109,32 @@ public:
 	double									m_absToleranceDQ;
 
 protected:
+	/*! Computes finite-difference approximations of all Jacobian columns of color colorIdx.
+		\param model Model (or model replica) to evaluate.
+		\param yMod Work vector of size m_n, must hold y on input and will hold y on return.
+		\param ydotMod Work vector of size m_n.
+	*/
+	void evaluateColor(unsigned int colorIdx, const double * y, const double * ydot,
+					   ModelInterface * model, double * yMod, double * ydotMod);
+
+	/*! Computes finite-difference approximations of all colors, distributed among the model and its replicas.
+		Each thread evaluates a subset of colors with its own model object and work vectors.
+		\note Requires OpenMP, only called when m_replicas is not empty.
+	*/
+	void evaluateColorsConcurrently(double t, const double * y, const double * ydot);
+
 	/*! Pointer to the underlying model. */
 	ModelInterface							*m_model;
 
+	/*! Model replicas used to evaluate colors concurrently (not owned), set in init() and requested again in setup().
+		If empty, all colors are evaluated sequentially with m_model.
+	*/
+	std::vector<ModelInterface*>			m_replicas;
+	/*! Work vectors for y values of replicas, size m_replicas.size() x m_n. */
+	std::vector<std::vector<double> >		m_yModReplicas;
+	/*! Work vectors for ydot values of replicas, size m_replicas.size() x m_n. */
+	std::vector<std::vector<double> >		m_ydotModReplicas;
+
 	/*! Coloring information, vector of vectors with maximum size m_n, that holds coloring information.
 		The outer vector holds colors, whereas the inner vector holds the corresponding columns. The
 		vector is generated in setColoringType(), when coloring type is automatic.
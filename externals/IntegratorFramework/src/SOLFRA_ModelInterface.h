@@ -175,6 +175,23 @@ public:
 	*/
 	virtual void deserialize(void* & dataPtr) { (void)dataPtr; }
 
+	/*! Returns the number of model replicas that can be evaluated concurrently with this model instance.
+		A replica is an independent model object with its own state, that computes the same ydot() as the model
+		itself when given the same time point and solution. Replicas are used, for example, by JacobianSparseCSR
+		to evaluate several colors of the finite-difference Jacobian in parallel.
+		Default implementation returns 0 (no replicas).
+	*/
+	virtual unsigned int nReplicas() const { return 0; }
+
+	/*! Returns model replica with index i, with 0 <= i < nReplicas().
+		The replica is owned by the model. The returned replica must be in the same time-dependent state
+		as the model (i.e. as if it had received the same stepCompleted() calls), setTime() and setY() are
+		called on the replica by the user. Users request the replicas again before each use, so that the
+		model may update them lazily.
+		Default implementation returns nullptr.
+	*/
+	virtual ModelInterface * replica(unsigned int i) { (void)i; return nullptr; }
+
 	/*! Writes currently collected metrics/statistics of the model evaluation function to output.
 		The collected statistics will be printed just below the LES solver statistics block.
 		When re-implementing this function, please use the same formatting/layout for the table to
@@ -0,0 +1,276 @@
+#include "SOLFRA_PrecondBlockJacobi.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <IBK_assert.h>
+#include <IBK_Exception.h>
+#include <IBK_FormatString.h>
+#include <IBKMK_SparseMatrixCSR.h>
+
+#include "SOLFRA_JacobianSparse.h"
+#include "SOLFRA_ModelInterface.h"
+
+namespace SOLFRA {
+
+PrecondBlockJacobi::PrecondBlockJacobi(PreconditionerType precondType, const std::vector<unsigned int> & blockOffsets) :
+	PrecondInterface(precondType),
+	m_jacobianSparse(nullptr),
+	m_blockOffsets(blockOffsets)
+{
+}
+
+
+void PrecondBlockJacobi::init(ModelInterface * model, IntegratorInterface * integrator,
+							  const JacobianInterface *jacobianInterface)
+{
+	FUNCID(PrecondBlockJacobi::init);
+
+	m_integrator = integrator;
+	m_model = model;
+
+	// transfer jacobian matrix and ensure it is a sparse Jacobian implementation in CSR format
+	m_jacobianSparse = dynamic_cast<const JacobianSparse*>(jacobianInterface);
+	IBK_ASSERT(m_jacobianSparse != nullptr);
+	const IBKMK::SparseMatrixCSR * jac = dynamic_cast<const IBKMK::SparseMatrixCSR*>(m_jacobianSparse->jacobian());
+	if (jac == nullptr)
+		throw IBK::Exception("Block-Jacobi preconditioner requires a Jacobian matrix in CSR format.", FUNC_ID);
+
+	unsigned int n = jac->n();
+	if (m_blockOffsets.size() < 2 || m_blockOffsets.front() != 0 || m_blockOffsets.back() != n)
+		throw IBK::Exception(IBK::FormatString("Invalid block partition for block-Jacobi preconditioner "
+											   "(must start with 0 and end with system size %1).").arg(n), FUNC_ID);
+
+	const unsigned int * ia = jac->constIa();
+	const unsigned int * ja = jac->constJa();
+
+	m_blocks.clear();
+	m_blocks.reserve(m_blockOffsets.size()-1);
+	for (unsigned int b=0; b+1<m_blockOffsets.size(); ++b) {
+		if (m_blockOffsets[b+1] <= m_blockOffsets[b])
+			throw IBK::Exception(IBK::FormatString("Invalid block partition for block-Jacobi preconditioner "
+												   "(block #%1 is empty).").arg(b), FUNC_ID);
+		m_blocks.push_back(Block());
+		Block & block = m_blocks.back();
+		block.m_offset = m_blockOffsets[b];
+		block.m_n = m_blockOffsets[b+1] - block.m_offset;
+
+		// check if all coefficients within the block lie on the three central diagonals
+		bool tridiagonal = true;
+		for (unsigned int i=block.m_offset; i<block.m_offset+block.m_n && tridiagonal; ++i) {
+			for (unsigned int k=ia[i]; k<ia[i+1]; ++k) {
+				unsigned int j = ja[k];
+				if (j < block.m_offset || j >= block.m_offset + block.m_n)
+					continue; // coupling to other block, ignored
+				if (j+1 < i || j > i+1) {
+					tridiagonal = false;
+					break;
+				}
+			}
+		}
+
+		if (tridiagonal) {
+			block.m_type = BT_Tridiagonal;
+			block.m_triStorageIndexes.resize(3*block.m_n, -1);
+			block.m_triFactors.resize(3*block.m_n, 0);
+			for (unsigned int i=block.m_offset; i<block.m_offset+block.m_n; ++i) {
+				for (unsigned int k=ia[i]; k<ia[i+1]; ++k) {
+					unsigned int j = ja[k];
+					if (j < block.m_offset || j >= block.m_offset + block.m_n)
+						continue;
+					// 0 - lower, 1 - diagonal, 2 - upper
+					block.m_triStorageIndexes[3*(i-block.m_offset) + 1 + j - i] = (int)k;
+				}
+			}
+		}
+		else {
+			// collect local pattern of block, CSR column indexes are sorted, hence local indexes are sorted as well
+			block.m_type = BT_Sparse;
+			std::vector<unsigned int> iaBlock(1, 0);
+			std::vector<unsigned int> jaBlock;
+			for (unsigned int i=block.m_offset; i<block.m_offset+block.m_n; ++i) {
+				block.m_diagIndexes.push_back((unsigned int)-1);
+				for (unsigned int k=ia[i]; k<ia[i+1]; ++k) {
+					unsigned int j = ja[k];
+					if (j < block.m_offset || j >= block.m_offset + block.m_n)
+						continue;
+					if (j == i)
+						block.m_diagIndexes.back() = (unsigned int)jaBlock.size();
+					jaBlock.push_back(j - block.m_offset);
+					block.m_storageIndexes.push_back(k);
+				}
+				// ILU requires all diagonal elements to be part of the pattern
+				if (block.m_diagIndexes.back() == (unsigned int)-1)
+					throw IBK::Exception(IBK::FormatString("Missing diagonal element in Jacobian pattern "
+														   "(row %1).").arg(i), FUNC_ID);
+				iaBlock.push_back((unsigned int)jaBlock.size());
+			}
+			std::vector<unsigned int> iaBlockT, jaBlockT;
+			IBKMK::SparseMatrixCSR::generateTransposedIndex(iaBlock, jaBlock, iaBlockT, jaBlockT);
+			block.m_matrix.resize(block.m_n, (unsigned int)jaBlock.size(), &iaBlock[0], &jaBlock[0],
+								  &iaBlockT[0], &jaBlockT[0]);
+		}
+	}
+}
+
+
+int PrecondBlockJacobi::setup(double t, const double * y, const double * ydot, const double * residuals,
+	bool jacOk, bool & jacUpdated, double gamma)
+{
+	(void)t;
+	(void)y;
+	(void)ydot;
+	(void)residuals;
+	(void)jacUpdated;
+	(void)jacOk;
+
+	const double * jacData = m_jacobianSparse->jacobian()->data();
+
+	int zeroPivots = 0;
+	// blocks have very different sizes, hence use dynamic scheduling
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic,16) reduction(+:zeroPivots)
+#endif
+	for (int b=0; b<(int)m_blocks.size(); ++b) {
+		Block & block = m_blocks[(unsigned int)b];
+		if (block.m_type == BT_Tridiagonal) {
+			if (!factorizeTridiagonal(block, jacData, gamma))
+				++zeroPivots;
+		}
+		else {
+			if (!factorizeSparse(block, jacData, gamma))
+				++zeroPivots;
+		}
+	}
+	return zeroPivots == 0 ? 0 : 1;
+}
+
+
+int PrecondBlockJacobi::solve(double t, const double * y, const double * ydot, const double * residuals,
+	const double * r, double * z, double gamma, double delta, int lr)
+{
+	(void)t;
+	(void)y;
+	(void)ydot;
+	(void)residuals;
+	(void)gamma;
+	(void)delta;
+	(void)lr;
+
+	// copy right hand side to z-vector
+	std::memcpy(z, r, m_blockOffsets.back()*sizeof(double));
+
+	// solve all blocks in-place
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+	for (int b=0; b<(int)m_blocks.size(); ++b) {
+		const Block & block = m_blocks[(unsigned int)b];
+		if (block.m_type == BT_Tridiagonal)
+			solveTridiagonal(block, z + block.m_offset);
+		else
+			block.m_matrix.backsolveILU(z + block.m_offset);
+	}
+	return 0;
+}
+
+
+std::size_t PrecondBlockJacobi::serializationSize() const {
+	std::size_t s = 0;
+	for (const Block & block : m_blocks) {
+		if (block.m_type == BT_Tridiagonal)
+			s += block.m_triFactors.size()*sizeof(double);
+		else
+			s += block.m_matrix.dataSize()*sizeof(double);
+	}
+	return s;
+}
+
+
+void PrecondBlockJacobi::serialize(void* & dataPtr) const {
+	for (const Block & block : m_blocks) {
+		if (block.m_type == BT_Tridiagonal) {
+			std::memcpy(dataPtr, &block.m_triFactors[0], block.m_triFactors.size()*sizeof(double));
+			dataPtr = (char*)dataPtr + block.m_triFactors.size()*sizeof(double);
+		}
+		else {
+			std::memcpy(dataPtr, block.m_matrix.data(), block.m_matrix.dataSize()*sizeof(double));
+			dataPtr = (char*)dataPtr + block.m_matrix.dataSize()*sizeof(double);
+		}
+	}
+}
+
+
+void PrecondBlockJacobi::deserialize(void* & dataPtr) {
+	for (Block & block : m_blocks) {
+		if (block.m_type == BT_Tridiagonal) {
+			std::memcpy(&block.m_triFactors[0], dataPtr, block.m_triFactors.size()*sizeof(double));
+			dataPtr = (char*)dataPtr + block.m_triFactors.size()*sizeof(double);
+		}
+		else {
+			std::memcpy(block.m_matrix.data(), dataPtr, block.m_matrix.dataSize()*sizeof(double));
+			dataPtr = (char*)dataPtr + block.m_matrix.dataSize()*sizeof(double);
+		}
+	}
+}
+
+
+unsigned int PrecondBlockJacobi::tridiagonalBlockCount() const {
+	unsigned int count = 0;
+	for (const Block & block : m_blocks)
+		if (block.m_type == BT_Tridiagonal)
+			++count;
+	return count;
+}
+
+
+bool PrecondBlockJacobi::factorizeTridiagonal(Block & block, const double * jacData, double gamma) {
+	const int * idx = &block.m_triStorageIndexes[0];
+	double * f = &block.m_triFactors[0];
+
+	// Thomas algorithm for matrix I - gamma*J: f[3i] = l_i, f[3i+1] = 1/u_ii, f[3i+2] = u_i,i+1
+	double pivot = 1 - gamma*jacobianCoefficient(idx[1], jacData);
+	for (unsigned int i=0; ; ) {
+		if (pivot == 0.0 || !std::isfinite(pivot))
+			return false;
+		f[3*i+1] = 1/pivot;
+		f[3*i+2] = -gamma*jacobianCoefficient(idx[3*i+2], jacData);
+		if (++i == block.m_n)
+			break;
+		f[3*i] = -gamma*jacobianCoefficient(idx[3*i], jacData)*f[3*(i-1)+1];
+		pivot = 1 - gamma*jacobianCoefficient(idx[3*i+1], jacData) - f[3*i]*f[3*(i-1)+2];
+	}
+	return true;
+}
+
+
+bool PrecondBlockJacobi::factorizeSparse(Block & block, const double * jacData, double gamma) {
+	// copy block data, scale with -gamma and add identity matrix
+	double * blockData = block.m_matrix.data();
+	for (unsigned int k=0; k<block.m_storageIndexes.size(); ++k)
+		blockData[k] = -gamma*jacData[block.m_storageIndexes[k]];
+	block.m_matrix.addIdentityMatrix();
+	block.m_matrix.ilu();
+	// ILU keeps the pivots on the diagonal
+	for (unsigned int k : block.m_diagIndexes) {
+		if (blockData[k] == 0.0 || !std::isfinite(blockData[k]))
+			return false;
+	}
+	return true;
+}
+
+
+void PrecondBlockJacobi::solveTridiagonal(const Block & block, double * z) {
+	const double * f = &block.m_triFactors[0];
+	// forward elimination
+	for (unsigned int i=1; i<block.m_n; ++i)
+		z[i] -= f[3*i]*z[i-1];
+	// backward substitution
+	unsigned int i = block.m_n-1;
+	z[i] *= f[3*i+1];
+	while (i-- > 0)
+		z[i] = (z[i] - f[3*i+2]*z[i+1])*f[3*i+1];
+}
+
+
+} // namespace SOLFRA
@@ -0,0 +1,135 @@
+#ifndef SOLFRA_PrecondBlockJacobiH
+#define SOLFRA_PrecondBlockJacobiH
+
+#include "SOLFRA_PrecondInterface.h"
+
+#include <vector>
+
+#include <IBKMK_SparseMatrixCSR.h>
+
+namespace SOLFRA {
+
+class IntegratorInterface;
+class JacobianSparse;
+class ModelInterface;
+
+/*! A block-Jacobi pre-conditioner supporting the SUNDIALS precond interface.
+
+	The unknowns are partitioned into contiguous blocks (for example zone states, the element chains of
+	constructions and network states). The preconditioner matrix is the block-diagonal part of I - gamma*df/dy,
+	i.e. all coupling coefficients between blocks are dropped. Each block is factorized and solved independently,
+	so that blocks are processed concurrently when compiled with OpenMP.
+
+	The block type is determined from the Jacobian pattern during init():
+	- blocks whose entries lie on the three central diagonals (e.g. 1D heat conduction in constructions, single-state
+	  zones) are factorized exactly with the Thomas algorithm,
+	- all other blocks are factorized with an incomplete LU factorization (ILU(0)) on the sparse block pattern.
+
+	Requires a Jacobian implementation in CSR format (JacobianSparseCSR).
+*/
+class PrecondBlockJacobi : public PrecondInterface {
+public:
+	/*! Initializes PrecondBlockJacobi.
+		\param blockOffsets Index of the first unknown of each block, in increasing order (first value must be 0),
+			followed by the total number of unknowns.
+	*/
+	PrecondBlockJacobi(PreconditionerType precondType, const std::vector<unsigned int> & blockOffsets);
+
+	/*! Returns type of precondition (where it should be applied in context of the iteration linear equation solver). */
+	virtual PreconditionerType preconditionerType() const override { return m_precondType; }
+
+	/*! Initialize the preconditioner, called from the
+		framework before integration is started. Analyses the pattern of the Jacobian and
+		sets up block data structures.
+	*/
+	virtual void init(ModelInterface * model, IntegratorInterface * integrator,
+					  const JacobianInterface * jacobianInterface) override;
+
+	/*! In this function, all blocks of the preconditioner matrix are composed and factorized.
+		\return Returns 1 (recoverable error) if a zero pivot was encountered in any block.
+	*/
+	virtual int setup(double t, const double * y, const double * ydot, const double * residuals,
+		bool jacOk, bool & jacUpdated, double gamma) override;
+
+	virtual int solve(double t, const double * y, const double * ydot, const double * residuals,
+		const double * r, double * z, double gamma, double delta, int lr) override;
+
+	/*! Holds number of RHS function evaluations (ydot()/residual() calls) used for generating
+		the preconditioner.
+	*/
+	virtual unsigned int nRHSEvals() const override { return 0; }
+
+	/*! Computes and returns serialization size. */
+	virtual std::size_t serializationSize() const override;
+
+	/*! Stores factorized block data at memory location pointed to by dataPtr and increases
+		pointer afterwards to point just behind the memory occupied by the copied data.
+	*/
+	virtual void serialize(void* & dataPtr) const override;
+
+	/*! Restores factorized block data from memory at location pointed to by dataPtr and increases
+		pointer afterwards to point just behind the memory occupied by the copied data.
+	*/
+	virtual void deserialize(void* & dataPtr) override;
+
+	/*! Number of blocks. */
+	unsigned int blockCount() const { return (unsigned int)m_blocks.size(); }
+	/*! Number of blocks that are factorized with the Thomas algorithm (available after init()). */
+	unsigned int tridiagonalBlockCount() const;
+
+private:
+	/*! Factorization method of a block. */
+	enum BlockType {
+		BT_Tridiagonal,
+		BT_Sparse
+	};
+
+	/*! Data of a single diagonal block. */
+	struct Block {
+		BlockType					m_type;
+		/*! Index of first unknown. */
+		unsigned int				m_offset;
+		/*! Number of unknowns. */
+		unsigned int				m_n;
+
+		/*! BT_Tridiagonal: storage index of the coefficients of each row in Jacobian data, -1 for coefficients not in pattern.
+			Indexes 3*i, 3*i+1 and 3*i+2 hold lower, diagonal and upper coefficient of row i.
+		*/
+		std::vector<int>			m_triStorageIndexes;
+		/*! BT_Tridiagonal: LU-factors, 3*i holds lower factor, 3*i+1 the inverse pivot and 3*i+2 the upper coefficient of row i. */
+		std::vector<double>			m_triFactors;
+
+		/*! BT_Sparse: storage index in Jacobian data of each non-zero in m_matrix. */
+		std::vector<unsigned int>	m_storageIndexes;
+		/*! BT_Sparse: storage index of the diagonal element of each row in m_matrix. */
+		std::vector<unsigned int>	m_diagIndexes;
+		/*! BT_Sparse: block matrix, holds ILU factors after setup(). */
+		IBKMK::SparseMatrixCSR		m_matrix;
+	};
+
+	/*! Composes and factorizes a tridiagonal block.
+		\return Returns false if a zero pivot was encountered.
+	*/
+	static bool factorizeTridiagonal(Block & block, const double * jacData, double gamma);
+	/*! Composes and ILU-factorizes a sparse block.
+		\return Returns false if a zero pivot was encountered.
+	*/
+	static bool factorizeSparse(Block & block, const double * jacData, double gamma);
+	/*! Solves a tridiagonal block in-place. */
+	static void solveTridiagonal(const Block & block, double * z);
+	/*! Returns Jacobian coefficient with given storage index, 0 for storageIndex == -1. */
+	static double jacobianCoefficient(int storageIndex, const double * jacData) {
+		return storageIndex == -1 ? 0.0 : jacData[storageIndex];
+	}
+
+	/*! Jacobian matrix, data is transferred within setup(). */
+	const JacobianSparse					*m_jacobianSparse;
+	/*! Block offsets as passed to constructor. */
+	std::vector<unsigned int>				m_blockOffsets;
+	/*! All blocks, set up in init(). */
+	std::vector<Block>						m_blocks;
+};
+
+} // namespace SOLFRA
+
+#endif // SOLFRA_PrecondBlockJacobiH
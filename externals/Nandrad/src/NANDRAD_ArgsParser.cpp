@@ -31,6 +31,11 @@ ArgsParser::ArgsParser() {
 		"");
 	addFlag(0, "fmu-modelica-wrapper",
 		"(optional) If given, a Modelica wrapper for the exported FMU is created. Only works in combination with 'fmu-export'.");
+	addOption(0, "init-cache-dir",
+		"(optional) Directory to store/look up cached initialization data (Jacobian pattern and colors) in. "
+		"Solver runs of projects with the same model topology re-use the cached data. Defaults to the var directory of the project.",
+		"directory",
+		"");
 
 	// adjust options for les-solver, integrator and precond to show only the options available for NANDRAD
 	for (OptionType & ot : m_knownOptions) {
@@ -41,7 +46,7 @@ ArgsParser::ArgsParser() {
 			ot.m_description = "auto|Dense|KLU|GMRES|BiCGStab";
 		}
 		else if (ot.m_longVersion == "precond") {
-			ot.m_description = "auto|ILU";
+			ot.m_description = "auto|ILU|BlockJacobi";
 		}
 	}
 }
@@ -54,7 +54,9 @@ public:
 	ModelType										m_modelType		= MT_ThermalHydraulicNetwork;	// XML:A:required
 
 	/*! at the inlet node of the reference element,
-	 * the reference pressure will be applied (usually should be the pump) */
+	 * the reference pressure will be applied (usually should be the pump)
+	 * In hydraulically separated parts of the network, that do not contain the reference element,
+	 * the reference pressure is applied at the inlet node of the first element of the part. */
 	unsigned int									m_referenceElementId = INVALID_ID;				// XML:A:required
 
 	HydraulicFluid									m_fluid;										// XML:E
@@ -351,6 +351,7 @@ namespace NANDRAD {
 				case 1 : return "Longitude";
 				case 2 : return "Albedo";
 				case 3 : return "Altitude";
+				case 4 : return "SolarRadiationTableStep";
 			} break;
 			// Material::para_t
 			case 35 :
@@ -554,7 +555,8 @@ namespace NANDRAD {
 			case 59 :
 			switch (t) {
 				case 0 : return "ILU";
-				case 1 : return "auto";
+				case 1 : return "BlockJacobi";
+				case 2 : return "auto";
 			} break;
 			// WindowGlazingLayer::type_t
 			case 60 :
@@ -866,6 +868,7 @@ namespace NANDRAD {
 				case 1 : return "Longitude";
 				case 2 : return "Albedo";
 				case 3 : return "Altitude";
+				case 4 : return "SolarRadiationTableStep";
 			} break;
 			// Material::para_t
 			case 35 :
@@ -1069,7 +1072,8 @@ namespace NANDRAD {
 			case 59 :
 			switch (t) {
 				case 0 : return "ILU";
-				case 1 : return "auto";
+				case 1 : return "BlockJacobi";
+				case 2 : return "auto";
 			} break;
 			// WindowGlazingLayer::type_t
 			case 60 :
@@ -1382,6 +1386,7 @@ namespace NANDRAD {
 				case 1 : return "Longitude.";
 				case 2 : return "Albedo value [0..100 %].";
 				case 3 : return "Altitude of building as height above NN [m].";
+				case 4 : return "Step size of precomputed annual solar radiation table (exact computation if not given).";
 			} break;
 			// Material::para_t
 			case 35 :
@@ -1585,7 +1590,8 @@ namespace NANDRAD {
 			case 59 :
 			switch (t) {
 				case 0 : return "Incomplete LU preconditioner";
-				case 1 : return "Automatic selection of preconditioner";
+				case 1 : return "Block-Jacobi preconditioner with independently factorized zone, construction and network blocks";
+				case 2 : return "Automatic selection of preconditioner";
 			} break;
 			// WindowGlazingLayer::type_t
 			case 60 :
@@ -1897,6 +1903,7 @@ namespace NANDRAD {
 				case 1 : return "Deg";
 				case 2 : return "%";
 				case 3 : return "m";
+				case 4 : return "min";
 			} break;
 			// Material::para_t
 			case 35 :
@@ -2101,6 +2108,7 @@ namespace NANDRAD {
 			switch (t) {
 				case 0 : return "";
 				case 1 : return "";
+				case 2 : return "";
 			} break;
 			// WindowGlazingLayer::type_t
 			case 60 :
@@ -2412,6 +2420,7 @@ namespace NANDRAD {
 				case 1 : return "#FFFFFF";
 				case 2 : return "#FFFFFF";
 				case 3 : return "#FFFFFF";
+				case 4 : return "#FFFFFF";
 			} break;
 			// Material::para_t
 			case 35 :
@@ -2616,6 +2625,7 @@ namespace NANDRAD {
 			switch (t) {
 				case 0 : return "#FFFFFF";
 				case 1 : return "#FFFFFF";
+				case 2 : return "#FFFFFF";
 			} break;
 			// WindowGlazingLayer::type_t
 			case 60 :
@@ -2927,6 +2937,7 @@ namespace NANDRAD {
 				case 1 : return std::numeric_limits<double>::quiet_NaN();
 				case 2 : return std::numeric_limits<double>::quiet_NaN();
 				case 3 : return std::numeric_limits<double>::quiet_NaN();
+				case 4 : return std::numeric_limits<double>::quiet_NaN();
 			} break;
 			// Material::para_t
 			case 35 :
@@ -3131,6 +3142,7 @@ namespace NANDRAD {
 			switch (t) {
 				case 0 : return std::numeric_limits<double>::quiet_NaN();
 				case 1 : return std::numeric_limits<double>::quiet_NaN();
+				case 2 : return std::numeric_limits<double>::quiet_NaN();
 			} break;
 			// WindowGlazingLayer::type_t
 			case 60 :
@@ -3281,7 +3293,7 @@ namespace NANDRAD {
 			// LinearSplineParameter::wrapMethod_t
 			case 33 : return 2;
 			// Location::para_t
-			case 34 : return 4;
+			case 34 : return 5;
 			// Material::para_t
 			case 35 : return 3;
 			// ModelInputReference::referenceType_t
@@ -3331,7 +3343,7 @@ namespace NANDRAD {
 			// SolverParameter::lesSolver_t
 			case 58 : return 5;
 			// SolverParameter::precond_t
-			case 59 : return 2;
+			case 59 : return 3;
 			// WindowGlazingLayer::type_t
 			case 60 : return 2;
 			// WindowGlazingLayer::para_t
@@ -3429,7 +3441,7 @@ namespace NANDRAD {
 			// LinearSplineParameter::wrapMethod_t
 			case 33 : return 1;
 			// Location::para_t
-			case 34 : return 3;
+			case 34 : return 4;
 			// Material::para_t
 			case 35 : return 2;
 			// ModelInputReference::referenceType_t
@@ -3479,7 +3491,7 @@ namespace NANDRAD {
 			// SolverParameter::lesSolver_t
 			case 58 : return 4;
 			// SolverParameter::precond_t
-			case 59 : return 1;
+			case 59 : return 2;
 			// WindowGlazingLayer::type_t
 			case 60 : return 1;
 			// WindowGlazingLayer::para_t
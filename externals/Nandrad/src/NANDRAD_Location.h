@@ -47,6 +47,8 @@ public:
 		P_Albedo,					// Keyword: Albedo			[%]		'Albedo value [0..100 %].'
 		/*! Altitude of building as height above NN [m]. */
 		P_Altitude,					// Keyword: Altitude		[m]		'Altitude of building as height above NN [m].'
+		/*! Step size of precomputed annual solar radiation table, if given radiation loads are interpolated from the table. */
+		P_SolarRadiationTableStep,	// Keyword: SolarRadiationTableStep	[min]	'Step size of precomputed annual solar radiation table (exact computation if not given).'
 		NUM_P
 	};
 
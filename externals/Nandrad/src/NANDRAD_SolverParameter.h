@@ -106,6 +106,7 @@ public:
 	/*! Enumeration of available preconditioners, to be used with iterative LES solvers. */
 	enum precond_t {
 		PRE_ILU,						// Keyword: ILU							'Incomplete LU preconditioner'
+		PRE_BlockJacobi,				// Keyword: BlockJacobi					'Block-Jacobi preconditioner with independently factorized zone, construction and network blocks'
 		NUM_PRE							// Keyword: auto						'Automatic selection of preconditioner'
 	};
 
@@ -208,11 +208,10 @@ void writeVector3D(TiXmlElement * parent, const std::string & name, const std::v
 
 void readVector3D(const TiXmlElement * element, const std::string & name, std::vector<IBKMK::Vector3D> & vec) {
 	FUNCID(NANDRAD::readVector3D);
-	std::string text = element->GetText();
-	text = IBK::replace_string(text, ",", " ");
 	std::vector<double> vals;
 	try {
-		IBK::string2valueVector(text, vals);
+		// parse directly from element text, values may be separated by commas and/or white-spaces
+		IBK::string2valueVector(element->GetText(), vals, true);
 		// must have n*3 elements
 		if (vals.size() % 3 != 0)
 			throw IBK::Exception("Mismatching number of values.", FUNC_ID);
@@ -231,10 +230,9 @@ void readVector3D(const TiXmlElement * element, const std::string & name, std::v
 template<>
 void readVector<double>(const TiXmlElement * element, const std::string & name, std::vector<double> & vec) {
 	FUNCID(NANDRAD::readVector);
-	std::string text = element->GetText();
-	text = IBK::replace_string(text, ",", " ");
 	try {
-		IBK::string2valueVector(text, vec);
+		// parse directly from element text, values may be separated by commas and/or white-spaces
+		IBK::string2valueVector(element->GetText(), vec, true);
 	} catch (IBK::Exception & ex) {
 		throw IBK::Exception( ex, IBK::FormatString(XML_READ_ERROR).arg(element->Row()).arg(
 			IBK::FormatString("Error reading vector element '%1'.").arg(name) ), FUNC_ID);
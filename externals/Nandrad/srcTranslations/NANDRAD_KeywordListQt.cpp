@@ -116,6 +116,7 @@ KeywordListQt::KeywordListQt() {
 	tr("Longitude.");
 	tr("Albedo value [0..100 %].");
 	tr("Altitude of building as height above NN [m].");
+	tr("Step size of precomputed annual solar radiation table (exact computation if not given).");
 	tr("Dry density of the material.");
 	tr("Specific heat capacity of the material.");
 	tr("Thermal conductivity of the dry material.");
@@ -219,6 +220,7 @@ KeywordListQt::KeywordListQt() {
 	tr("BICGSTAB iterative solver");
 	tr("Automatic selection of linear equation system solver");
 	tr("Incomplete LU preconditioner");
+	tr("Block-Jacobi preconditioner with independently factorized zone, construction and network blocks");
 	tr("Automatic selection of preconditioner");
 	tr("Gas layer");
 	tr("Glass layer");
@@ -1158,21 +1158,15 @@ void TiXmlElement::readIBKUnitVectorElement( const TiXmlElement * element,
 	}
 	unit = attrib->Value();
 
-	const char * const str = element->GetText();
-	std::string valstr;
-	if (str) {
-		valstr = str;
-		try {
-			IBK::string2valueVector(valstr, data);
-		} catch (IBK::Exception & ex) {
-			std::stringstream strm;
-			strm << "Error in XML file, line " << element->Row() << ": ";
-			strm << ex.what();
-			throw std::runtime_error(strm.str());
-		}
+	// parse directly from element text (empty vector if element has no text)
+	try {
+		IBK::string2valueVector(element->GetText(), data);
+	} catch (IBK::Exception & ex) {
+		std::stringstream strm;
+		strm << "Error in XML file, line " << element->Row() << ": ";
+		strm << ex.what();
+		throw std::runtime_error(strm.str());
 	}
-	else
-		data.clear();
 }
 
 
@@ -1278,24 +1272,13 @@ void TiXmlElement::appendIBKVectorElement( TiXmlElement * parent,
 void TiXmlElement::readIBKVectorElement( const TiXmlElement * element,
 									  std::vector<double> & data)
 {
-	const char * const str = element->GetText();
-	std::string valstr;
-	if (str)		valstr = str;
-	else			valstr.clear();
-	std::stringstream sstrm(valstr);
-	data.clear();
-	std::string s;
-	while (sstrm >> s) {
-		std::stringstream valstr(s);
-		double v;
-		if (!(valstr >> v)) {
-			std::stringstream strm;
-			strm << "Error in XML file, line " << element->Row() << ": ";
-			strm << "Invalid floating point value '" << s << "' in vector.";
-			throw std::runtime_error(strm.str());
-		}
-
-		data.push_back(v);
+	try {
+		IBK::string2valueVector(element->GetText(), data);
+	} catch (IBK::Exception & ex) {
+		std::stringstream strm;
+		strm << "Error in XML file, line " << element->Row() << ": ";
+		strm << "Invalid floating point value in vector: " << ex.what();
+		throw std::runtime_error(strm.str());
 	}
 }
 
@@ -286,7 +286,17 @@ void TiXmlParsingData::Stamp( const char* now, TiXmlEncoding encoding )
 				break;
 
 			default:
-				if ( encoding == TIXML_ENCODING_UTF8 )
+				if ( *pU >= 0x20 && *pU < 0x80 )
+				{
+					// Eat a run of plain ASCII characters at once, one column each.
+					// This matters for elements with large texts, i.e. number lists.
+					const char* q = p + 1;
+					while ( q < now && (unsigned char)*q >= 0x20 && (unsigned char)*q < 0x80 )
+						++q;
+					col += (int)( q - p );
+					p = q;
+				}
+				else if ( encoding == TIXML_ENCODING_UTF8 )
 				{
 					// Eat the 1 to 4 byte utf8 character.
 					int step = TiXmlBase::utf8ByteTable[*((const unsigned char*)p)];
@@ -590,6 +600,21 @@ const char* TiXmlBase::ReadText(	const char* p,
 				&& !StringEqual( p, endTag, caseInsensitive, encoding )
 			  )
 		{
+			// Append a run of plain ASCII characters at once. Character-wise processing
+			// is only needed for entities, multi-byte characters and a possible end tag.
+			// This matters for elements with large texts, i.e. number lists.
+			if ( !caseInsensitive )
+			{
+				const char* q = p;
+				while ( *q && (unsigned char)*q < 0x80 && *q != '&' && *q != *endTag )
+					++q;
+				if ( q != p )
+				{
+					text->append( p, q - p );
+					p = q;
+					continue;
+				}
+			}
 			int len;
 			char cArr[4] = { 0, 0, 0, 0 };
 			p = GetChar( p, cArr, &len, encoding );
@@ -624,6 +649,19 @@ const char* TiXmlBase::ReadText(	const char* p,
 					(*text) += ' ';
 					whitespace = false;
 				}
+				// Append a run of plain ASCII characters (without white space) at once, see above.
+				if ( !caseInsensitive )
+				{
+					const char* q = p;
+					while ( (unsigned char)*q > 0x20 && (unsigned char)*q < 0x7f && *q != '&' && *q != *endTag )
+						++q;
+					if ( q != p )
+					{
+						text->append( p, q - p );
+						p = q;
+						continue;
+					}
+				}
 				int len;
 				char cArr[4] = { 0, 0, 0, 0 };
 				p = GetChar( p, cArr, &len, encoding );
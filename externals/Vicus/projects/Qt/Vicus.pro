@@ -58,6 +58,7 @@ HEADERS += \
 	../../src/VICUS_NetworkLine.h \
 	../../src/VICUS_NetworkNode.h \
 	../../src/VICUS_NetworkPipe.h \
+	../../src/VICUS_NetworkSpatialIndex.h \
 	../../src/VICUS_Object.h \
 	../../src/VICUS_Outputs.h \
 	../../src/VICUS_PlaneGeometry.h \
@@ -101,6 +102,7 @@ SOURCES += \
 	../../src/VICUS_NetworkLine.cpp \
 	../../src/VICUS_NetworkNode.cpp \
 	../../src/VICUS_NetworkPipe.cpp \
+	../../src/VICUS_NetworkSpatialIndex.cpp \
 	../../src/VICUS_Object.cpp \
 	../../src/VICUS_Outputs.cpp \
 	../../src/VICUS_PlaneGeometry.cpp \
@@ -1,5 +1,6 @@
 #include "VICUS_Network.h"
 #include "VICUS_NetworkLine.h"
+#include "VICUS_NetworkSpatialIndex.h"
 #include "VICUS_NetworkFluid.h"
 #include "VICUS_NetworkPipe.h"
 #include "VICUS_Project.h"
@@ -11,6 +12,9 @@
 
 #include <fstream>
 #include <algorithm>
+#include <deque>
+#include <functional>
+#include <queue>
 
 #include <NANDRAD_KeywordList.h>
 
@@ -94,6 +98,63 @@ void Network::addEdge(const NetworkEdge &edge) {
 }
 
 
+unsigned Network::addNode(NetworkSpatialIndex & nodeIndex, const IBKMK::Vector3D & v, const NetworkNode::NodeType type) {
+	// search for existing node with identical coordinates, if several nodes match, take the one with the smallest id
+	IBK::point2D<double> p(v.m_x, v.m_y);
+	std::vector<unsigned int> candidates;
+	nodeIndex.query(IBK::point2D<double>(v.m_x - geometricResolution, v.m_y - geometricResolution),
+					IBK::point2D<double>(v.m_x + geometricResolution, v.m_y + geometricResolution), candidates);
+	for (unsigned int id : candidates) {
+		if (m_nodes[id].m_position.distanceTo(v) < geometricResolution)
+			return id;
+	}
+	unsigned id = appendNode(v, type);
+	nodeIndex.insert(id, p, p);
+	return id;
+}
+
+
+unsigned Network::appendNode(const IBKMK::Vector3D & v, const NetworkNode::NodeType type) {
+	unsigned id = m_nodes.size();
+	bool reallocate = (m_nodes.size() == m_nodes.capacity());
+	m_nodes.push_back(NetworkNode(id, type, v));
+	if (reallocate)
+		updateNodeEdgeConnectionPointers();
+	else
+		m_nodes.back().m_parent = this;
+	return id;
+}
+
+
+void Network::appendEdge(const unsigned nodeId1, const unsigned nodeId2, const bool supply) {
+	IBK_ASSERT(nodeId1<m_nodes.size() && nodeId2<m_nodes.size());
+	bool reallocate = (m_edges.size() == m_edges.capacity());
+	m_edges.push_back(NetworkEdge(nodeId1, nodeId2, supply, 0, INVALID_ID));
+	NetworkEdge & e = m_edges.back();
+	if (reallocate)
+		updateNodeEdgeConnectionPointers();
+	else {
+		e.m_node1 = &m_nodes[nodeId1];
+		e.m_node2 = &m_nodes[nodeId2];
+		e.m_node1->m_edges.push_back(&e);
+		e.m_node2->m_edges.push_back(&e);
+		e.m_parent = this;
+	}
+	e.setLengthFromCoordinates();
+}
+
+
+void Network::reconnectEdgeNode1(const unsigned edgeIdx, const unsigned nodeId) {
+	NetworkEdge & e = m_edges[edgeIdx];
+	std::vector<NetworkEdge*> & oldNodeEdges = e.m_node1->m_edges;
+	std::vector<NetworkEdge*>::iterator it = std::find(oldNodeEdges.begin(), oldNodeEdges.end(), &e);
+	if (it != oldNodeEdges.end())
+		oldNodeEdges.erase(it);
+	e.setNodeId1(nodeId, &m_nodes[nodeId]);
+	m_nodes[nodeId].m_edges.push_back(&e);
+}
+
+
 void Network::updateNodeEdgeConnectionPointers() {
 	// resolve all node and edge pointers
 
@@ -224,6 +285,14 @@ void Network::readGridFromCSV(const IBK::Path &filePath){
 	std::vector<std::string> cont;
 	IBK::FileReader::readAll(filePath, cont, std::vector<std::string>());
 
+	// spatial index for finding nodes with identical coordinates
+	updateNodeEdgeConnectionPointers();
+	NetworkSpatialIndex nodeIndex(100*geometricResolution);
+	for (const NetworkNode & n : m_nodes) {
+		IBK::point2D<double> p(n.m_position.m_x, n.m_position.m_y);
+		nodeIndex.insert(n.m_id, p, p);
+	}
+
 	// extract vector of string-xy-pairs
 	std::vector<std::string> tokens;
 	for (std::string line: cont){
@@ -245,11 +314,12 @@ void Network::readGridFromCSV(const IBK::Path &filePath){
 			polyLine.push_back({x, y});
 		}
 		for (unsigned i=0; i<polyLine.size()-1; ++i){
-			unsigned n1 = addNodeExt(IBKMK::Vector3D(polyLine[i][0], polyLine[i][1], 0), NetworkNode::NT_Mixer);
-			unsigned n2 = addNodeExt(IBKMK::Vector3D(polyLine[i+1][0], polyLine[i+1][1], 0), NetworkNode::NT_Mixer);
-			addEdge(n1, n2, true);
+			unsigned n1 = addNode(nodeIndex, IBKMK::Vector3D(polyLine[i][0], polyLine[i][1], 0) - m_origin, NetworkNode::NT_Mixer);
+			unsigned n2 = addNode(nodeIndex, IBKMK::Vector3D(polyLine[i+1][0], polyLine[i+1][1], 0) - m_origin, NetworkNode::NT_Mixer);
+			appendEdge(n1, n2, true);
 		}
 	}
+	updateNodeEdgeConnectionPointers();
 }
 
 
@@ -294,7 +364,78 @@ void Network::assignSourceNode(const IBKMK::Vector3D &v) {
 
 
 void Network::generateIntersections(){
-	while (findAndAddIntersection()) {}
+	if (m_edges.empty())
+		return;
+	updateNodeEdgeConnectionPointers();
+
+	// spatial indexes for edges and nodes, cell size of edge index is based on average edge length
+	NetworkSpatialIndex edgeIndex(0);
+	unsigned indexedEdgeCount = 0;
+	NetworkSpatialIndex nodeIndex(100*geometricResolution);
+	for (const NetworkNode & n : m_nodes) {
+		IBK::point2D<double> p(n.m_position.m_x, n.m_position.m_y);
+		nodeIndex.insert(n.m_id, p, p);
+	}
+
+	// all edges are tested once, edges that are split (and the newly created edges) are tested again
+	std::deque<unsigned> pendingEdges;
+	for (unsigned i=0; i<m_edges.size(); ++i)
+		pendingEdges.push_back(i);
+
+	std::vector<unsigned int> candidates;
+	while (!pendingEdges.empty()) {
+		// (re-)build edge index when number of edges has doubled, since splitting reduces the average edge length
+		if (m_edges.size() > 2*indexedEdgeCount) {
+			double totalLength = 0;
+			for (const NetworkEdge & e : m_edges)
+				totalLength += NetworkLine2D(e).length();
+			edgeIndex = NetworkSpatialIndex(NetworkSpatialIndex::suitableCellSize(totalLength, m_edges.size(), 100*geometricResolution));
+			for (unsigned i=0; i<m_edges.size(); ++i) {
+				NetworkLine2D l(m_edges[i]);
+				edgeIndex.insert(i, l.m_p1, l.m_p2);
+			}
+			indexedEdgeCount = m_edges.size();
+		}
+
+		unsigned i1 = pendingEdges.front();
+		pendingEdges.pop_front();
+
+		NetworkLine2D l1 = NetworkLine2D(m_edges[i1]);
+		edgeIndex.query(l1.m_p1, l1.m_p2, candidates);
+		for (unsigned i2 : candidates) {
+			if (i2 == i1)
+				continue;
+
+			// calculate intersection (lines in same order as in findAndAddIntersection())
+			NetworkLine2D l2 = NetworkLine2D(m_edges[i2]);
+			IBK::point2D<double> ps;
+			if (i1 < i2)
+				l1.intersection(l2, ps);
+			else
+				l2.intersection(l1, ps);
+
+			// if it is within both lines: add node and edges, adapt exisiting nodes
+			if (l1.containsPoint(ps) && l2.containsPoint(ps)){
+				unsigned nInter = addNode(nodeIndex, IBKMK::Vector3D(ps), NetworkNode::NT_Mixer);
+				unsigned iNew1 = m_edges.size();
+				appendEdge(nInter, m_edges[i1].nodeId1(), true);
+				unsigned iNew2 = m_edges.size();
+				appendEdge(nInter, m_edges[i2].nodeId1(), true);
+				reconnectEdgeNode1(i1, nInter);
+				reconnectEdgeNode1(i2, nInter);
+
+				// update index and test all modified/new edges again
+				for (unsigned i : {i1, i2, iNew1, iNew2}) {
+					NetworkLine2D l(m_edges[i]);
+					edgeIndex.insert(i, l.m_p1, l.m_p2);
+					pendingEdges.push_back(i);
+				}
+				break;
+			}
+		}
+	}
+
+	updateNodeEdgeConnectionPointers();
 }
 
 
@@ -326,35 +467,79 @@ bool Network::findAndAddIntersection() {
 
 
 void Network::connectBuildings(const bool extendSupplyPipes) {
+	updateNodeEdgeConnectionPointers();
 
-	int idNext = nextUnconnectedBuilding();
-	while (idNext>=0) {
+	// spatial index of supply edges for nearest edge search and of nodes for finding existing nodes
+	double totalLength = 0;
+	unsigned supplyEdgeCount = 0;
+	for (const NetworkEdge & e : m_edges) {
+		if (!e.m_supply)
+			continue;
+		totalLength += NetworkLine2D(e).length();
+		++supplyEdgeCount;
+	}
+	NetworkSpatialIndex edgeIndex(NetworkSpatialIndex::suitableCellSize(totalLength, supplyEdgeCount, 100*geometricResolution));
+	for (unsigned i=0; i<m_edges.size(); ++i) {
+		if (!m_edges[i].m_supply)
+			continue;
+		NetworkLine2D l(m_edges[i]);
+		edgeIndex.insert(i, l.m_p1, l.m_p2);
+	}
+	NetworkSpatialIndex nodeIndex(100*geometricResolution);
+	for (const NetworkNode & n : m_nodes) {
+		IBK::point2D<double> p(n.m_position.m_x, n.m_position.m_y);
+		nodeIndex.insert(n.m_id, p, p);
+	}
 
-		unsigned idBuilding = static_cast<unsigned>(idNext);
+	// process all unconnected buildings in order of their ids
+	std::vector<unsigned> buildings;
+	for (const NetworkNode & n : m_nodes) {
+		if (n.m_type == NetworkNode::NT_Building && n.m_edges.empty())
+			buildings.push_back(n.m_id);
+	}
 
-		// find closest supply edge
+	std::vector<unsigned int> candidates;
+	for (unsigned idBuilding : buildings) {
+		// building may have been connected already as branch node of another building
+		if (!m_nodes[idBuilding].m_edges.empty())
+			continue;
+		IBK::point2D<double> pBuilding = m_nodes[idBuilding].m_position.point2D();
+
+		// find closest supply edge, searching in rings of grid cells around the building;
+		// after processing ring r, all remaining edges have a distance of at least r*cellSize
 		double distMin = std::numeric_limits<double>::max();
 		unsigned idEdgeMin=0;
-		for (unsigned id=0; id<m_edges.size(); ++id){
-			if (!m_edges[id].m_supply)
-				continue;
-			double dist = NetworkLine2D(m_edges[id]).distanceToPoint(m_nodes[idBuilding].m_position.point2D());
-			if (dist<distMin){
-				distMin = dist;
-				idEdgeMin = id;
+		for (unsigned ring=0; ; ++ring) {
+			candidates.clear();
+			if (!edgeIndex.queryRing(pBuilding, ring, candidates))
+				break;
+			for (unsigned id : candidates) {
+				double dist = NetworkLine2D(m_edges[id]).distanceToPoint(pBuilding);
+				// on equal distance, prefer edge with smaller index
+				if (dist<distMin || (dist == distMin && id < idEdgeMin)){
+					distMin = dist;
+					idEdgeMin = id;
+				}
 			}
+			if (distMin < ring*edgeIndex.cellSize())
+				break;
 		}
+
 		// branch node
 		NetworkLine2D lMin = NetworkLine2D(m_edges[idEdgeMin]);
 		IBK::point2D<double> pBranch;
 		unsigned idBranch;
-		lMin.projectionFromPoint(m_nodes[idBuilding].m_position.point2D(), pBranch);
+		lMin.projectionFromPoint(pBuilding, pBranch);
 		// branch node is inside edge: split edge
 		if (lMin.containsPoint(pBranch)){
-			idBranch = addNode(IBKMK::Vector3D(pBranch), NetworkNode::NT_Mixer);
-			addEdge(m_edges[idEdgeMin].nodeId1(), idBranch, true);
-			m_edges[idEdgeMin].setNodeId1(idBranch, &m_nodes[idBranch]);
-			updateNodeEdgeConnectionPointers();
+			idBranch = addNode(nodeIndex, IBKMK::Vector3D(pBranch), NetworkNode::NT_Mixer);
+			unsigned idNewEdge = m_edges.size();
+			appendEdge(m_edges[idEdgeMin].nodeId1(), idBranch, true);
+			reconnectEdgeNode1(idEdgeMin, idBranch);
+			for (unsigned i : {idEdgeMin, idNewEdge}) {
+				NetworkLine2D l(m_edges[i]);
+				edgeIndex.insert(i, l.m_p1, l.m_p2);
+			}
 		}
 		// branch node is outside edge
 		else{
@@ -364,15 +549,21 @@ void Network::connectBuildings(const bool extendSupplyPipes) {
 			// if pipe should be extended, change coordinates of branch node
 			if (extendSupplyPipes){
 				m_nodes[idBranch].m_position = pBranch;
-				for (NetworkEdge *e: m_nodes[idBranch].m_edges)
+				nodeIndex.insert(idBranch, pBranch, pBranch);
+				for (NetworkEdge *e: m_nodes[idBranch].m_edges) {
 					e->setLengthFromCoordinates();
+					if (e->m_supply) {
+						NetworkLine2D l(*e);
+						edgeIndex.insert((unsigned)(e - &m_edges[0]), l.m_p1, l.m_p2);
+					}
+				}
 			}
 		}
 		// connect building to branch node
-		addEdge(idBranch, idBuilding, false);
-
-		idNext = nextUnconnectedBuilding();
+		appendEdge(idBranch, idBuilding, false);
 	}
+
+	updateNodeEdgeConnectionPointers();
 }
 
 
@@ -491,37 +682,58 @@ FUNCID(Network::sizePipeDimensions);
 	for (NetworkEdge &edge: m_edges)
 		edge.m_maxHeatingDemand = 0;
 
-	// for all buildings: add their heating demand to the pipes along their shortest path
-	for (NetworkNode &node: m_nodes) {
+	// for all buildings: check heating demand
+	for (const NetworkNode &node: m_nodes) {
 		if (node.m_type != NetworkNode::NT_Building)
 			continue;
 		if (node.m_maxHeatingDemand <= 0)
 			throw IBK::Exception(IBK::FormatString("Maximum heating demand of node '%1' must be >0").arg(node.m_id), FUNC_ID);
+	}
+
+	// compute shortest path tree of each source, each building is supplied by the source with the shortest path
+	std::vector<std::vector<double> > distances(sources.size());
+	std::vector<std::vector<NetworkEdge*> > predecessorEdges(sources.size());
+	std::vector<std::vector<unsigned int> > settledNodes(sources.size());
+	for (unsigned int s=0; s<sources.size(); ++s)
+		dijkstraShortestPathTree(sources[s].m_id, distances[s], predecessorEdges[s], settledNodes[s]);
 
-		// for each source find the shortest path to current node. Finally select the shortest of these paths
-		std::vector<NetworkEdge * > minPath;
+	std::vector<unsigned int> supplyingSource(m_nodes.size(), INVALID_ID);
+	for (const NetworkNode &node: m_nodes) {
+		if (node.m_type != NetworkNode::NT_Building)
+			continue;
 		double minPathLength = std::numeric_limits<double>::max();
-		for (const NetworkNode &source: sources){
-			std::vector<NetworkEdge * > path;
-			dijkstraShortestPathToSource(node, source, path);  // shortest path between source and node
-			double pathLength = 0;
-			for (NetworkEdge *edge: path)
-				pathLength += edge->length();
-			if (pathLength < minPathLength){
-				minPathLength = pathLength;
-				minPath = path;
+		for (unsigned int s=0; s<sources.size(); ++s) {
+			if (distances[s][node.m_id] < minPathLength) {
+				minPathLength = distances[s][node.m_id];
+				supplyingSource[node.m_id] = s;
 			}
 		}
-		for (NetworkEdge * edge: minPath)
-			edge->m_maxHeatingDemand += node.m_maxHeatingDemand;
+		if (supplyingSource[node.m_id] == INVALID_ID)
+			throw IBK::Exception(IBK::FormatString("Building node '%1' is not connected to any source.").arg(node.m_id), FUNC_ID);
+	}
+
+	// add heating demand of all buildings to the pipes along their shortest path: traverse each tree
+	// from the leaves to the source and accumulate the demand of all buildings supplied through a node
+	std::vector<double> accumulatedDemand(m_nodes.size());
+	for (unsigned int s=0; s<sources.size(); ++s) {
+		std::fill(accumulatedDemand.begin(), accumulatedDemand.end(), 0);
+		for (std::vector<unsigned int>::const_reverse_iterator it = settledNodes[s].rbegin(); it != settledNodes[s].rend(); ++it) {
+			const NetworkNode & node = m_nodes[*it];
+			if (supplyingSource[node.m_id] == s)
+				accumulatedDemand[node.m_id] += node.m_maxHeatingDemand;
+			NetworkEdge * edge = predecessorEdges[s][node.m_id];
+			if (edge == nullptr || accumulatedDemand[node.m_id] == 0)
+				continue;
+			edge->m_maxHeatingDemand += accumulatedDemand[node.m_id];
+			accumulatedDemand[edge->neighbourNode(node.m_id)] += accumulatedDemand[node.m_id];
+		}
 	}
 
 	// in case there is a pipe which is not part of any path (e.g. in circular grid): assign the adjacent heating demand
 	for (NetworkEdge &e: m_edges){
 		if (e.m_maxHeatingDemand <= 0){
-			std::set<NetworkEdge *> edges1, edges2;
-			e.m_maxHeatingDemand = 0.5 * ( e.m_node1->adjacentHeatingDemand(edges1)
-										+ e.m_node2->adjacentHeatingDemand(edges2) );
+			e.m_maxHeatingDemand = 0.5 * ( e.m_node1->adjacentHeatingDemand()
+										+ e.m_node2->adjacentHeatingDemand() );
 		}
 	}
 
@@ -573,7 +785,7 @@ FUNCID(Network::sizePipeDimensions);
 
 
 void Network::findSourceNodes(std::vector<NetworkNode> &sources) const{
-	for (NetworkNode n: m_nodes){
+	for (const NetworkNode &n: m_nodes){
 		if (n.m_type==NetworkNode::NT_Source)
 			sources.push_back(n);
 	}
@@ -615,6 +827,43 @@ void Network::dijkstraShortestPathToSource(NetworkNode &startNode, const Network
 }
 
 
+void Network::dijkstraShortestPathTree(unsigned int source, std::vector<double> & distances,
+									   std::vector<NetworkEdge*> & predecessorEdges, std::vector<unsigned int> & settledNodes) const
+{
+	distances.assign(m_nodes.size(), std::numeric_limits<double>::max());
+	predecessorEdges.assign(m_nodes.size(), nullptr);
+	settledNodes.clear();
+	std::vector<bool> settled(m_nodes.size(), false);
+
+	// min-heap of (distance, node id), nodes may be contained several times with outdated distances
+	typedef std::pair<double, unsigned int> HeapEntry;
+	std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry> > heap;
+	distances[source] = 0;
+	heap.push(HeapEntry(0, source));
+
+	while (!heap.empty()) {
+		unsigned int id = heap.top().second;
+		heap.pop();
+		if (settled[id])
+			continue;
+		settled[id] = true;
+		settledNodes.push_back(id);
+
+		// update distance from source to neighbours
+		const NetworkNode & node = m_nodes[id];
+		for (NetworkEdge * e: node.m_edges) {
+			unsigned int neighbour = e->neighbourNode(id);
+			double alternativeDistance = distances[id] + e->length();
+			if (alternativeDistance < distances[neighbour]) {
+				distances[neighbour] = alternativeDistance;
+				predecessorEdges[neighbour] = e;
+				heap.push(HeapEntry(alternativeDistance, neighbour));
+			}
+		}
+	}
+}
+
+
 void Network::updateExtends() {
 	updateNodeEdgeConnectionPointers();
 	double minX = std::numeric_limits<double>::max();
@@ -24,6 +24,10 @@ namespace IBK {
 	class Path;
 }
 
+namespace VICUS {
+	class NetworkSpatialIndex;
+}
+
 namespace VICUS {
 
 class NetworkFluid;
@@ -87,7 +91,8 @@ public:
 	/*! finds node that is closest to the given coordinates and change its type to NT_SOURCE */
 	void assignSourceNode(const IBKMK::Vector3D &v);
 
-	/*! generate all intersections in the network (runs in a loop as long as findAndAddIntersection() is true.) */
+	/*! generate all intersections in the network. Uses a spatial index, so that only edges in the vicinity of
+		each edge are tested, and re-tests only edges that have been split by an intersection. */
 	void generateIntersections();
 
 	/*! Process all edges vs. all other edges. If an intersection was found, set the according
@@ -101,7 +106,8 @@ public:
 	/*! Checks that all edges and nodes are connected with each other (i.e. single graph network). */
 	bool checkConnectedGraph() const;
 
-	/*! iterates through all building nodes, finds closest supply edge and connects the building node to the network */
+	/*! iterates through all building nodes, finds closest supply edge and connects the building node to the network
+		(closest edges are searched with a spatial index) */
 	void connectBuildings(const bool extendSupplyPipes);
 
 	/*! returns the first id in m_nodes, which is an unconnected building */
@@ -134,6 +140,16 @@ public:
 	 */
 	void dijkstraShortestPathToSource(NetworkNode &startNode, const NetworkNode &endNode, std::vector<NetworkEdge*> &pathEndToStart);
 
+	/*! Computes the shortest path tree from the given source node to all other nodes (dijkstra-algorithm with binary heap).
+		Node pointers must be up-to-date (see updateNodeEdgeConnectionPointers()).
+		\param source Id of the root node of the tree.
+		\param distances Distance of each node (index = node id) to the source, std::numeric_limits<double>::max() for unreachable nodes.
+		\param predecessorEdges Edge leading from each node towards the source, nullptr for the source and unreachable nodes.
+		\param settledNodes Ids of all reachable nodes in the order of increasing distance (source first).
+	*/
+	void dijkstraShortestPathTree(unsigned int source, std::vector<double> & distances,
+								  std::vector<NetworkEdge*> & predecessorEdges, std::vector<unsigned int> & settledNodes) const;
+
 	/*! Recomputes the min/max coordinates of the network and updates m_extends. */
 	void updateExtends();
 
@@ -232,6 +248,29 @@ private:
 	/*! addNode using Node constructor */
 	unsigned addNode(const NetworkNode & node, const bool considerCoordinates=true);
 
+	/*! add node to network based on coordinates and type and return the node id. If a node with the given coordinates
+		exists already in the spatial node index, its id is returned. New nodes are added to the index.
+		Node and edge pointers are only updated when the node vector is reallocated (see appendNode()).
+	*/
+	unsigned addNode(NetworkSpatialIndex & nodeIndex, const IBKMK::Vector3D &v, const NetworkNode::NodeType type);
+
+	/*! Appends a node without checking for existing coordinates and returns its id.
+		Unlike addNode(), the node and edge pointers are only updated if the node vector was reallocated, so
+		pointers stay valid but m_children must be updated with updateNodeEdgeConnectionPointers() when done.
+	*/
+	unsigned appendNode(const IBKMK::Vector3D &v, const NetworkNode::NodeType type);
+
+	/*! Appends an edge between the given nodes and sets its length from coordinates.
+		Unlike addEdge(), node and edge pointers are updated incrementally (full update only if the edge vector
+		was reallocated), call updateNodeEdgeConnectionPointers() when done.
+	*/
+	void appendEdge(const unsigned nodeId1, const unsigned nodeId2, const bool supply);
+
+	/*! Connects node 1 of the edge with index edgeIdx to the node with nodeId, updates the node's edge
+		pointer lists and the edge length.
+	*/
+	void reconnectEdgeNode1(const unsigned edgeIdx, const unsigned nodeId);
+
 	/*! Calculates Reynolds number of a moving fluid.
 	\param v mean fluid flow velocity
 	\param kinVis fluid kinematic viscosity
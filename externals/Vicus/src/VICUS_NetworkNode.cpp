@@ -135,14 +135,10 @@ void NetworkNode::pathToNull(std::vector<NetworkEdge*> &path){
 	}
 }
 
-double NetworkNode::adjacentHeatingDemand(std::set<NetworkEdge *> visitedEdges){
-	for (NetworkEdge *e: m_edges){
-		if (visitedEdges.find(e)==visitedEdges.end()){
-			visitedEdges.insert(e);
-			if (e->m_maxHeatingDemand>0)
-				return e->m_maxHeatingDemand;
-			e->neighbourNode(this)->adjacentHeatingDemand(visitedEdges);
-		}
+double NetworkNode::adjacentHeatingDemand() const {
+	for (const NetworkEdge *e: m_edges){
+		if (e->m_maxHeatingDemand>0)
+			return e->m_maxHeatingDemand;
 	}
 	return 0;
 }
@@ -82,8 +82,8 @@ public:
 	 * until a node without predecessor is reached. this way the path from a building to the source can be created, if the predecessors have been set */
 	void pathToNull(std::vector<NetworkEdge * > & path);
 
-	/*! looks at all adjacent nodes to find a node which has a heating demand >0 and returns it. */
-	double adjacentHeatingDemand(std::set<NetworkEdge*> visitedEdges);
+	/*! looks at all adjacent edges to find an edge which has a heating demand >0 and returns it. */
+	double adjacentHeatingDemand() const;
 
 
 	// *** PUBLIC MEMBER VARIABLES ***
@@ -0,0 +1,119 @@
+#include "VICUS_NetworkSpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace VICUS {
+
+NetworkSpatialIndex::NetworkSpatialIndex(double cellSize) :
+	m_cellSize(cellSize),
+	m_minX(std::numeric_limits<int>::max()),
+	m_minY(std::numeric_limits<int>::max()),
+	m_maxX(std::numeric_limits<int>::min()),
+	m_maxY(std::numeric_limits<int>::min())
+{
+}
+
+
+double NetworkSpatialIndex::suitableCellSize(double totalLength, unsigned int segmentCount, double minCellSize) {
+	if (segmentCount == 0)
+		return minCellSize;
+	return std::max(minCellSize, totalLength/segmentCount);
+}
+
+
+void NetworkSpatialIndex::insert(unsigned int id, const IBK::point2D<double> & p1, const IBK::point2D<double> & p2) {
+	remove(id);
+	if (id >= m_ranges.size())
+		m_ranges.resize(id+1);
+	CellRange & r = m_ranges[id];
+	r.m_x1 = cellIndex(std::min(p1.m_x, p2.m_x));
+	r.m_x2 = cellIndex(std::max(p1.m_x, p2.m_x));
+	r.m_y1 = cellIndex(std::min(p1.m_y, p2.m_y));
+	r.m_y2 = cellIndex(std::max(p1.m_y, p2.m_y));
+	for (int x = r.m_x1; x <= r.m_x2; ++x)
+		for (int y = r.m_y1; y <= r.m_y2; ++y)
+			m_cells[cellKey(x,y)].push_back(id);
+	m_minX = std::min(m_minX, r.m_x1);
+	m_minY = std::min(m_minY, r.m_y1);
+	m_maxX = std::max(m_maxX, r.m_x2);
+	m_maxY = std::max(m_maxY, r.m_y2);
+}
+
+
+void NetworkSpatialIndex::remove(unsigned int id) {
+	if (id >= m_ranges.size())
+		return;
+	CellRange & r = m_ranges[id];
+	for (int x = r.m_x1; x <= r.m_x2; ++x) {
+		for (int y = r.m_y1; y <= r.m_y2; ++y) {
+			std::vector<unsigned int> & cell = m_cells[cellKey(x,y)];
+			cell.erase(std::find(cell.begin(), cell.end(), id));
+		}
+	}
+	r = CellRange();
+}
+
+
+void NetworkSpatialIndex::query(const IBK::point2D<double> & p1, const IBK::point2D<double> & p2,
+								std::vector<unsigned int> & ids) const
+{
+	ids.clear();
+	int x1 = std::max(m_minX, cellIndex(std::min(p1.m_x, p2.m_x)));
+	int x2 = std::min(m_maxX, cellIndex(std::max(p1.m_x, p2.m_x)));
+	int y1 = std::max(m_minY, cellIndex(std::min(p1.m_y, p2.m_y)));
+	int y2 = std::min(m_maxY, cellIndex(std::max(p1.m_y, p2.m_y)));
+	for (int x = x1; x <= x2; ++x)
+		for (int y = y1; y <= y2; ++y)
+			appendCell(x, y, ids);
+	std::sort(ids.begin(), ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+
+bool NetworkSpatialIndex::queryRing(const IBK::point2D<double> & p, unsigned int ring, std::vector<unsigned int> & ids) const {
+	int cx = cellIndex(p.m_x);
+	int cy = cellIndex(p.m_y);
+	int r = (int)ring;
+	// empty index or ring farther away than all occupied cells?
+	if (m_minX > m_maxX)
+		return false;
+	int maxDist = std::max(std::max(std::abs(cx - m_minX), std::abs(cx - m_maxX)),
+						   std::max(std::abs(cy - m_minY), std::abs(cy - m_maxY)));
+	if (r > maxDist)
+		return false;
+
+	if (r == 0) {
+		appendCell(cx, cy, ids);
+		return true;
+	}
+	// top and bottom row of the ring
+	for (int x = std::max(cx - r, m_minX); x <= std::min(cx + r, m_maxX); ++x) {
+		appendCell(x, cy - r, ids);
+		appendCell(x, cy + r, ids);
+	}
+	// left and right column of the ring (without corners)
+	for (int y = std::max(cy - r + 1, m_minY); y <= std::min(cy + r - 1, m_maxY); ++y) {
+		appendCell(cx - r, y, ids);
+		appendCell(cx + r, y, ids);
+	}
+	return true;
+}
+
+
+int NetworkSpatialIndex::cellIndex(double v) const {
+	return (int)std::floor(v/m_cellSize);
+}
+
+
+void NetworkSpatialIndex::appendCell(int x, int y, std::vector<unsigned int> & ids) const {
+	if (x < m_minX || x > m_maxX || y < m_minY || y > m_maxY)
+		return;
+	std::unordered_map<std::int64_t, std::vector<unsigned int> >::const_iterator it = m_cells.find(cellKey(x,y));
+	if (it != m_cells.end())
+		ids.insert(ids.end(), it->second.begin(), it->second.end());
+}
+
+} // namespace VICUS
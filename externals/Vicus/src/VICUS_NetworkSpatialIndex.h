@@ -0,0 +1,90 @@
+#ifndef VICUS_NetworkSpatialIndexH
+#define VICUS_NetworkSpatialIndexH
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include <IBK_point.h>
+
+namespace VICUS {
+
+/*! A uniform grid index for 2D network geometry (nodes and edges).
+
+	Each object is identified by an id (typically the node or edge index) and is registered in all grid
+	cells that overlap its bounding box. For networks with edges of similar length (street grids) a query
+	touches only a few cells, so that intersection search and nearest-edge search scale almost linearly
+	with the network size instead of testing all pairs of edges.
+
+	Only occupied cells are stored (hash map), so the grid may cover arbitrarily large areas.
+*/
+class NetworkSpatialIndex {
+public:
+	/*! Constructor, takes the cell size in [m]. */
+	explicit NetworkSpatialIndex(double cellSize);
+
+	/*! Returns a suitable cell size for a set of line segments, i.e. the average segment length,
+		but not smaller than minCellSize.
+	*/
+	static double suitableCellSize(double totalLength, unsigned int segmentCount, double minCellSize);
+
+	/*! Registers an object with the bounding box spanned by p1 and p2.
+		If the object is already registered, it is moved to the new bounding box.
+	*/
+	void insert(unsigned int id, const IBK::point2D<double> & p1, const IBK::point2D<double> & p2);
+
+	/*! Removes an object from the index (does nothing if object is not registered). */
+	void remove(unsigned int id);
+
+	/*! Collects ids of all objects registered in cells that overlap the bounding box of p1 and p2.
+		The ids are sorted in increasing order and unique. Objects are only candidates, the caller must
+		still check the actual geometry.
+	*/
+	void query(const IBK::point2D<double> & p1, const IBK::point2D<double> & p2, std::vector<unsigned int> & ids) const;
+
+	/*! Collects ids of all objects registered in cells of the square ring with (Chebyshev) distance 'ring' around
+		the cell of point p. Ring 0 is the cell containing p itself. Objects may be returned several times.
+		All objects not yet returned by rings 0...ring have a distance of at least ring*cellSize() from p.
+		\return Returns false if the ring lies completely outside of the occupied grid area (no further
+			objects can be found in this or larger rings).
+	*/
+	bool queryRing(const IBK::point2D<double> & p, unsigned int ring, std::vector<unsigned int> & ids) const;
+
+	/*! Cell size in [m]. */
+	double cellSize() const { return m_cellSize; }
+
+private:
+	/*! Range of cells occupied by an object. */
+	struct CellRange {
+		int	m_x1 = 0;
+		int	m_y1 = 0;
+		int	m_x2 = -1; // empty range marks unregistered objects
+		int	m_y2 = -1;
+	};
+
+	/*! Computes cell index of a coordinate. */
+	int cellIndex(double v) const;
+	/*! Computes hash key of a cell. */
+	static std::int64_t cellKey(int x, int y) {
+		return (std::int64_t(x) << 32) ^ std::int64_t(std::uint32_t(y));
+	}
+	/*! Appends ids in cell (x,y) to vector ids. */
+	void appendCell(int x, int y, std::vector<unsigned int> & ids) const;
+
+	/*! Cell size in [m]. */
+	double													m_cellSize;
+	/*! Occupied cells with ids of registered objects. */
+	std::unordered_map<std::int64_t, std::vector<unsigned int> >	m_cells;
+	/*! Cell range of each registered object, index is object id. */
+	std::vector<CellRange>									m_ranges;
+
+	/*! Bounding range of all cells ever occupied. */
+	int														m_minX;
+	int														m_minY;
+	int														m_maxX;
+	int														m_maxY;
+};
+
+} // namespace VICUS
+
+#endif // VICUS_NetworkSpatialIndexH